@@ -0,0 +1,436 @@
+/**
+ * @file AI_Player.h
+ * @brief Search-based computer player (PlayerType::AI).
+ *
+ * AI_Player chooses its move with a depth-limited negamax search with
+ * alpha-beta pruning. Any board that implements the search-facing methods of
+ * Board (generate_moves(), evaluate(), position_key()) can be played by it.
+ *
+ * The search plays moves on the real board with make_move() and takes them
+ * back with unmake_move() before it returns, so the board is unchanged once a
+ * move has been chosen. Terminal
+ * positions are detected with check_result(), i.e. with the board's own
+ * is_win/is_lose/is_draw rules.
+ *
+ * With an opening book (set_book()) a position the book holds is answered
+ * from it (Board::book_move()) without searching.
+ *
+ * With a time budget (Searcher::set_think_ms()) the search deepens one ply
+ * at a time until the budget runs out, each iteration starting from the
+ * previous best move inside an aspiration window around the previous score.
+ */
+
+#ifndef _AI_PLAYER_H
+#define _AI_PLAYER_H
+
+#include "BoardGame_Classes.h"
+#include "Searcher.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Counters of the last search, useful when tuning depth or table size.
+ */
+struct SearchStats {
+    long long nodes = 0;     ///< Positions visited
+    long long tt_probes = 0; ///< Transposition table lookups
+    long long tt_hits = 0;   ///< Lookups that found the position
+    int depth = 0;           ///< Depth of the last search (of the last finished iteration, with a time budget)
+    int score = 0;           ///< Score of the chosen move for the searching player
+    bool from_book = false;  ///< The move came from the opening book
+};
+
+/**
+ * @brief Player that picks its moves with negamax alpha-beta search.
+ *
+ * @tparam T Type of symbol placed on the board.
+ * @tparam B Board type searched. With the concrete (final) board class the
+ *         search calls its methods directly instead of through the vtable;
+ *         the default Board<T> plays any board.
+ *
+ * Move ordering tries the transposition-table move first, then the moves
+ * with the best history score (moves that caused cut-offs earlier), then the
+ * board's own generation order. The transposition table has a fixed number
+ * of entries allocated once, and each slot keeps the most recent position
+ * stored in it. The table and the history scores carry over from one
+ * iteration of a timed search to the next.
+ */
+template <typename T, typename B = Board<T>>
+class AI_Player : public Searcher<T> {
+public:
+    static const int WIN_SCORE = 1000000; ///< Score of a won position (minus the plies to reach it)
+    static constexpr int MAX_DEPTH = 64;  ///< Deepest iteration of a timed search
+    static constexpr int ASPIRATION = 50; ///< Half width of the aspiration window
+
+    /**
+     * @brief Construct a search player.
+     * @param name Player name.
+     * @param symbol Symbol the player places.
+     * @param opponent_symbol Symbol the opponent places.
+     * @param depth Search depth in plies; with a time budget, the deepest iteration.
+     * @param tt_entries Transposition table size (rounded down to a power of two).
+     */
+    AI_Player(string name, T symbol, T opponent_symbol, int depth = 6, size_t tt_entries = 1 << 18)
+        : Searcher<T>(name, symbol),
+          opponent("", opponent_symbol, PlayerType::AI),
+          depth(max(depth, 1)) {
+        size_t size = 1;
+        while (size * 2 <= tt_entries) size *= 2;
+        table.resize(size);
+        tt_mask = size - 1;
+    }
+
+    /**
+     * @brief Search the current board and return the best move found.
+     * @return The move for this player, or a move at (-1, -1) if the board
+     *         offers no moves.
+     *
+     * Without a time budget the search goes to the set depth. With one it
+     * deepens until the budget is spent, the set depth is reached or the
+     * whole game tree has been seen, and returns the best move of the
+     * deepest iteration (or of the unfinished one, if it already found a
+     * better move).
+     */
+    Move<T> choose_move() override {
+        B* board = static_cast<B*>(this->get_board_ptr());
+        opponent.set_board_ptr(board);
+        stats = SearchStats();
+        stats.depth = depth;
+        fill(begin(history), end(history), 0);
+
+        Move<T> best;
+        if (book && board->book_move(*book, this->get_symbol(), best)) {
+            stats.depth = 0;
+            stats.from_book = true;
+            return best;
+        }
+        if (this->think_ms > 0)
+            return deepen(board);
+
+        timed = false;
+        stopped = false;
+        if (!search_root(board, best, stats.score, -INF, INF, depth, nullptr))
+            return Move<T>(-1, -1, this->get_symbol());
+        return best;
+    }
+
+    /** @brief Set the search depth in plies. */
+    void set_depth(int plies) { depth = max(plies, 1); }
+
+    /**
+     * @brief Answer the positions of a book from it; nullptr turns the book off.
+     *
+     * The book is not owned and must outlive the player.
+     */
+    void set_book(const OpeningBook* opening_book) { book = opening_book; }
+
+    /**
+     * @brief Key the transposition table by Board::canonical_key().
+     *
+     * Positions that are mirror images or rotations of each other then share
+     * one entry. Only valid for boards whose evaluate() is symmetric too.
+     */
+    void set_canonical_keys(bool on) { canonical = on; }
+
+    /** @brief Counters of the last search. */
+    const SearchStats& get_stats() const { return stats; }
+
+    /** @brief Add the counters of the last search to out. */
+    void report_search(GameStats& out) const override {
+        out.record_search(stats.nodes, stats.tt_probes, stats.tt_hits, stats.depth);
+    }
+
+private:
+    /** @brief Kind of bound stored with a transposition table score. */
+    enum Bound : uint8_t { EMPTY, EXACT, LOWER, UPPER };
+
+    /** @brief One transposition table slot. */
+    struct TTEntry {
+        uint64_t key = 0;     ///< Position key (side to move mixed in)
+        int score = 0;        ///< Score from the side to move
+        int8_t depth = -1;    ///< Remaining depth the score was searched to
+        Bound bound = EMPTY;  ///< How the score bounds the true value
+        Move<T> best;         ///< Best or refuting move found
+    };
+
+    static const int INF = WIN_SCORE + 1;       ///< Larger than any score
+    static const int HISTORY_SIZE = 256;         ///< History slots, one per cell index
+    static const uint64_t SIDE_KEY = 0x9E3779B97F4A7C15ULL; ///< Mixed into the key when the opponent moves
+
+    Player<T> opponent;        ///< Unnamed stand-in for the opponent when asking the board for results
+    int depth;                 ///< Search depth in plies
+    bool canonical = false;    ///< Key the table by canonical_key() instead of position_key()
+    const OpeningBook* book = nullptr; ///< Opening book, or nullptr
+    bool timed = false;        ///< The running search stops at deadline
+    bool can_stop = false;     ///< The running iteration may be stopped at the deadline
+    bool stopped = false;      ///< The deadline passed; the running iteration is thrown away
+    bool cut_off = false;      ///< The running iteration stopped some line at its depth
+    chrono::steady_clock::time_point deadline; ///< End of the running timed search
+    vector<TTEntry> table;     ///< Transposition table
+    size_t tt_mask = 0;        ///< Index mask of the table
+    int history[HISTORY_SIZE]; ///< Cut-off counts per cell
+    SearchStats stats;         ///< Counters of the last search
+
+    /**
+     * @brief The player who moves on a side: 0 is this player, 1 the opponent.
+     */
+    Player<T>* side_player(int side) { return side == 0 ? static_cast<Player<T>*>(this) : &opponent; }
+
+    /** @brief Key of a position with a given side to move. */
+    uint64_t key_of(B* board, int side) const {
+        uint64_t key = canonical ? board->canonical_key() : board->position_key();
+        return side == 0 ? key : key ^ SIDE_KEY;
+    }
+
+    /** @brief History slot of a move. */
+    static int history_index(B* board, const Move<T>& m) {
+        int index = m.get_x() * board->get_columns() + m.get_y();
+        return (index >= 0 && index < HISTORY_SIZE) ? index : 0;
+    }
+
+    /**
+     * @brief Sort moves: the table move first, then by history score.
+     *
+     * The sort is stable, so equal-history moves keep the board's order.
+     */
+    void order_moves(B* board, MoveList<T>& moves, const Move<T>* tt_move) {
+        int keys[MoveList<T>::capacity];
+        for (int i = 0; i < moves.size(); ++i) {
+            keys[i] = history[history_index(board, moves[i])];
+            if (tt_move && moves[i] == *tt_move) keys[i] = INF;
+        }
+        // Insertion sort: move lists are short and mostly ordered already
+        for (int i = 1; i < moves.size(); ++i) {
+            Move<T> m = moves[i];
+            int k = keys[i];
+            int j = i - 1;
+            for (; j >= 0 && keys[j] < k; --j) {
+                moves[j + 1] = moves[j];
+                keys[j + 1] = keys[j];
+            }
+            moves[j + 1] = m;
+            keys[j + 1] = k;
+        }
+    }
+
+    /**
+     * @brief Score of the position after a side plays a move.
+     *
+     * Uses the board's result if the move ended the game, otherwise searches on.
+     */
+    int score_after_move(B* board, int side, int remaining, int alpha, int beta, int ply) {
+        switch (check_result(board, side_player(side))) {
+            case GameResult::WIN:  return WIN_SCORE - ply - 1;
+            case GameResult::LOSE: return -(WIN_SCORE - ply - 1);
+            case GameResult::DRAW: return 0;
+            default: return -negamax(board, 1 - side, remaining - 1, -beta, -alpha, ply + 1);
+        }
+    }
+
+    /**
+     * @brief choose_move() with a time budget: iterative deepening.
+     *
+     * Each iteration searches the previous best move first, inside a
+     * window of ASPIRATION around the previous score; a score outside the
+     * window is searched again with that side of the window open. The first
+     * iteration always finishes, so there is always a move to return.
+     */
+    Move<T> deepen(B* board) {
+        auto start = chrono::steady_clock::now();
+        deadline = this->deadline_from(start);
+        timed = true;
+
+        Move<T> best;
+        int score = 0, finished = 0;
+        for (int plies = 1; plies <= min(depth, MAX_DEPTH); ++plies) {
+            stopped = false;
+            cut_off = false;
+            can_stop = finished > 0;
+            int alpha = -INF, beta = INF;
+            if (finished > 0 && abs(score) < WIN_SCORE / 2) {
+                alpha = score - ASPIRATION;
+                beta = score + ASPIRATION;
+            }
+            Move<T> found;
+            int value = 0;
+            while (true) {
+                bool any = search_root(board, found, value, alpha, beta, plies, finished > 0 ? &best : nullptr);
+                if (!any)
+                    return Move<T>(-1, -1, this->get_symbol());
+                if (stopped) break;
+                if (value <= alpha && alpha > -INF) alpha = -INF;
+                else if (value >= beta && beta < INF) beta = INF;
+                else break;
+            }
+            if (stopped) {
+                // A move of the unfinished iteration that beat the window is still a better move
+                if (value > alpha)
+                    best = found;
+                break;
+            }
+            best = found;
+            score = value;
+            finished = plies;
+            // Nothing was cut at the depth limit: the whole tree has been searched
+            if (!cut_off || abs(score) > WIN_SCORE / 2) break;
+            // An iteration takes several times the one before; do not start one that cannot finish
+            if (chrono::steady_clock::now() - start > (deadline - start) / 2) break;
+        }
+        stats.depth = finished;
+        stats.score = score;
+        return best;
+    }
+
+    /**
+     * @brief Search every root move and keep the best one.
+     * @param best Set to the best move found.
+     * @param score Set to its score (fail-soft: a bound if outside [alpha, beta]).
+     * @param plies Depth of the search.
+     * @param first Move to search first, or nullptr for the board's order.
+     * @return false if the board offers no legal move.
+     *
+     * If a timed search passes its deadline, the move being searched is
+     * dropped and best is the best of the moves searched before it.
+     */
+    bool search_root(B* board, Move<T>& best, int& score, int alpha, int beta, int plies, const Move<T>* first) {
+        MoveList<T> moves;
+        board->generate_moves(this->get_symbol(), moves);
+        ++stats.nodes;
+        if (first)
+            for (int i = 1; i < moves.size(); ++i)
+                if (moves[i] == *first) {
+                    Move<T> m = moves[i];
+                    for (int j = i; j > 0; --j) moves[j] = moves[j - 1];
+                    moves[0] = m;
+                    break;
+                }
+
+        bool found = false;
+        int best_score = -INF;
+        for (const Move<T>& m : moves) {
+            if (!board->make_move(m))
+                continue;
+            int value = score_after_move(board, 0, plies, alpha, beta, 0);
+            board->unmake_move();
+            if (stopped) {
+                // Every move is legal here; keep found true so the caller has a move
+                if (!found) {
+                    best = m;
+                    found = true;
+                }
+                break;
+            }
+            if (!found || value > best_score) {
+                best_score = value;
+                best = m;
+                found = true;
+            }
+            alpha = max(alpha, value);
+            if (alpha >= beta) break;
+        }
+        score = best_score;
+        return found;
+    }
+
+    /**
+     * @brief Negamax search with alpha-beta pruning.
+     * @param board Board being searched.
+     * @param side Side to move: 0 is this player, 1 the opponent.
+     * @param remaining Plies left to search.
+     * @param alpha Lower bound of the window.
+     * @param beta Upper bound of the window.
+     * @param ply Distance from the root, used to prefer faster wins.
+     * @return Score from the side to move.
+     */
+    int negamax(B* board, int side, int remaining, int alpha, int beta, int ply) {
+        ++stats.nodes;
+        if (timed && can_stop && (stats.nodes & 1023) == 0 && chrono::steady_clock::now() >= deadline)
+            stopped = true;
+        if (stopped)
+            return 0;
+        T symbol = side_player(side)->get_symbol();
+        if (remaining <= 0) {
+            cut_off = true;
+            return board->evaluate(symbol);
+        }
+
+        uint64_t key = key_of(board, side);
+        TTEntry& entry = table[key & tt_mask];
+        const Move<T>* tt_move = nullptr;
+        ++stats.tt_probes;
+        if (entry.bound != EMPTY && entry.key == key) {
+            ++stats.tt_hits;
+            tt_move = &entry.best;
+            if (entry.depth >= remaining) {
+                int score = from_table(entry.score, ply);
+                // Only a won or lost score is known not to rest on a depth limit
+                if (abs(score) < WIN_SCORE / 2) cut_off = true;
+                if (entry.bound == EXACT) return score;
+                if (entry.bound == LOWER) alpha = max(alpha, score);
+                else beta = min(beta, score);
+                if (alpha >= beta) return score;
+            }
+        }
+
+        MoveList<T> moves;
+        board->generate_moves(symbol, moves);
+        if (moves.empty())
+            return board->evaluate(symbol);
+        Move<T> tt_copy;
+        if (tt_move) {
+            tt_copy = *tt_move;
+            tt_move = &tt_copy;
+        }
+        order_moves(board, moves, tt_move);
+
+        int alpha_orig = alpha;
+        int best_score = -INF;
+        Move<T> best_move = moves[0];
+        for (const Move<T>& m : moves) {
+            if (!board->make_move(m))
+                continue;
+            int score = score_after_move(board, side, remaining, alpha, beta, ply);
+            board->unmake_move();
+            if (stopped)
+                return 0;
+
+            if (score > best_score) {
+                best_score = score;
+                best_move = m;
+            }
+            alpha = max(alpha, score);
+            if (alpha >= beta) {
+                history[history_index(board, m)] += remaining * remaining;
+                break;
+            }
+        }
+        if (best_score == -INF)
+            return board->evaluate(symbol);
+
+        // The slot may have been overwritten by the recursion; refresh it
+        TTEntry& slot = table[key & tt_mask];
+        slot.key = key;
+        slot.score = to_table(best_score, ply);
+        slot.depth = static_cast<int8_t>(min(remaining, 127));
+        slot.bound = best_score <= alpha_orig ? UPPER : (best_score >= beta ? LOWER : EXACT);
+        slot.best = best_move;
+        return best_score;
+    }
+
+    /** @brief Store win scores relative to the position instead of the root. */
+    static int to_table(int score, int ply) {
+        if (score > WIN_SCORE / 2) return score + ply;
+        if (score < -WIN_SCORE / 2) return score - ply;
+        return score;
+    }
+
+    /** @brief Undo to_table() for a position found at a given ply. */
+    static int from_table(int score, int ply) {
+        if (score > WIN_SCORE / 2) return score - ply;
+        if (score < -WIN_SCORE / 2) return score + ply;
+        return score;
+    }
+};
+
+#endif // _AI_PLAYER_H
@@ -0,0 +1,168 @@
+#include <array>
+#include "Batch3x3.h"
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+namespace {
+    /// A cell that completes a line: the line, its other two cells and the cell itself
+    struct Probe {
+        uint16_t line, rest, bit;
+    };
+
+    constexpr array<Probe, 24> make_probes() {
+        array<Probe, 24> probes{};
+        int n = 0;
+        for (uint16_t line : LINES_3X3)
+            for (uint16_t bit = 1; bit < (1 << 9); bit <<= 1)
+                if (line & bit) probes[n++] = { line, uint16_t(line ^ bit), bit };
+        return probes;
+    }
+
+    constexpr array<Probe, 24> PROBES = make_probes();
+
+    void completing_scalar(const uint16_t* mine, const uint16_t* other, size_t from, size_t n, uint16_t* out) {
+        for (size_t i = from; i < n; ++i)
+            out[i] = completing_cells_3x3(mine[i], other[i]);
+    }
+
+    void full_scalar(const uint16_t* mine, size_t from, size_t n, uint16_t* out) {
+        for (size_t i = from; i < n; ++i) {
+            uint16_t full = 0;
+            for (int k = 0; k < 8; ++k)
+                if ((mine[i] & LINES_3X3[k]) == LINES_3X3[k]) full |= uint16_t(1u << k);
+            out[i] = full;
+        }
+    }
+
+#if defined(__AVX2__)
+    const int LANES = 16;
+
+    /// Games [0, n) rounded down to whole vectors; returns where the scalar tail starts
+    size_t completing_vector(const uint16_t* mine, const uint16_t* other, size_t n, uint16_t* out) {
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mine + i));
+            __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(other + i));
+            __m256i cells = _mm256_setzero_si256();
+            for (const Probe& p : PROBES) {
+                __m256i eq = _mm256_cmpeq_epi16(_mm256_and_si256(m, _mm256_set1_epi16(p.line)), _mm256_set1_epi16(p.rest));
+                cells = _mm256_or_si256(cells, _mm256_and_si256(eq, _mm256_set1_epi16(p.bit)));
+            }
+            cells = _mm256_andnot_si256(_mm256_or_si256(m, o), cells);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), cells);
+        }
+        return i;
+    }
+
+    size_t full_vector(const uint16_t* mine, size_t n, uint16_t* out) {
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mine + i));
+            __m256i full = _mm256_setzero_si256();
+            for (int k = 0; k < 8; ++k) {
+                __m256i line = _mm256_set1_epi16(LINES_3X3[k]);
+                __m256i eq = _mm256_cmpeq_epi16(_mm256_and_si256(m, line), line);
+                full = _mm256_or_si256(full, _mm256_and_si256(eq, _mm256_set1_epi16(1 << k)));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), full);
+        }
+        return i;
+    }
+
+    const char* KERNEL = "avx2";
+#elif defined(__SSE2__) || defined(_M_X64)
+    const int LANES = 8;
+
+    size_t completing_vector(const uint16_t* mine, const uint16_t* other, size_t n, uint16_t* out) {
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mine + i));
+            __m128i o = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other + i));
+            __m128i cells = _mm_setzero_si128();
+            for (const Probe& p : PROBES) {
+                __m128i eq = _mm_cmpeq_epi16(_mm_and_si128(m, _mm_set1_epi16(p.line)), _mm_set1_epi16(p.rest));
+                cells = _mm_or_si128(cells, _mm_and_si128(eq, _mm_set1_epi16(p.bit)));
+            }
+            cells = _mm_andnot_si128(_mm_or_si128(m, o), cells);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), cells);
+        }
+        return i;
+    }
+
+    size_t full_vector(const uint16_t* mine, size_t n, uint16_t* out) {
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mine + i));
+            __m128i full = _mm_setzero_si128();
+            for (int k = 0; k < 8; ++k) {
+                __m128i line = _mm_set1_epi16(LINES_3X3[k]);
+                __m128i eq = _mm_cmpeq_epi16(_mm_and_si128(m, line), line);
+                full = _mm_or_si128(full, _mm_and_si128(eq, _mm_set1_epi16(1 << k)));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), full);
+        }
+        return i;
+    }
+
+    const char* KERNEL = "sse2";
+#elif defined(__ARM_NEON)
+    const int LANES = 8;
+
+    size_t completing_vector(const uint16_t* mine, const uint16_t* other, size_t n, uint16_t* out) {
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            uint16x8_t m = vld1q_u16(mine + i);
+            uint16x8_t o = vld1q_u16(other + i);
+            uint16x8_t cells = vdupq_n_u16(0);
+            for (const Probe& p : PROBES) {
+                uint16x8_t eq = vceqq_u16(vandq_u16(m, vdupq_n_u16(p.line)), vdupq_n_u16(p.rest));
+                cells = vorrq_u16(cells, vandq_u16(eq, vdupq_n_u16(p.bit)));
+            }
+            vst1q_u16(out + i, vbicq_u16(cells, vorrq_u16(m, o)));
+        }
+        return i;
+    }
+
+    size_t full_vector(const uint16_t* mine, size_t n, uint16_t* out) {
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            uint16x8_t m = vld1q_u16(mine + i);
+            uint16x8_t full = vdupq_n_u16(0);
+            for (int k = 0; k < 8; ++k) {
+                uint16x8_t line = vdupq_n_u16(LINES_3X3[k]);
+                uint16x8_t eq = vceqq_u16(vandq_u16(m, line), line);
+                full = vorrq_u16(full, vandq_u16(eq, vdupq_n_u16(uint16_t(1u << k))));
+            }
+            vst1q_u16(out + i, full);
+        }
+        return i;
+    }
+
+    const char* KERNEL = "neon";
+#else
+    size_t completing_vector(const uint16_t*, const uint16_t*, size_t, uint16_t*) { return 0; }
+    size_t full_vector(const uint16_t*, size_t, uint16_t*) { return 0; }
+
+    const char* KERNEL = "scalar";
+#endif
+}
+
+const char* batch3x3_kernel() {
+    return KERNEL;
+}
+
+void Batch3x3::completing_cells(uint16_t* out) const {
+    size_t done = completing_vector(mine.data(), other.data(), size(), out);
+    completing_scalar(mine.data(), other.data(), done, size(), out);
+}
+
+void Batch3x3::full_lines(uint16_t* out) const {
+    size_t done = full_vector(mine.data(), size(), out);
+    full_scalar(mine.data(), done, size(), out);
+}
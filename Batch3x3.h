@@ -0,0 +1,115 @@
+/**
+ * @file Batch3x3.h
+ * @brief Three-in-a-row tests for many 3x3 boards at once.
+ *
+ * A 3x3 position is two 9-bit masks: the cells of the player being asked
+ * about and the cells of the other player, cell (r, c) at bit r * 3 + c.
+ * Batch3x3 stores the masks of many games structure-of-arrays (all the
+ * first masks, then all the second ones), so the kernels in Batch3x3.cpp
+ * can test the 8 lines of 16 games per AVX2 instruction (8 per SSE2 or
+ * NEON instruction) with a scalar loop for the rest of the batch.
+ *
+ * Which kernel is built depends on the compiler flags: -mavx2 (or
+ * -march=native on a machine that has it) selects AVX2, any other x86-64
+ * build SSE2 and an ARM build NEON; batch3x3_kernel() names the one in use.
+ */
+
+#ifndef _BATCH_3X3_H
+#define _BATCH_3X3_H
+
+#include "BoardGame_Classes.h"
+#include <cstdint>
+#include <vector>
+
+/** @brief The 8 lines of a 3x3 board as cell masks: rows, columns, diagonals. */
+constexpr uint16_t LINES_3X3[8] = { 0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054 };
+
+/** @brief All 9 cells. */
+constexpr uint16_t CELLS_3X3 = 0x1FF;
+
+/**
+ * @brief Empty cells where a stone would complete a line for one game.
+ * @param mine Cells of the player placing the stone
+ * @param other Cells of the other player
+ *
+ * The scalar version of Batch3x3::completing_cells(), for a single board.
+ */
+constexpr uint16_t completing_cells_3x3(uint16_t mine, uint16_t other) {
+    uint16_t cells = 0;
+    for (uint16_t line : LINES_3X3)
+        for (uint16_t bit = 1; bit < (1 << 9); bit <<= 1)
+            if ((line & bit) && (mine & line) == (line ^ bit)) cells |= bit;
+    return cells & ~(mine | other) & CELLS_3X3;
+}
+
+/**
+ * @brief Cells of a 3x3 board holding a symbol, as a 9-bit mask.
+ */
+template <typename T>
+uint16_t cells_3x3(const Board<T>& board, T symbol) {
+    uint16_t mask = 0;
+    for (int i = 0; i < 9; ++i)
+        if (board.get_cell(i / 3, i % 3) == symbol) mask |= uint16_t(1u << i);
+    return mask;
+}
+
+/** @brief Name of the kernel Batch3x3 was built with: "avx2", "sse2", "neon" or "scalar". */
+const char* batch3x3_kernel();
+
+/**
+ * @brief Many 3x3 positions, stored as two arrays of masks.
+ */
+class Batch3x3 {
+public:
+    /** @brief Remove every game. */
+    void clear() {
+        mine.clear();
+        other.clear();
+    }
+
+    /** @brief Number of games. */
+    size_t size() const { return mine.size(); }
+
+    /**
+     * @brief Add a game by its masks.
+     * @return Its index in the batch
+     */
+    size_t add(uint16_t mine_cells, uint16_t other_cells) {
+        mine.push_back(mine_cells & CELLS_3X3);
+        other.push_back(other_cells & CELLS_3X3);
+        return mine.size() - 1;
+    }
+
+    /**
+     * @brief Add a 3x3 board, seen by the player with symbol.
+     * @return Its index in the batch
+     */
+    template <typename T>
+    size_t add(const Board<T>& board, T symbol, T other_symbol) {
+        return add(cells_3x3(board, symbol), cells_3x3(board, other_symbol));
+    }
+
+    /** @brief Replace the masks of game i. */
+    void set(size_t i, uint16_t mine_cells, uint16_t other_cells) {
+        mine[i] = mine_cells & CELLS_3X3;
+        other[i] = other_cells & CELLS_3X3;
+    }
+
+    /**
+     * @brief For every game, the empty cells where a stone of the first player completes a line.
+     * @param out size() masks; in the misère game they are the moves that lose
+     */
+    void completing_cells(uint16_t* out) const;
+
+    /**
+     * @brief For every game, the lines the first player holds entirely.
+     * @param out size() masks, bit k for line LINES_3X3[k]
+     */
+    void full_lines(uint16_t* out) const;
+
+private:
+    vector<uint16_t> mine;  ///< Cells of the player asked about, one mask per game
+    vector<uint16_t> other; ///< Cells of the other player, one mask per game
+};
+
+#endif // _BATCH_3X3_H
@@ -11,6 +11,17 @@
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <chrono>
+#include <functional>
+#include "Rng.h"
+#include "GameStats.h"
+#include "GameRecord.h"
 using namespace std;
 
 /////////////////////////////////////////////////////////////
@@ -19,6 +30,8 @@ using namespace std;
 
 template <typename T> class Player;
 template <typename T> class Move;
+template <typename T> class MoveList;
+class OpeningBook;
 
 /////////////////////////////////////////////////////////////
 // Class declarations
@@ -34,6 +47,129 @@ enum class PlayerType {
     RANDOM     ///< A Random player.
 };
 
+/**
+ * @brief Outcome of a game as seen by the player who made the last move.
+ */
+enum class GameResult {
+    ONGOING,   ///< The game is not finished yet.
+    WIN,       ///< The player who just moved has won.
+    LOSE,      ///< The player who just moved has lost.
+    DRAW       ///< The game ended in a draw.
+};
+
+/**
+ * @brief Symmetries under which a board's rules do not change.
+ *
+ * Used by Board::canonical_key() to give symmetric positions one key.
+ */
+enum class Symmetry {
+    NONE,      ///< No symmetry is folded.
+    MIRROR,    ///< Left-right mirror (Connect 4, Pyramid).
+    SQUARE     ///< The 8 rotations and reflections of a square board.
+};
+
+/**
+ * @brief Row-major cell storage in one contiguous buffer.
+ *
+ * @tparam T Type of the elements stored on the board.
+ *
+ * Indexing a Grid returns a pointer to the start of a row, so games keep
+ * writing board[r][c]. Iterating a Grid yields its rows as spans, so
+ * `for (auto& row : board) for (auto& cell : row)` also keeps working.
+ */
+template <typename T>
+class Grid {
+    vector<T> cells; ///< rows * columns elements, row after row
+    int columns;     ///< Elements per row
+
+public:
+    /** @brief Iterates the rows of a grid as spans. */
+    class RowIterator {
+        span<T> row;  ///< Current row
+        int columns;  ///< Elements per row
+    public:
+        RowIterator(T* start, int columns) : row(start, columns), columns(columns) {}
+        span<T>& operator*() { return row; }
+        RowIterator& operator++() {
+            row = span<T>(row.data() + columns, columns);
+            return *this;
+        }
+        bool operator!=(const RowIterator& other) const { return row.data() != other.row.data(); }
+    };
+
+    /** @brief Construct a grid of value-initialised cells. */
+    Grid(int rows, int columns) : cells(size_t(rows) * columns), columns(columns) {}
+
+    /** @brief Start of row r. */
+    T* operator[](int r) { return cells.data() + size_t(r) * columns; }
+
+    /** @brief Start of row r. */
+    const T* operator[](int r) const { return cells.data() + size_t(r) * columns; }
+
+    /** @brief The whole buffer, row after row. */
+    T* data() { return cells.data(); }
+
+    /** @brief The whole buffer, row after row. */
+    const T* data() const { return cells.data(); }
+
+    RowIterator begin() { return RowIterator(cells.data(), columns); }                ///< First row
+    RowIterator end() { return RowIterator(cells.data() + cells.size(), columns); }  ///< Past the last row
+};
+
+/**
+ * @brief Read-only, non-owning view of board cells.
+ *
+ * @tparam T Type of the elements stored on the board.
+ *
+ * Cell (r, c) lives at data[r * row_stride + c * column_stride], so the
+ * same storage can be seen row-major or transposed without copying. Boards
+ * whose grid is padded around a shape (Diamond, Pyramid) attach a mask of
+ * playable cells. A view is only valid while the board it came from lives.
+ */
+template <typename T>
+class BoardView {
+    const T* cells;              ///< First cell
+    int rows;                    ///< Number of rows seen
+    int columns;                 ///< Number of columns seen
+    int row_stride;              ///< Elements between (r, c) and (r + 1, c)
+    int column_stride;           ///< Elements between (r, c) and (r, c + 1)
+    const uint8_t* valid;        ///< Playable-cell mask with the same strides, or nullptr
+
+public:
+    /**
+     * @brief View existing storage.
+     * @param cells First cell.
+     * @param rows Number of rows.
+     * @param columns Number of columns.
+     * @param row_stride Elements from one row to the next.
+     * @param column_stride Elements from one column to the next.
+     * @param valid Optional mask laid out like the cells; nonzero means playable.
+     */
+    BoardView(const T* cells, int rows, int columns, int row_stride, int column_stride = 1,
+              const uint8_t* valid = nullptr)
+        : cells(cells), rows(rows), columns(columns), row_stride(row_stride),
+          column_stride(column_stride), valid(valid) {}
+
+    /** @brief Get number of rows. */
+    int get_rows() const { return rows; }
+
+    /** @brief Get number of columns. */
+    int get_columns() const { return columns; }
+
+    /** @brief Content of cell (r, c). */
+    const T& operator()(int r, int c) const { return cells[r * row_stride + c * column_stride]; }
+
+    /** @brief True if (r, c) is a playable cell; without a mask every cell is. */
+    bool is_valid(int r, int c) const {
+        return valid == nullptr || valid[r * row_stride + c * column_stride] != 0;
+    }
+
+    /** @brief View with rows and columns swapped, sharing the same storage. */
+    BoardView transposed() const {
+        return BoardView(cells, columns, rows, column_stride, row_stride, valid);
+    }
+};
+
 /**
  * @brief Base template for any board used in board games.
  *
@@ -41,21 +177,190 @@ enum class PlayerType {
  *
  * Provides core data (rows, columns, matrix) and virtual methods to be
  * implemented by specific games like Tic-Tac-Toe, Connect4, etc.
+ *
+ * Boards that can be searched by AI_Player also implement the search-facing
+ * methods generate_moves(), evaluate() and position_key(). The older undo
+ * convention of update_board() (a move with symbol 0 clears its cell) only
+ * clears the cell; it does not reverse side effects such as scores.
+ *
+ * Every board carries a Zobrist hash of its cells. It is computed from the
+ * cells the first time it is asked for, and from then on kept up to date by
+ * set_cell(), so cells written after construction must go through set_cell().
+ *
+ * Searches play moves in place with make_move() and take them back with
+ * unmake_move(). Cell writes made by update_board() are journaled, and each
+ * board saves the rest of its state (scores, counters, queues) through the
+ * save_state()/restore_state() hooks, so every side effect is undone.
  */
 template <typename T>
 class Board {
+private:
+    Symmetry symmetry = Symmetry::NONE; ///< Symmetries folded by canonical_key()
+    mutable uint64_t hashes[8];         ///< Zobrist hash of each symmetric image; [0] is the board itself
+    mutable bool hashed = false;        ///< False until the hashes are first computed
+
+    /** @brief Where a move made by make_move() starts in the undo stacks. */
+    struct UndoFrame {
+        size_t journal_size; ///< Cell writes before the move
+        int moves;           ///< n_moves before the move
+    };
+    vector<pair<int, T>> journal;   ///< (cell index, previous value) of every journaled write
+    vector<UndoFrame> frames;       ///< One frame per move made and not yet unmade
+    vector<unsigned char> saved;    ///< Board-specific state pushed by save_state()
+    size_t saved_top = 0;           ///< Bytes of saved in use
+    bool journaling = false;        ///< True while make_move() runs update_board()
+
+    /** @brief Pseudo-random Zobrist key of a symbol on a cell (splitmix64 of the pair). */
+    static uint64_t zobrist(int cell, T value) {
+        uint64_t z = (uint64_t(cell) << 32) ^ uint64_t(value) ^ 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /** @brief Number of symmetric images hashed. */
+    int symmetry_count() const {
+        return symmetry == Symmetry::SQUARE ? 8 : symmetry == Symmetry::MIRROR ? 2 : 1;
+    }
+
+    /** @brief Cell index that (r, c) maps to in symmetric image s. */
+    int image(int s, int r, int c) const {
+        if (symmetry == Symmetry::MIRROR)
+            return r * columns + (s ? columns - 1 - c : c);
+        if (s & 4) swap(r, c);
+        if (s & 2) r = rows - 1 - r;
+        if (s & 1) c = columns - 1 - c;
+        return r * columns + c;
+    }
+
+    /** @brief Hash every cell of every symmetric image from scratch. */
+    void compute_hashes() const {
+        int n = symmetry_count();
+        fill(hashes, hashes + n, 0);
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < columns; ++c)
+                for (int s = 0; s < n; ++s)
+                    hashes[s] ^= zobrist(image(s, r, c), board[r][c]);
+        hashed = true;
+    }
+
 protected:
     int rows;        ///< Number of rows
     int columns;     ///< Number of columns
-    vector<vector<T>> board; ///< 2D vector for the board
+    Grid<T> board;   ///< Contiguous cell storage, indexed board[r][c]
     int n_moves = 0; ///< Number of moves made
+    vector<uint8_t> valid_cells; ///< Playable-cell mask (row-major); empty if every cell is playable
+
+    /**
+     * @brief List a placement of a symbol on every playable cell holding blank.
+     * @param blank Content of an empty cell.
+     * @param symbol Symbol of the player to move.
+     * @param moves Buffer that receives the moves (cleared first), row by row.
+     *
+     * Shared by the boards whose legal moves are "any empty cell".
+     */
+    void generate_placements(T blank, T symbol, MoveList<T>& moves) const {
+        moves.clear();
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < columns; ++j)
+                if (board[i][j] == blank && is_playable(i, j))
+                    moves.push(Move<T>(i, j, symbol));
+    }
+
+    /**
+     * @brief Exact base-3 key of the cells: blank is 0, first is 1, anything else 2.
+     *
+     * Shared by the two-symbol boards as their position_key(); distinct
+     * boards of up to 40 cells get distinct keys.
+     */
+    uint64_t base3_key(T blank, T first) const {
+        uint64_t key = 0;
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < columns; ++j)
+                key = key * 3 + (board[i][j] == blank ? 0 : board[i][j] == first ? 1 : 2);
+        return key;
+    }
+
+    /**
+     * @brief Write a cell and update the Zobrist hashes in O(1).
+     *
+     * Only the hashes of this cell's images change, so the cost does not
+     * depend on the board size.
+     */
+    void set_cell(int r, int c, T value) {
+        T& cell = board[r][c];
+        if (journaling)
+            journal.push_back({ r * columns + c, cell });
+        if (hashed)
+            for (int s = 0, n = symmetry_count(); s < n; ++s) {
+                int i = image(s, r, c);
+                hashes[s] ^= zobrist(i, cell) ^ zobrist(i, value);
+            }
+        cell = value;
+    }
+
+    /**
+     * @brief Save the state a move may change beyond its cells and n_moves.
+     *
+     * Called by make_move() before the move is applied. Boards with scores,
+     * counters or queues push them with push_state(); the default saves
+     * nothing.
+     */
+    virtual void save_state() {}
+
+    /**
+     * @brief Restore what save_state() saved, popping in reverse order.
+     *
+     * Called by unmake_move() after the cells are restored; n_moves still
+     * holds its value from after the move.
+     */
+    virtual void restore_state() {}
+
+    /** @brief Push a trivially copyable value onto the undo stack. */
+    template <typename S>
+    void push_state(const S& value) {
+        static_assert(is_trivially_copyable_v<S>, "saved state must be trivially copyable");
+        size_t at = saved_top;
+        saved_top += sizeof(S);
+        if (saved_top > saved.size())
+            saved.resize(max(saved_top, 2 * saved.size()));
+        memcpy(saved.data() + at, &value, sizeof(S));
+    }
+
+    /** @brief Pop a value pushed by push_state(). */
+    template <typename S>
+    void pop_state(S& value) {
+        saved_top -= sizeof(S);
+        memcpy(&value, saved.data() + saved_top, sizeof(S));
+    }
+
+    /**
+     * @brief Declare the symmetries the board's rules are invariant under.
+     *
+     * SQUARE requires rows == columns. Called from constructors.
+     */
+    void set_symmetry(Symmetry s) {
+        symmetry = s;
+        hashed = false;
+    }
+
+    /**
+     * @brief Mark a cell of a padded grid as outside the playing area.
+     *
+     * The first call creates the mask with every cell playable.
+     */
+    void mark_unplayable(int r, int c) {
+        if (valid_cells.empty())
+            valid_cells.assign(size_t(rows) * columns, 1);
+        valid_cells[size_t(r) * columns + c] = 0;
+    }
 
 public:
     /**
      * @brief Construct a board with given dimensions.
      */
     Board(int rows, int columns)
-        : rows(rows), columns(columns), board(rows, vector<T>(columns)) {}
+        : rows(rows), columns(columns), board(rows, columns) {}
 
     /**
      * @brief Virtual destructor. Frees allocated board memory.
@@ -81,11 +386,158 @@ public:
     /** @brief Check if the game is over. */
     virtual bool game_is_over(Player<T>*) = 0;
 
+    /**
+     * @brief Extra text describing how a finished game was scored.
+     *
+     * Shown by GameManager before the result line. Boards that decide the
+     * winner by points (e.g. counting sequences) override this.
+     */
+    virtual string result_summary() const { return ""; }
+
+    /**
+     * @brief Seed of the random decisions the board makes itself (e.g. obstacles).
+     *
+     * Game records store it so a replay can call seed() with it and see the
+     * same decisions. Boards that make none return 0.
+     */
+    virtual uint64_t get_seed() const { return 0; }
+
+    /** @brief Restart the board's own random decisions from a get_seed() value. */
+    virtual void seed(uint64_t) {}
+
+    /**
+     * @brief Look the position up in an opening book.
+     * @param book Book made for this kind of board.
+     * @param symbol Symbol of the side to move.
+     * @param move Set to the book move when one is found.
+     * @return true if the book holds the position and its move is legal here.
+     *         Boards without a book key return false.
+     */
+    virtual bool book_move(const OpeningBook& book, T symbol, Move<T>& move) const { return false; }
+
+    /**
+     * @brief Play a move in place so that unmake_move() can take it back.
+     * @param move The move, as passed to update_board().
+     * @return true if update_board() accepted the move. A rejected move
+     *         leaves the board unchanged and needs no unmake_move().
+     *
+     * The undo stacks grow to the deepest line searched and are then reused,
+     * so a search allocates nothing after its first few moves.
+     */
+    bool make_move(const Move<T>& move) {
+        if (frames.capacity() == 0) {
+            frames.reserve(64);
+            journal.reserve(256);
+            saved.resize(1024);
+        }
+        frames.push_back({ journal.size(), n_moves });
+        save_state();
+        Move<T> m = move;
+        journaling = true;
+        bool ok = update_board(&m);
+        journaling = false;
+        if (!ok) unmake_move();
+        return ok;
+    }
+
+    /**
+     * @brief Take back the last move played by make_move(), in O(1).
+     *
+     * Restores the journaled cells (and with them the Zobrist hashes), the
+     * board-specific state and the move count.
+     */
+    void unmake_move() {
+        UndoFrame frame = frames.back();
+        frames.pop_back();
+        while (journal.size() > frame.journal_size) {
+            pair<int, T> write = journal.back();
+            journal.pop_back();
+            set_cell(write.first / columns, write.first % columns, write.second);
+        }
+        restore_state();
+        n_moves = frame.moves;
+    }
+
+    /** @brief Moves made by make_move() and not yet taken back. */
+    int undo_depth() const { return static_cast<int>(frames.size()); }
+
+    /**
+     * @brief Write the legal moves of a player into a caller-provided buffer.
+     * @param symbol Symbol of the player to move.
+     * @param moves Buffer that receives the moves (cleared first).
+     *
+     * Every move written must be accepted by update_board(). Moves are
+     * written best-first where the board has a natural order (e.g. central
+     * cells first), which helps search pruning. The default writes nothing.
+     */
+    virtual void generate_moves(T symbol, MoveList<T>& moves) { moves.clear(); }
+
+    /**
+     * @brief Heuristic score of the position for a player.
+     * @param symbol Symbol of the player the score is for.
+     * @return Positive if the position favours that player. Scores stay well
+     *         below AI_Player's win score so they never look like a won game.
+     */
+    virtual int evaluate(T symbol) { return 0; }
+
+    /**
+     * @brief Key identifying the current position, for transposition tables.
+     *
+     * Equal positions must give equal keys. The default is the Zobrist hash
+     * of the cells; boards with state beyond their cells (or with a cheaper
+     * exact encoding) override it.
+     */
+    virtual uint64_t position_key() const { return zobrist_key(); }
+
+    /**
+     * @brief 64-bit Zobrist hash of the cells.
+     *
+     * The first call hashes every cell; later calls are O(1) because
+     * set_cell() keeps the hash current. Not safe to call on one board from
+     * several threads at once.
+     */
+    uint64_t zobrist_key() const {
+        if (!hashed) compute_hashes();
+        return hashes[0];
+    }
+
+    /**
+     * @brief Zobrist key shared by all positions symmetric to this one.
+     *
+     * The smallest hash over the images of the board under its declared
+     * Symmetry, so mirrored or rotated positions get one key. Without a
+     * declared symmetry this is zobrist_key().
+     */
+    uint64_t canonical_key() const {
+        if (!hashed) compute_hashes();
+        return *min_element(hashes, hashes + symmetry_count());
+    }
+
+    /**
+     * @brief Read-only view of the cells; costs no copy or allocation.
+     */
+    BoardView<T> view() const {
+        return BoardView<T>(board.data(), rows, columns, columns, 1,
+                            valid_cells.empty() ? nullptr : valid_cells.data());
+    }
+
     /**
      * @brief Return a copy of the current board as a 2D vector.
+     *
+     * Kept for existing callers; view() reads the same cells without copying.
      */
     vector<vector<T>> get_board_matrix() const {
-        return board;
+        vector<vector<T>> matrix(rows, vector<T>(columns));
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < columns; ++j)
+                matrix[i][j] = board[i][j];
+        return matrix;
+    }
+
+    /** @brief True if (r, c) lies inside the board's playing area. */
+    bool is_playable(int r, int c) const {
+        return r >= 0 && r < rows && c >= 0 && c < columns &&
+               (valid_cells.empty() || valid_cells[size_t(r) * columns + c]);
     }
 
     /** @brief Get number of rows. */
@@ -98,7 +550,7 @@ public:
     int get_n_moves() const { return n_moves; }
 
     /** @brief Return content of cell x, y in current board. */
-    T get_cell(int x, int y) {
+    T get_cell(int x, int y) const {
         return board[x][y];
     }
 };
@@ -108,17 +560,39 @@ public:
  * @brief Represents a single move in a board game.
  *
  * @tparam T Type of symbol placed on the board (e.g., char, int).
+ *
+ * Most games place a symbol on (x, y). Games that move a stone already on
+ * the board (Tic_Tac_Toe_4X4) also give the cell it leaves, so the whole
+ * turn is one move; placements have no source cell.
  */
 template <typename T>
 class Move {
-    int x;      ///< Row index
-    int y;      ///< Column index
-    T symbol;   ///< Symbol used in the move
+    int x;              ///< Row index
+    int y;              ///< Column index
+    T symbol;           ///< Symbol used in the move
+    int from_x = -1;    ///< Row the stone leaves, or -1 for a placement
+    int from_y = -1;    ///< Column the stone leaves, or -1 for a placement
 
 public:
+    /** @brief Construct an empty move at (0, 0), used to fill move buffers. */
+    Move() : x(0), y(0), symbol() {}
+
     /** @brief Construct a move at (x, y) using a symbol. */
     Move(int x, int y, T symbol) : x(x), y(y), symbol(symbol) {}
 
+    /** @brief Construct a move of the stone on (from_x, from_y) to (x, y). */
+    Move(int from_x, int from_y, int x, int y, T symbol)
+        : x(x), y(y), symbol(symbol), from_x(from_x), from_y(from_y) {}
+
+    /** @brief True if the move takes a stone from another cell. */
+    bool has_from() const { return from_x >= 0; }
+
+    /** @brief Row the stone leaves, or -1 for a placement. */
+    int get_from_x() const { return from_x; }
+
+    /** @brief Column the stone leaves, or -1 for a placement. */
+    int get_from_y() const { return from_y; }
+
     /** @brief Get row index. */
     int get_x() const { return x; }
 
@@ -127,6 +601,57 @@ public:
 
     /** @brief Get the move symbol. */
     T get_symbol() const { return symbol; }
+
+    /** @brief Two moves are equal if they put the same symbol on the same cell from the same source. */
+    bool operator==(const Move& other) const {
+        return x == other.x && y == other.y && symbol == other.symbol &&
+               from_x == other.from_x && from_y == other.from_y;
+    }
+};
+
+//-----------------------------------------------------
+/**
+ * @brief Fixed-capacity buffer of moves filled by Board::generate_moves().
+ *
+ * @tparam T Type of symbol placed on the board.
+ *
+ * Lives on the caller's stack, so generating moves never allocates. The
+ * capacity covers the largest move set of any board (a letter for every
+ * cell of the Word game).
+ */
+template <typename T>
+class MoveList {
+public:
+    static const int capacity = 256; ///< Maximum number of moves held
+
+    /** @brief Remove all moves. */
+    void clear() { count = 0; }
+
+    /** @brief Append a move; moves beyond the capacity are dropped. */
+    void push(const Move<T>& move) {
+        if (count < capacity) moves[count++] = move;
+    }
+
+    /** @brief Number of moves held. */
+    int size() const { return count; }
+
+    /** @brief True if the list holds no moves. */
+    bool empty() const { return count == 0; }
+
+    /** @brief Access the i-th move. */
+    Move<T>& operator[](int i) { return moves[i]; }
+
+    /** @brief Access the i-th move. */
+    const Move<T>& operator[](int i) const { return moves[i]; }
+
+    Move<T>* begin() { return moves; }             ///< First move
+    Move<T>* end() { return moves + count; }       ///< Past the last move
+    const Move<T>* begin() const { return moves; } ///< First move
+    const Move<T>* end() const { return moves + count; } ///< Past the last move
+
+private:
+    Move<T> moves[capacity]; ///< Storage
+    int count = 0;           ///< Number of moves held
 };
 
 //-----------------------------------------------------
@@ -166,6 +691,14 @@ public:
 
     /** @brief Assign the board pointer for the player. */
     void set_board_ptr(Board<T>* b) { boardPtr = b; }
+
+    /**
+     * @brief Add the counters of the player's last search to stats.
+     *
+     * Called by GameManager after each move when instrumentation is on.
+     * Players that do not search record nothing.
+     */
+    virtual void report_search(GameStats& stats) const {}
 };
 
 //-----------------------------------------------------
@@ -198,7 +731,18 @@ protected:
             cout << i + 1 << ". " << options[i] << "\n";
         int choice;
         cin >> choice;
-        return (choice == 2) ? PlayerType::COMPUTER : PlayerType::HUMAN;
+        if (choice == 2) return PlayerType::COMPUTER;
+        if (choice == 3 && options.size() > 2) return PlayerType::AI;
+        return PlayerType::HUMAN;
+    }
+
+    /**
+     * @brief Player types offered by setup_players(), in menu order.
+     *
+     * UIs whose game has a search player add "AI" as the third option.
+     */
+    virtual vector<string> player_type_options() const {
+        return { "Human", "Computer" };
     }
 
 public:
@@ -220,10 +764,20 @@ public:
     /** @brief Display any message to the user. */
     virtual void display_message(string message) { cout << message << "\n"; }
 
+    /**
+     * @brief Ask the user (or AI) to make a move, returned by value.
+     *
+     * This is what the game loop calls, so a turn allocates nothing.
+     */
+    virtual Move<T> next_move(Player<T>* player) = 0;
+
     /**
      * @brief Ask the user (or AI) to make a move.
+     * @return A new move owned by the caller.
+     *
+     * Compatibility form of next_move() for callers of the pointer API.
      */
-    virtual Move<T>* get_move(Player<T>*) = 0;
+    Move<T>* get_move(Player<T>* player) { return new Move<T>(next_move(player)); }
 
     /**
      * @brief Set up players for the game.
@@ -236,14 +790,14 @@ public:
     virtual Player<T>* create_player(string& name, T symbol, PlayerType type);
 
     /**
-     * @brief Display the current board matrix in formatted form.
+     * @brief Display the current board in formatted form.
      */
 
-    virtual void display_board_matrix(const vector<vector<T>>& matrix) const {
-        if (matrix.empty() || matrix[0].empty()) return;
+    virtual void display_board_matrix(const BoardView<T>& matrix) const {
+        if (matrix.get_rows() == 0 || matrix.get_columns() == 0) return;
 
-        int rows = matrix.size();
-        int cols = matrix[0].size();
+        int rows = matrix.get_rows();
+        int cols = matrix.get_columns();
 
         cout << "\n    ";
         for (int j = 0; j < cols; ++j)
@@ -253,13 +807,326 @@ public:
         for (int i = 0; i < rows; ++i) {
             cout << setw(2) << i << " |";
             for (int j = 0; j < cols; ++j)
-                cout << setw(cell_width) << matrix[i][j] << " |";
+                cout << setw(cell_width) << matrix(i, j) << " |";
             cout << "\n   " << string((cell_width + 2) * cols, '-') << "\n";
         }
         cout << endl;
     }
 };
 
+//-----------------------------------------------------
+/**
+ * @brief Evaluate the board right after a player's move.
+ *
+ * Applies the checks in the order GameManager has always used them:
+ * is_win, then is_lose, then is_draw, all for the player who just moved.
+ *
+ * @param board The game board. Passing the concrete (final) board type
+ *        instead of Board<T> lets the compiler call the checks directly.
+ * @param mover The player who made the last move.
+ * @return The result from the mover's point of view.
+ */
+template <typename T, typename B>
+GameResult check_result(B* board, Player<T>* mover) {
+    if (board->is_win(mover)) return GameResult::WIN;
+    if (board->is_lose(mover)) return GameResult::LOSE;
+    if (board->is_draw(mover)) return GameResult::DRAW;
+    return GameResult::ONGOING;
+}
+
+//-----------------------------------------------------
+/**
+ * @brief Play a recorded game into a new board through update_board().
+ *
+ * The board is first reseeded with the record's seed, so boards that make
+ * random decisions of their own repeat those of the recorded game.
+ *
+ * @param game A game read from a GameRecordFile.
+ * @param board A freshly constructed board of the game's variant; the
+ *        concrete (final) type lets the moves be applied without virtual calls.
+ * @param moves Number of moves to play, or -1 for all of them.
+ * @return false if a move does not decode or the board rejects it.
+ */
+template <typename B>
+bool replay(const RecordedGame& game, B* board, int moves = -1) {
+    if (moves < 0 || moves > game.plies) moves = game.plies;
+    board->seed(game.seed);
+    for (int i = 0; i < moves; ++i) {
+        int x, y, from_x, from_y;
+        char symbol;
+        if (!game.move(i, x, y, symbol, from_x, from_y)) return false;
+        Move<char> move(from_x, from_y, x, y, symbol);
+        if (!board->update_board(&move)) return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------
+/**
+ * @brief Pick a uniformly random legal move.
+ *
+ * Chooses from Board::generate_moves(), so the board never has to reject
+ * the move; random computer players use this instead of guessing cells.
+ * The choice is drawn from the calling thread's generator (thread_rng()).
+ *
+ * Each UI's static computer_move() is built on this. Like random_move(), it
+ * does no console I/O and leaves the board as it found it, so it needs no
+ * UI object and can serve as a SelfPlayRunner move policy.
+ *
+ * @param board The game board.
+ * @param symbol Symbol of the player to move.
+ * @return A legal move, or a move at (-1, -1) if there is none.
+ */
+template <typename T>
+Move<T> random_move(Board<T>* board, T symbol) {
+    MoveList<T> moves;
+    board->generate_moves(symbol, moves);
+    if (moves.empty())
+        return Move<T>(-1, -1, symbol);
+    return moves[thread_rng().below(static_cast<uint32_t>(moves.size()))];
+}
+
+//-----------------------------------------------------
+/**
+ * @brief Where a GameSession is in its game.
+ */
+enum class SessionState {
+    AWAITING_MOVE, ///< Waiting for current_player() to submit a move.
+    THINKING,      ///< A computer move of current_player() is being searched.
+    FINISHED       ///< The game is over; see outcome().
+};
+
+/**
+ * @brief What GameSession::submit_move() did with a move.
+ */
+enum class SubmitResult {
+    ACCEPTED,      ///< The board took the move; the turn passed (or the game ended).
+    REJECTED,      ///< The board refused the move; the same player moves again.
+    NOT_YOUR_TURN, ///< The move came from the seat that is not to move.
+    STALE,         ///< The move was chosen for an earlier turn, or while a search is running.
+    FINISHED       ///< The game is already over.
+};
+
+/**
+ * @brief A two-player game advanced one submitted move at a time.
+ *
+ * @tparam T Type of symbol used on the board.
+ *
+ * GameManager::run() blocks until it has a move. A session instead is a
+ * state machine: the host feeds it moves with submit_move() whenever they
+ * arrive (a human's input read from a socket, or a computer move finished on
+ * a WorkerPool) and reads current_player() and outcome() between steps, so
+ * one thread can host any number of live games. GameManager is the console
+ * adapter over this class.
+ *
+ * Players alternate starting with players[0]. After each accepted move the
+ * result is taken from check_result() for the mover.
+ *
+ * A session does not own its board or players and is not thread-safe: call
+ * it from one thread (the event loop). While a computer move is being
+ * searched (state() is THINKING) the worker uses the board, so the loop must
+ * not touch the board until the completion arrives; state(), current_index()
+ * and turn() stay safe to call.
+ *
+ * Usage:
+ * @code
+ * GameSession<char> session(board, players);
+ * // human seat: when input arrives
+ * if (session.submit_move(0, Move<char>(x, y, 'X')) == SubmitResult::REJECTED) ask_again();
+ * // computer seat: search on the pool, hand the move back to the loop
+ * session.think(pool, CONNECT_UI::computer_move, [&](Move<char> move, long long turn) {
+ *     loop.post([&, move, turn] { session.submit_move(1, move, turn); });
+ * });
+ * @endcode
+ */
+template <typename T>
+class GameSession {
+public:
+    /**
+     * @brief Chooses the move of a computer player; runs on a worker thread.
+     */
+    using MovePolicy = function<Move<T>(Player<T>*)>;
+
+    /**
+     * @brief Receives a computed move and the turn it was computed for.
+     *
+     * Called on the worker thread. It should hand both to the event loop,
+     * which passes them to submit_move().
+     */
+    using Completion = function<void(Move<T>, long long)>;
+
+    /**
+     * @brief Start a session on a board and two players, first player to move.
+     *
+     * The board and players are not owned and must outlive the session.
+     */
+    GameSession(Board<T>* b, Player<T>* p[2]) : board(b) {
+        players[0] = p[0];
+        players[1] = p[1];
+        players[0]->set_board_ptr(b);
+        players[1]->set_board_ptr(b);
+    }
+
+    /** @brief Current state of the game. */
+    SessionState state() const { return current_state; }
+
+    /** @brief Index (0 or 1) of the player to move, or of the last mover once finished. */
+    int current_index() const { return seat; }
+
+    /** @brief The player to move, or the last mover once finished. */
+    Player<T>* current_player() const { return players[seat]; }
+
+    /** @brief Player by index (0 moves first). */
+    Player<T>* player(int index) const { return players[index]; }
+
+    /** @brief The board of the game. */
+    Board<T>* get_board() const { return board; }
+
+    /** @brief Number of moves accepted so far; identifies the turn a move is meant for. */
+    long long turn() const { return turns; }
+
+    /**
+     * @brief Result from the first player's point of view.
+     * @return ONGOING until the game finishes, then WIN, LOSE or DRAW for players[0].
+     */
+    GameResult outcome() const { return result; }
+
+    /** @brief The winning player, or nullptr while ongoing or on a draw. */
+    Player<T>* winner() const {
+        if (result == GameResult::WIN) return players[0];
+        if (result == GameResult::LOSE) return players[1];
+        return nullptr;
+    }
+
+    /**
+     * @brief Record update_board and outcome timings, move counts and search counters into s.
+     * @param s Statistics to add to, or nullptr to turn instrumentation off
+     */
+    void set_stats(GameStats* s) { stats = s; }
+
+    /**
+     * @brief Append the game to a record file once it finishes.
+     * @param w Writer to append to, or nullptr to stop recording
+     * @param variant Menu number of the game (see record_variant()); games
+     *        of variants that cannot be recorded are skipped
+     *
+     * Call it before the first move.
+     */
+    void set_record(GameRecordWriter* w, int variant) {
+        writer = w;
+        record.start(variant, board->get_seed(), static_cast<char>(players[0]->get_symbol()),
+                     static_cast<char>(players[1]->get_symbol()));
+    }
+
+    /**
+     * @brief Apply a move for a seat.
+     * @param index Seat the move comes from (0 or 1).
+     * @param move Move to apply.
+     * @param for_turn turn() the move was chosen for, or -1 to skip the check.
+     *        A computer move carries the turn passed to its Completion, so a
+     *        move that arrives after the position changed is refused.
+     * @return What happened to the move; only ACCEPTED changes the position.
+     */
+    SubmitResult submit_move(int index, Move<T> move, long long for_turn = -1) {
+        if (current_state == SessionState::FINISHED) return SubmitResult::FINISHED;
+        if (index != seat) return SubmitResult::NOT_YOUR_TURN;
+        if (for_turn >= 0 ? for_turn != turns : current_state == SessionState::THINKING)
+            return SubmitResult::STALE;
+        current_state = SessionState::AWAITING_MOVE;
+
+        Move<T> submitted = move;
+        if (!timed_update(move)) {
+            if (stats) stats->rejected_moves.fetch_add(1, memory_order_relaxed);
+            return SubmitResult::REJECTED;
+        }
+        ++turns;
+        if (stats) {
+            stats->turns.fetch_add(1, memory_order_relaxed);
+            players[seat]->report_search(*stats);
+        }
+        if (writer)
+            record.add(submitted.get_x(), submitted.get_y(), static_cast<char>(submitted.get_symbol()),
+                       submitted.get_from_x(), submitted.get_from_y());
+
+        GameResult mover_result = timed_result(players[seat]);
+        if (mover_result == GameResult::ONGOING) {
+            seat = 1 - seat;
+            return SubmitResult::ACCEPTED;
+        }
+        // Turn the mover's point of view into the first player's
+        result = mover_result;
+        if (seat == 1 && result == GameResult::WIN) result = GameResult::LOSE;
+        else if (seat == 1 && result == GameResult::LOSE) result = GameResult::WIN;
+        current_state = SessionState::FINISHED;
+        if (stats) stats->games.fetch_add(1, memory_order_relaxed);
+        if (writer) {
+            record.result = static_cast<uint8_t>(result);
+            writer->write(record);
+        }
+        return SubmitResult::ACCEPTED;
+    }
+
+    /**
+     * @brief Compute the current player's move on a worker thread.
+     * @param pool Pool that runs the search: anything with
+     *        submit(function<void()>), e.g. WorkerPool.
+     * @param policy Chooses the move, e.g. a UI's computer_move or an AI player's search.
+     * @param done Receives the move and the turn it is for; pass both to submit_move().
+     * @return false (and nothing is queued) unless the session is AWAITING_MOVE.
+     *
+     * The session is THINKING until the completion is submitted. If the board
+     * rejects that move the session awaits a move again and think() can be
+     * called once more.
+     */
+    template <typename Pool>
+    bool think(Pool& pool, MovePolicy policy, Completion done) {
+        if (current_state != SessionState::AWAITING_MOVE) return false;
+        current_state = SessionState::THINKING;
+        Player<T>* mover = players[seat];
+        long long for_turn = turns;
+        pool.submit([mover, for_turn, policy = std::move(policy), done = std::move(done)] {
+            done(policy(mover), for_turn);
+        });
+        return true;
+    }
+
+private:
+    Board<T>* board;          ///< Game board
+    Player<T>* players[2];    ///< Two players
+    GameStats* stats = nullptr; ///< Instrumentation, or nullptr when off
+    GameRecordWriter* writer = nullptr; ///< Record file, or nullptr when not recording
+    GameRecord record;        ///< Moves of the game so far, when recording
+    SessionState current_state = SessionState::AWAITING_MOVE; ///< Where the game is
+    GameResult result = GameResult::ONGOING; ///< Outcome for players[0]
+    int seat = 0;             ///< Index of the player to move
+    long long turns = 0;      ///< Moves accepted
+
+    using Clock = chrono::steady_clock;
+
+    /** @brief Nanoseconds since start. */
+    static long long since(Clock::time_point start) {
+        return chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    /** @brief Apply a move, timing it when instrumented. */
+    bool timed_update(Move<T>& move) {
+        if (!stats) return board->update_board(&move);
+        Clock::time_point start = Clock::now();
+        bool accepted = board->update_board(&move);
+        stats->update_board.record(since(start));
+        return accepted;
+    }
+
+    /** @brief Check the outcome for player, timing it when instrumented. */
+    GameResult timed_result(Player<T>* player) {
+        if (!stats) return check_result(board, player);
+        Clock::time_point start = Clock::now();
+        GameResult mover_result = check_result(board, player);
+        stats->outcome.record(since(start));
+        return mover_result;
+    }
+};
+
 //-----------------------------------------------------
 /**
  * @brief Controls the flow of a board game between two players.
@@ -271,6 +1138,20 @@ class GameManager {
     Board<T>* boardPtr;    ///< Game board
     Player<T>* players[2]; ///< Two players
     UI<T>* ui;             ///< User interface
+    GameStats* stats = nullptr; ///< Instrumentation, or nullptr when off
+    GameRecordWriter* writer = nullptr; ///< Record file, or nullptr when not recording
+    int variant = 0;       ///< Menu number of the game, for its record
+
+    using Clock = chrono::steady_clock;
+
+    /** @brief Ask the UI for a move, timing it when instrumented. */
+    Move<T> timed_next_move(Player<T>* player) {
+        if (!stats) return ui->next_move(player);
+        Clock::time_point start = Clock::now();
+        Move<T> move = ui->next_move(player);
+        stats->get_move.record(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count());
+        return move;
+    }
 
 public:
     /**
@@ -284,37 +1165,50 @@ public:
         players[1]->set_board_ptr(b);
     }
 
+    /**
+     * @brief Record per-turn timings and counters of run() into s.
+     * @param s Statistics to add to, or nullptr (the default) to turn instrumentation off
+     *
+     * With no statistics run() reads no clocks.
+     */
+    void set_stats(GameStats* s) { stats = s; }
+
+    /**
+     * @brief Append the game played by run() to a record file.
+     * @param w Writer to append to, or nullptr (the default) not to record
+     * @param variant_id Menu number of the game (see record_variant())
+     */
+    void set_record(GameRecordWriter* w, int variant_id) {
+        writer = w;
+        variant = variant_id;
+    }
+
     /**
      * @brief Run the main game loop until someone wins or the game ends.
+     *
+     * Drives a GameSession from the console: every move is read through the
+     * UI (blocking) and submitted until the board accepts it.
      */
     void run() {
-        ui->display_board_matrix(boardPtr->get_board_matrix());
-        Player<T>* currentPlayer = players[0];
-
-        while (true) {
-            for (int i : {0, 1}) {
-                currentPlayer = players[i];
-                Move<T>* move = ui->get_move(currentPlayer);
-
-                while (!boardPtr->update_board(move))
-                    move = ui->get_move(currentPlayer);
-
-                ui->display_board_matrix(boardPtr->get_board_matrix());
-
-                if (boardPtr->is_win(currentPlayer)) {
-                    ui->display_message(currentPlayer->get_name() + " wins!");
-                    return;
-                }
-                if (boardPtr->is_lose(currentPlayer)) {
-                    ui->display_message(players[1 - i]->get_name() + " wins!");
-                    return;
-                }
-                if (boardPtr->is_draw(currentPlayer)) {
-                    ui->display_message("Draw!");
-                    return;
-                }
-            }
+        GameSession<T> session(boardPtr, players);
+        session.set_stats(stats);
+        if (writer) session.set_record(writer, variant);
+        ui->display_board_matrix(boardPtr->view());
+
+        while (session.state() != SessionState::FINISHED) {
+            int i = session.current_index();
+            while (session.submit_move(i, timed_next_move(players[i])) == SubmitResult::REJECTED) {}
+            ui->display_board_matrix(boardPtr->view());
         }
+
+        string summary = boardPtr->result_summary();
+        if (!summary.empty())
+            ui->display_message(summary);
+
+        if (Player<T>* winner = session.winner())
+            ui->display_message(winner->get_name() + " wins!");
+        else
+            ui->display_message("Draw!");
     }
 };
 
@@ -325,7 +1219,7 @@ public:
 template <typename T>
 Player<T>** UI<T>::setup_players() {
     Player<T>** players = new Player<T>*[2];
-    vector<string> type_options = { "Human", "Computer" };
+    vector<string> type_options = player_type_options();
 
     string nameX = get_player_name("Player X");
     PlayerType typeX = get_player_type_choice("Player X", type_options);
@@ -11,15 +11,115 @@
  * The game uses a unique winning condition: a player must simultaneously have
  * at least one complete line of length 3 AND one complete line of length 4,
  * where these lines are in different directions (horizontal, vertical, or diagonal).
+ *
+ * The 13 diamond cells are numbered by ShapedBoard's Layout as bits of a
+ * 16-bit mask, and every winning line is a constexpr mask over those bits,
+ * so win detection is a few AND/compare operations with no allocation.
  */
 
 #ifndef _DIAMOND_TICTACTOE_H
 #define _DIAMOND_TICTACTOE_H
 
 #include "BoardGame_Classes.h"
-#include <vector>
-#include <utility>
-#include <cmath>
+#include "FixedBoard.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+/**
+ * @brief Constexpr tables of the diamond's cells and winning lines.
+ *
+ * Cells are numbered 0-12 in row-major order; lines are stored as masks over
+ * those numbers together with their direction and length.
+ */
+namespace diamond_lines {
+    constexpr int SIZE = 5;          ///< Side of the grid holding the diamond
+    constexpr int COUNT = 20;        ///< Lines of length 3 or 4 inside the diamond
+    constexpr int MAX_PER_CELL = 12; ///< Most lines through one cell (the centre)
+
+    /** @brief A line of 3 or 4 cells. Directions: 0 horizontal, 1 vertical, 2 main diagonal, 3 anti diagonal. */
+    struct Line {
+        uint16_t mask;  ///< Bits of the cells of the line
+        uint8_t dir;    ///< Direction of the line
+        uint8_t length; ///< 3 or 4
+    };
+
+    /** @brief Indices (into LINES) of the lines through one cell. */
+    struct CellLines {
+        uint8_t count;
+        uint8_t index[MAX_PER_CELL];
+    };
+
+    /** @brief True if (r, c) is inside the diamond: |r - 2| + |c - 2| <= 2. */
+    constexpr bool on_diamond(int r, int c) {
+        return r >= 0 && r < SIZE && c >= 0 && c < SIZE
+            && (r > 2 ? r - 2 : 2 - r) + (c > 2 ? c - 2 : 2 - c) <= 2;
+    }
+
+    /** @brief The diamond as a ShapedBoard shape. */
+    struct Shape {
+        static constexpr bool playable(int r, int c) { return on_diamond(r, c); }
+    };
+
+    using Layout = CellLayout<SIZE, SIZE, Shape>; ///< Dense numbering of the diamond cells
+
+    constexpr int CELLS = Layout::CELLS; ///< Cells inside the diamond
+    static_assert(CELLS == 13, "the diamond has 13 cells");
+
+    /** @brief Bit of each grid cell (row * 5 + column), or -1 outside the diamond. */
+    constexpr const auto& BIT = Layout::INDEX;
+
+    /** @brief Every line of 3 or 4 diamond cells, each listed once. */
+    constexpr std::array<Line, COUNT> make_lines() {
+        std::array<Line, COUNT> lines{};
+        const int dr[4] = { 0, 1, 1, 1 };
+        const int dc[4] = { 1, 0, 1, -1 };
+        int n = 0;
+        for (int length = 3; length <= 4; ++length)
+            for (int r = 0; r < SIZE; ++r)
+                for (int c = 0; c < SIZE; ++c)
+                    for (int d = 0; d < 4; ++d) {
+                        uint16_t mask = 0;
+                        bool inside = true;
+                        for (int k = 0; k < length && inside; ++k) {
+                            int rr = r + k * dr[d], cc = c + k * dc[d];
+                            inside = on_diamond(rr, cc);
+                            if (inside) mask |= uint16_t(1u << BIT[rr * SIZE + cc]);
+                        }
+                        if (inside) lines[n++] = { mask, uint8_t(d), uint8_t(length) };
+                    }
+        return lines;
+    }
+
+    constexpr std::array<Line, COUNT> LINES = make_lines();
+    static_assert(LINES[COUNT - 1].mask != 0, "COUNT must match the number of diamond lines");
+
+    /** @brief For each cell, the lines that pass through it. */
+    constexpr std::array<CellLines, CELLS> make_cell_lines() {
+        std::array<CellLines, CELLS> through{};
+        for (int i = 0; i < COUNT; ++i)
+            for (int b = 0; b < CELLS; ++b)
+                if (LINES[i].mask & (1u << b))
+                    through[b].index[through[b].count++] = uint8_t(i);
+        return through;
+    }
+
+    constexpr std::array<CellLines, CELLS> THROUGH = make_cell_lines();
+
+    /** @brief Full-line bit of a line: low nibble for length 3, high nibble for length 4. */
+    constexpr uint8_t full_bit(const Line& line) {
+        return uint8_t((line.length == 3 ? 1 : 16) << line.dir);
+    }
+
+    /**
+     * @brief True if the full lines include a 3-line and a 4-line in different directions.
+     * @param full Full-line bits (see full_bit())
+     */
+    constexpr bool wins(uint8_t full) {
+        uint8_t d3 = full & 15, d4 = full >> 4;
+        return d3 && d4 && !(d3 == d4 && (d3 & (d3 - 1)) == 0);
+    }
+}
 
  /**
   * @class DiamondTicTacToe
@@ -48,7 +148,7 @@
   * - Invalid cells outside the diamond cannot be played
   */
 template <typename T>
-class DiamondTicTacToe : public Board<T> {
+class DiamondTicTacToe final : public ShapedBoard<T, 5, 5, diamond_lines::Shape> {
 public:
     /**
      * @brief Constructs a new Diamond Tic-Tac-Toe board
@@ -59,23 +159,15 @@ public:
      * Initializes a 5x5 grid where only diamond-shaped cells are valid for play.
      * The constructor:
      * - Sets all cells to the empty marker
-     * - Counts the number of valid cells (13 in diamond pattern)
-     * - Precomputes all possible winning lines of length 3 and 4
+     * - Leaves ShapedBoard to mark the cells outside the diamond as unplayable
      *
      * @note The diamond is centered at (2,2) with Manhattan distance radius of 2
      */
-    DiamondTicTacToe(T empty_cell = static_cast<T>(' ')) :
-        Board<T>(5, 5), empty_marker(empty_cell) {
-        valid_cell_count = 0;
-        for (int r = 0; r < this->rows; ++r) {
-            for (int c = 0; c < this->columns; ++c) {
-                this->board[r][c] = empty_marker;
-                if (is_valid_cell(r, c)) {
-                    ++valid_cell_count;
-                }
-            }
-        }
-        precompute_lines();
+    DiamondTicTacToe(T empty_cell = static_cast<T>(' ')) : empty_marker(empty_cell) {
+        this->set_symmetry(Symmetry::SQUARE);
+        for (auto& row : this->board)
+            for (auto& cell : row)
+                cell = empty_marker;
     }
 
     /**
@@ -97,7 +189,8 @@ public:
      * - Position is a valid cell within the diamond shape
      * - Target cell is currently empty
      *
-     * If valid, places the symbol and increments move counter.
+     * If valid, places the symbol, increments move counter and marks the
+     * lines through the cell that the move completes.
      *
      * @note Invalid cells outside the diamond pattern will be rejected
      * @warning Does not check for game-over conditions
@@ -107,12 +200,21 @@ public:
         int y = move->get_y();
         T sym = move->get_symbol();
 
-        if (x < 0 || x >= this->rows || y < 0 || y >= this->columns) return false;
-        if (!is_valid_cell(x, y)) return false;
+        int bit = this->cell_index(x, y);
+        if (bit < 0) return false;
         if (this->board[x][y] != empty_marker) return false;
 
-        this->board[x][y] = sym;
+        this->set_cell(x, y, sym);
         ++this->n_moves;
+        int side = side_of(sym);
+        if (side >= 0) {
+            stones[side] |= uint16_t(1u << bit);
+            const diamond_lines::CellLines& through = diamond_lines::THROUGH[bit];
+            for (int i = 0; i < through.count; ++i) {
+                const diamond_lines::Line& line = diamond_lines::LINES[through.index[i]];
+                if ((stones[side] & line.mask) == line.mask) full[side] |= diamond_lines::full_bit(line);
+            }
+        }
         return true;
     }
 
@@ -128,31 +230,15 @@ public:
      * 2. At least one complete line of length 4
      * 3. These lines must be in different directions (horizontal, vertical, main diagonal, anti diagonal)
      *
-     * The algorithm:
-     * - Scans all precomputed 3-length lines for player's symbol
-     * - Scans all precomputed 4-length lines for player's symbol
-     * - Checks if any 3-line direction differs from any 4-line direction
+     * The full lines of 'X' and 'O' are kept up to date by update_board(),
+     * which only looks at the lines through the cell just played, so this is
+     * a constant-time check of their directions.
      *
      * @note Lines may share up to one common cell
      * @note Directions are: 0=horizontal, 1=vertical, 2=main diagonal, 3=anti diagonal
      */
     virtual bool is_win(Player<T>* p) override {
-        T sym = p->get_symbol();
-        std::vector<int> three_dirs;
-        std::vector<int> four_dirs;
-
-        for (size_t i = 0; i < lines3.size(); ++i) {
-            if (line_all_symbol(lines3[i].coords, sym)) three_dirs.push_back(lines3[i].dir);
-        }
-        for (size_t i = 0; i < lines4.size(); ++i) {
-            if (line_all_symbol(lines4[i].coords, sym)) four_dirs.push_back(lines4[i].dir);
-        }
-
-        for (int d3 : three_dirs)
-            for (int d4 : four_dirs)
-                if (d3 != d4) return true;
-
-        return false;
+        return symbol_has_win(p->get_symbol());
     }
 
     /**
@@ -185,7 +271,7 @@ public:
      * to ensure the draw is legitimate.
      */
     virtual bool is_draw(Player<T>*) override {
-        if (this->n_moves < valid_cell_count) return false;
+        if (this->n_moves < this->PLAYABLE_CELLS) return false;
         if (symbol_has_win(static_cast<T>('X'))) return false;
         if (symbol_has_win(static_cast<T>('O'))) return false;
         return true;
@@ -209,144 +295,72 @@ public:
         return is_win(p) || is_lose(p) || is_draw(p);
     }
 
-private:
     /**
-     * @struct LineInfo
-     * @brief Structure to store information about a potential winning line
+     * @brief Lists every empty cell inside the diamond
      *
-     * @details
-     * Contains:
-     * - coords: Vector of (row, col) pairs representing cells in the line
-     * - dir: Direction identifier (0=horizontal, 1=vertical, 2=main diagonal, 3=anti diagonal)
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
      */
-     // Direction identifiers
-     // 0 = horizontal, 1 = vertical, 2 = main diagonal (TL-BR), 3 = anti diagonal (TR-BL)
-    struct LineInfo { std::vector<std::pair<int, int>> coords; int dir; };
-
-    T empty_marker;                    ///< Symbol representing empty cells
-    int valid_cell_count;              ///< Total number of valid cells in diamond (13)
-    std::vector<LineInfo> lines3;      ///< Precomputed list of all valid 3-length lines
-    std::vector<LineInfo> lines4;      ///< Precomputed list of all valid 4-length lines
+    virtual void generate_moves(T symbol, MoveList<T>& moves) override {
+        this->generate_placements(empty_marker, symbol, moves);
+    }
 
     /**
-     * @brief Checks if a cell position is valid within the diamond shape
-     *
-     * @param r Row index (0-4)
-     * @param c Column index (0-4)
-     * @return true if cell is within the diamond; false otherwise
-     *
-     * @details
-     * Uses Manhattan distance from center (2,2):
-     * Valid if |row - 2| + |col - 2| <= 2
-     *
-     * This creates a diamond pattern with 13 valid cells.
+     * @brief Exact key: a base-3 digit for each of the 13 diamond cells
      */
-    bool is_valid_cell(int r, int c) const {
-        // Diamond condition centered at (2,2) with radius 2
-        return (std::abs(r - 2) + std::abs(c - 2)) <= 2;
+    uint64_t position_key() const override {
+        return this->shape_key(empty_marker, static_cast<T>('X'));
     }
 
     /**
-     * @brief Precomputes all possible winning lines of length 3 and 4
-     *
-     * @details
-     * Scans the entire grid in four directions (horizontal, vertical,
-     * main diagonal, anti diagonal) to find all valid consecutive lines
-     * that:
-     * - Consist only of valid diamond cells
-     * - Are exactly 3 or 4 cells long
+     * @brief Heuristic score of the position for a player
      *
-     * Results are stored in lines3 and lines4 vectors.
-     * Duplicates are removed to optimize win-checking performance.
+     * @param symbol The player the score is for
+     * @return Sum over the lines the opponent has not entered of the square
+     *         of the player's stones in them, minus the same for the opponent
      *
-     * @note Called once during construction
-     * @see deduplicate_lines()
+     * Longer lines hold more stones, so a nearly full 4-line weighs more
+     * than a 3-line; both are needed to win.
      */
-    void precompute_lines() {
-        // directions as (dr, dc) with dir id
-        const std::vector<std::pair<int, int>> dirs = {
-            {0, 1},  // horizontal -> dir 0
-            {1, 0},  // vertical   -> dir 1
-            {1, 1},  // main diag  -> dir 2
-            {1, -1}  // anti diag  -> dir 3
-        };
-
-        for (int r = 0; r < this->rows; ++r) {
-            for (int c = 0; c < this->columns; ++c) {
-                if (!is_valid_cell(r, c)) continue;
-                for (int d = 0; d < (int)dirs.size(); ++d) {
-                    std::vector<std::pair<int, int>> coords3;
-                    bool ok3 = true;
-                    for (int k = 0; k < 3; ++k) {
-                        int rr = r + k * dirs[d].first;
-                        int cc = c + k * dirs[d].second;
-                        if (rr < 0 || rr >= this->rows || cc < 0 || cc >= this->columns || !is_valid_cell(rr, cc)) {
-                            ok3 = false;
-                            break;
-                        }
-                        coords3.emplace_back(rr, cc);
-                    }
-                    if (ok3) lines3.push_back({ coords3, d });
-
-                    std::vector<std::pair<int, int>> coords4;
-                    bool ok4 = true;
-                    for (int k = 0; k < 4; ++k) {
-                        int rr = r + k * dirs[d].first;
-                        int cc = c + k * dirs[d].second;
-                        if (rr < 0 || rr >= this->rows || cc < 0 || cc >= this->columns || !is_valid_cell(rr, cc)) {
-                            ok4 = false;
-                            break;
-                        }
-                        coords4.emplace_back(rr, cc);
-                    }
-                    if (ok4) lines4.push_back({ coords4, d });
-                }
-            }
+    virtual int evaluate(T symbol) override {
+        int side = side_of(symbol);
+        if (side < 0) return 0;
+        int score = 0;
+        for (const diamond_lines::Line& line : diamond_lines::LINES) {
+            int own = popcount(unsigned(stones[side] & line.mask));
+            int opp = popcount(unsigned(stones[1 - side] & line.mask));
+            if (opp == 0) score += own * own;
+            if (own == 0) score -= opp * opp;
         }
-        deduplicate_lines(lines3);
-        deduplicate_lines(lines4);
+        return score;
     }
 
-    /**
-     * @brief Removes duplicate line entries from a vector
-     *
-     * @param lines Reference to vector of LineInfo structures to deduplicate
-     *
-     * @details
-     * Compares each line's coordinates and direction to find duplicates.
-     * Keeps only the first occurrence of each unique line.
-     * This optimization reduces redundant win-checking operations.
-     *
-     * @note Modifies the input vector in place
-     */
-    static void deduplicate_lines(std::vector<LineInfo>& lines) {
-        std::vector<LineInfo> out;
-        for (auto& li : lines) {
-            bool found = false;
-            for (auto& ex : out) {
-                if (ex.coords == li.coords && ex.dir == li.dir) { found = true; break; }
-            }
-            if (!found) out.push_back(li);
-        }
-        lines.swap(out);
+protected:
+    /** @brief Save the stone masks and full lines before make_move() applies a move. */
+    void save_state() override {
+        this->push_state(stones);
+        this->push_state(full);
+    }
+
+    /** @brief Restore the stone masks and full lines. */
+    void restore_state() override {
+        this->pop_state(full);
+        this->pop_state(stones);
     }
 
+private:
+    T empty_marker;                    ///< Symbol representing empty cells
+    uint16_t stones[2] = { 0, 0 };     ///< Cells of 'X' (index 0) and 'O' (index 1), as diamond_lines bits
+    uint8_t full[2] = { 0, 0 };        ///< Full lines of 'X' and 'O' (see diamond_lines::full_bit())
+
     /**
-     * @brief Checks if all cells in a line contain the specified symbol
-     *
-     * @param coords Vector of (row, col) coordinate pairs representing the line
-     * @param sym The symbol to check for
-     * @return true if all cells contain the symbol; false if any cell differs
-     *
-     * @details
-     * Helper method used by win-checking logic to verify if a line
-     * is completely filled with one player's symbol.
+     * @brief Index of a symbol in stones and full
+     * @return 0 for 'X', 1 for 'O', -1 for any other symbol
      */
-    bool line_all_symbol(const std::vector<std::pair<int, int>>& coords, T sym) const {
-        for (auto& p : coords) {
-            if (this->board[p.first][p.second] != sym) return false;
-        }
-        return true;
+    static int side_of(T sym) {
+        if (sym == static_cast<T>('X')) return 0;
+        if (sym == static_cast<T>('O')) return 1;
+        return -1;
     }
 
     /**
@@ -356,28 +370,25 @@ private:
      * @return true if symbol has both 3-line and 4-line in different directions; false otherwise
      *
      * @details
-     * Internal helper method that performs the same win-checking logic as is_win()
-     * but for an arbitrary symbol rather than a Player object.
-     *
-     * Used by is_draw() to verify neither player has won when checking for draw condition.
+     * 'X' and 'O' use the full lines kept by update_board(). Any other symbol
+     * has its stones collected into a mask and tested against every line.
      *
-     * @see is_win()
+     * Used by is_win() and by is_draw() to verify neither player has won.
      */
     bool symbol_has_win(T sym) const {
+        int side = side_of(sym);
+        if (side >= 0) return diamond_lines::wins(full[side]);
 
-        std::vector<int> three_dirs;
-        std::vector<int> four_dirs;
-
-        for (const auto& li : lines3) {
-            if (line_all_symbol(li.coords, sym)) three_dirs.push_back(li.dir);
-        }
-        for (const auto& li : lines4) {
-            if (line_all_symbol(li.coords, sym)) four_dirs.push_back(li.dir);
-        }
-        for (int d3 : three_dirs)
-            for (int d4 : four_dirs)
-                if (d3 != d4) return true;
-        return false;
+        uint16_t mask = 0;
+        int bit = 0;
+        this->for_each_cell([&](int r, int c) {
+            if (this->board[r][c] == sym) mask |= uint16_t(1u << bit);
+            ++bit;
+        });
+        uint8_t lines = 0;
+        for (const diamond_lines::Line& line : diamond_lines::LINES)
+            if ((mask & line.mask) == line.mask) lines |= diamond_lines::full_bit(line);
+        return diamond_lines::wins(lines);
     }
 };
 
@@ -18,6 +18,7 @@
 #define _DIAMOND_UI_H
 #include "BoardGame_Classes.h"
 #include "Diamond_TicTacToe.h"
+#include "AI_Player.h"
 #include <limits>
 #include <iostream>
 #include <iomanip>
@@ -59,10 +60,38 @@ public:
      */
     ~Diamond_UI() override {}
 
+    /**
+     * @brief Creates a player of the specified type
+     *
+     * @param name Name of the player
+     * @param symbol Symbol assigned to the player ('X' or 'O')
+     * @param type Type of the player
+     * @return Pointer to the newly created player
+     *
+     * AI players search the 13 cells with AI_Player under a time budget of
+     * one second a move; the search ends sooner once it has seen the whole game.
+     */
+    Player<char>* create_player(std::string& name, char symbol, PlayerType type) override {
+        if (type != PlayerType::AI)
+            return UI<char>::create_player(name, symbol, type);
+        std::cout << "Creating AI player: " << name << " (" << symbol << ")\n";
+        AI_Player<char, DiamondTicTacToe<char>>* ai =
+            new AI_Player<char, DiamondTicTacToe<char>>(name, symbol, symbol == 'X' ? 'O' : 'X', 13);
+        ai->set_think_ms(1000);
+        return ai;
+    }
+
+    /**
+     * @brief Offers Human, Computer and AI players
+     */
+    std::vector<std::string> player_type_options() const override {
+        return { "Human", "Computer", "AI" };
+    }
+
     /**
      * @brief Displays the game board in a diamond shape
      *
-     * @param matrix Constant reference to a 2D vector representing the board state
+     * @param matrix Read-only view of the board, with the diamond as its valid-cell mask
      *
      * @details
      * Renders the board with the following features:
@@ -72,8 +101,8 @@ public:
      * - Only valid cells (within diamond shape) are shown
      * - Invalid cells outside the diamond are rendered as spaces
      *
-     * The diamond pattern is created using the formula:
-     * `abs(center_r - r) + abs(center_c - c) <= center_r`
+     * The diamond pattern comes from the view's valid-cell mask, set by the
+     * board as `abs(center_r - r) + abs(center_c - c) <= center_r`
      *
      * Visual structure:
      * @code
@@ -89,12 +118,11 @@ public:
      * @note The indentation increases as you move away from center row
      * @note Empty check prevents crashes on uninitialized boards
      */
-    void display_board_matrix(const std::vector<std::vector<char>>& matrix) const override {
-        if (matrix.empty() || matrix[0].empty()) return;
-        int rows = static_cast<int>(matrix.size());
-        int cols = static_cast<int>(matrix[0].size());
+    void display_board_matrix(const BoardView<char>& matrix) const override {
+        if (matrix.get_rows() == 0 || matrix.get_columns() == 0) return;
+        int rows = matrix.get_rows();
+        int cols = matrix.get_columns();
         int center_r = rows / 2;
-        int center_c = cols / 2;
         std::cout << "\n    ";
         for (int c = 0; c < cols; ++c)
             std::cout << std::setw(cell_width + 1) << c;
@@ -105,9 +133,8 @@ public:
             for (int s = 0; s < rowIndent; ++s)
                 std::cout << std::setw(cell_width + 1) << ' ';
             for (int c = 0; c < cols; ++c) {
-                bool valid = (std::abs(center_r - r) + std::abs(center_c - c)) <= center_r;
-                if (valid)
-                    std::cout << std::setw(cell_width) << matrix[r][c] << ' ';
+                if (matrix.is_valid(r, c))
+                    std::cout << std::setw(cell_width) << matrix(r, c) << ' ';
                 else
                     std::cout << std::setw(cell_width) << ' ' << ' ';
             }
@@ -120,7 +147,7 @@ public:
      * @brief Prompts for and retrieves a player's move
      *
      * @param player Pointer to the Player object making the move
-     * @return Pointer to a Move object containing the selected row, column, and player symbol
+     * @return A Move containing the selected row, column, and player symbol
      *
      * @details
      * Prompts the player to enter row and column coordinates for their move.
@@ -139,13 +166,20 @@ public:
      * // Creates Move object with position (2,2) and symbol 'X'
      * @endcode
      *
+     * Computer players are handed to computer_move() and AI players search
+     * for their move instead.
+     *
      * @note The method loops indefinitely until valid integer input is received
-     * @warning Caller is responsible for deallocating the returned Move object
      * @warning Does not validate if move is legal (within diamond or cell empty)
      *
      * @see Board::update_board() for move legality validation
      */
-    Move<char>* get_move(Player<char>* player) override {
+    Move<char> next_move(Player<char>* player) override {
+        if (player->get_type() == PlayerType::COMPUTER)
+            return computer_move(player);
+        if (player->get_type() == PlayerType::AI)
+            return static_cast<Searcher<char>*>(player)->choose_move();
+
         int x = 0, y = 0;
         while (true) {
             std::cout << player->get_name() << " (" << player->get_symbol() << ") enter move (row col): ";
@@ -155,8 +189,18 @@ public:
                 std::cout << "Invalid input. Please enter two integers.\n";
                 continue;
             }
-            return new Move<char>(x, y, player->get_symbol());
+            return Move<char>(x, y, player->get_symbol());
         }
     }
+
+    /**
+     * @brief Picks a random empty cell of the diamond for a computer player
+     *
+     * @param player Pointer to the Player object making the move
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if there is none
+     */
+    static Move<char> computer_move(Player<char>* player) {
+        return random_move(player->get_board_ptr(), player->get_symbol());
+    }
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,329 @@
+/**
+ * @file FixedBoard.h
+ * @brief Board layer for grids whose size is known at compile time.
+ *
+ * A FixedBoard<T, R, C> is a Board<T> of R rows and C columns whose size is
+ * also a template argument. Cell (r, c) is at index r * C + c of the grid
+ * buffer with C a constant, and the straight lines of K cells (rows,
+ * columns and both diagonals) come from a table built at compile time.
+ * has_line() and any_line() expand that table into straight-line code, every
+ * cell index a constant, that stops at the first line found. A second table
+ * lists the lines through each cell, so a board can check just the lines a
+ * move touched (has_line_through(), any_line_through()).
+ *
+ * Boards whose playing area is not the whole rectangle (Pyramid, Diamond)
+ * derive from ShapedBoard instead. Its CellLayout numbers the playable
+ * cells densely at compile time, so moves, keys and bitboards cover those
+ * cells only while the grid, the view and the undo journal keep the
+ * rectangle.
+ *
+ * Concrete boards built on it are declared final: code that holds the
+ * concrete type (AI_Player<T, B>, SelfPlayRunner<T, B>, MCTS_Player,
+ * Perfect_Player, check_result()) then calls their methods directly, while
+ * the menu keeps using them through Board<T>*.
+ */
+
+#ifndef _FIXED_BOARD_H
+#define _FIXED_BOARD_H
+
+#include "BoardGame_Classes.h"
+#include <array>
+#include <utility>
+
+/**
+ * @brief Number of straight lines of k cells on an r x c grid.
+ */
+constexpr int fixed_line_count(int r, int c, int k) {
+    int across = c >= k ? r * (c - k + 1) : 0;
+    int down = r >= k ? c * (r - k + 1) : 0;
+    int diagonal = (r >= k && c >= k) ? 2 * (r - k + 1) * (c - k + 1) : 0;
+    return across + down + diagonal;
+}
+
+/**
+ * @brief Cell indices of every straight line of K cells on an R x C grid.
+ *
+ * Rows come first, then columns, then the down-right and the down-left
+ * diagonals; inside each group lines are ordered by their first cell.
+ */
+template <int R, int C, int K>
+constexpr array<array<uint8_t, K>, fixed_line_count(R, C, K)> make_fixed_lines() {
+    static_assert(R * C <= 256, "cell indices must fit in a byte");
+    array<array<uint8_t, K>, fixed_line_count(R, C, K)> lines{};
+    const int steps[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+    int n = 0;
+    for (const auto& step : steps)
+        for (int r = 0; r < R; ++r)
+            for (int c = 0; c < C; ++c) {
+                int last_r = r + (K - 1) * step[0], last_c = c + (K - 1) * step[1];
+                if (last_r >= R || last_c < 0 || last_c >= C) continue;
+                for (int i = 0; i < K; ++i)
+                    lines[n][i] = static_cast<uint8_t>((r + i * step[0]) * C + c + i * step[1]);
+                ++n;
+            }
+    return lines;
+}
+
+/**
+ * @brief Indices (into make_fixed_lines()) of the lines of K cells through one cell.
+ */
+template <int K>
+struct FixedCellLines {
+    uint8_t count = 0;           ///< Lines through the cell
+    array<uint8_t, 4 * K> line{}; ///< Their indices, in table order
+};
+
+/**
+ * @brief For every cell of an R x C grid, the lines of K cells through it.
+ */
+template <int R, int C, int K>
+constexpr array<FixedCellLines<K>, R * C> make_fixed_lines_through() {
+    static_assert(fixed_line_count(R, C, K) <= 256, "line indices must fit in a byte");
+    constexpr auto lines = make_fixed_lines<R, C, K>();
+    array<FixedCellLines<K>, R * C> through{};
+    for (int n = 0; n < static_cast<int>(lines.size()); ++n)
+        for (int i = 0; i < K; ++i) {
+            FixedCellLines<K>& cell = through[lines[n][i]];
+            cell.line[cell.count++] = static_cast<uint8_t>(n);
+        }
+    return through;
+}
+
+/**
+ * @brief Board of a compile-time R x C size with constexpr line tables.
+ *
+ * @tparam T Type of the elements stored on the board.
+ * @tparam R Number of rows.
+ * @tparam C Number of columns.
+ */
+template <typename T, int R, int C>
+class FixedBoard : public Board<T> {
+public:
+    static constexpr int ROWS = R;        ///< Number of rows
+    static constexpr int COLUMNS = C;     ///< Number of columns
+    static constexpr int CELLS = R * C;   ///< Number of cells
+
+    /** @brief Every straight line of K cells, as cell indices (see make_fixed_lines()). */
+    template <int K>
+    static constexpr auto lines = make_fixed_lines<R, C, K>();
+
+    /** @brief Lines of K cells through each cell index (see make_fixed_lines_through()). */
+    template <int K>
+    static constexpr auto lines_through = make_fixed_lines_through<R, C, K>();
+
+protected:
+    /** @brief Construct an R x C board of value-initialised cells. */
+    FixedBoard() : Board<T>(R, C) {}
+
+    /** @brief True if some line of K cells holds symbol in every cell. */
+    template <int K>
+    bool has_line(T symbol) const {
+        return any_line<K>([symbol](const array<T, K>& line) {
+            for (int i = 0; i < K; ++i)
+                if (line[i] != symbol) return false;
+            return true;
+        });
+    }
+
+    /**
+     * @brief True if matches(values) holds for some line of K cells.
+     * @param matches Called with the line's contents as an array<T, K>,
+     *        line after line until it returns true.
+     */
+    template <int K, typename F>
+    bool any_line(F matches) const {
+        return match_lines<K>(this->board.data(), matches, make_index_sequence<lines<K>.size()>());
+    }
+
+    /** @brief True if some line of K cells through cell index i holds symbol in every cell. */
+    template <int K>
+    bool has_line_through(int i, T symbol) const {
+        return any_line_through<K>(i, [symbol](const array<T, K>& line) {
+            for (int j = 0; j < K; ++j)
+                if (line[j] != symbol) return false;
+            return true;
+        });
+    }
+
+    /**
+     * @brief True if matches(values) holds for some line of K cells through cell index i.
+     *
+     * Only the lines through i are read (at most 4 * K), so a board can
+     * evaluate a move by looking at the cell it changed.
+     */
+    template <int K, typename F>
+    bool any_line_through(int i, F matches) const {
+        const T* cells = this->board.data();
+        const FixedCellLines<K>& through = lines_through<K>[i];
+        for (int n = 0; n < through.count; ++n) {
+            const auto& line = lines<K>[through.line[n]];
+            array<T, K> values;
+            for (int j = 0; j < K; ++j)
+                values[j] = cells[line[j]];
+            if (matches(values)) return true;
+        }
+        return false;
+    }
+
+    /** @brief True if no cell holds blank. */
+    bool is_full(T blank) const {
+        const T* cells = this->board.data();
+        for (int i = 0; i < CELLS; ++i)
+            if (cells[i] == blank) return false;
+        return true;
+    }
+
+private:
+    /** @brief matches() on each line L..., in order; one expansion per line. */
+    template <int K, typename F, size_t... L>
+    static bool match_lines(const T* cells, F& matches, index_sequence<L...>) {
+        return (match_line<K, L>(cells, matches, make_index_sequence<K>()) || ...);
+    }
+
+    /** @brief matches() on line L, its cells read at constant offsets. */
+    template <int K, size_t L, typename F, size_t... I>
+    static bool match_line(const T* cells, F& matches, index_sequence<I...>) {
+        return matches(array<T, K>{ cells[lines<K>[L][I]]... });
+    }
+};
+
+/**
+ * @brief Number of cells of an R x C grid for which Shape::playable(r, c) holds.
+ */
+template <int R, int C, typename Shape>
+constexpr int shape_cell_count() {
+    int n = 0;
+    for (int r = 0; r < R; ++r)
+        for (int c = 0; c < C; ++c)
+            if (Shape::playable(r, c)) ++n;
+    return n;
+}
+
+/**
+ * @brief Dense number of every grid cell r * C + c: its rank among the playable cells, or -1.
+ */
+template <int R, int C, typename Shape>
+constexpr array<int16_t, R * C> make_shape_index() {
+    array<int16_t, R * C> index{};
+    int16_t next = 0;
+    for (int i = 0; i < R * C; ++i)
+        index[i] = Shape::playable(i / C, i % C) ? next++ : -1;
+    return index;
+}
+
+/**
+ * @brief Grid index r * C + c of every playable cell, by dense number.
+ */
+template <int R, int C, typename Shape>
+constexpr array<uint8_t, shape_cell_count<R, C, Shape>()> make_shape_grid() {
+    static_assert(R * C <= 256, "cell indices must fit in a byte");
+    array<uint8_t, shape_cell_count<R, C, Shape>()> grid{};
+    int n = 0;
+    for (int i = 0; i < R * C; ++i)
+        if (Shape::playable(i / C, i % C)) grid[n++] = static_cast<uint8_t>(i);
+    return grid;
+}
+
+/**
+ * @brief Dense numbering of the playable cells of an R x C grid.
+ *
+ * @tparam Shape Type with a `static constexpr bool playable(int r, int c)`.
+ *
+ * Playable cells are numbered 0 .. CELLS - 1 in row-major order. INDEX
+ * turns a grid index into that number and GRID turns it back; bit i of a
+ * bitboard is playable cell i.
+ */
+template <int R, int C, typename Shape>
+struct CellLayout {
+    static constexpr int CELLS = shape_cell_count<R, C, Shape>();                 ///< Playable cells
+    static constexpr array<int16_t, R * C> INDEX = make_shape_index<R, C, Shape>(); ///< Dense number of each grid cell, -1 if dead
+    static constexpr array<uint8_t, CELLS> GRID = make_shape_grid<R, C, Shape>();   ///< Grid index of each playable cell
+
+    /** @brief Dense number of (r, c), or -1 if it is off the grid or not playable. */
+    static constexpr int index_of(int r, int c) {
+        return r >= 0 && r < R && c >= 0 && c < C ? INDEX[r * C + c] : -1;
+    }
+
+    /** @brief Bitboard of grid cells given by their grid indices; all must be playable. */
+    template <typename... I>
+    static constexpr uint64_t mask_of(I... grid_cells) {
+        return ((uint64_t(1) << INDEX[grid_cells]) | ...);
+    }
+};
+
+/**
+ * @brief FixedBoard whose playing area is the cells of a compile-time shape.
+ *
+ * @tparam T Type of the elements stored on the board.
+ * @tparam R Number of rows of the enclosing grid.
+ * @tparam C Number of columns of the enclosing grid.
+ * @tparam Shape Type with a `static constexpr bool playable(int r, int c)`.
+ *
+ * The dead cells are marked unplayable in the Board (so is_playable() and
+ * view() know them), and the helpers below walk the Layout's playable
+ * cells instead of scanning the rectangle.
+ */
+template <typename T, int R, int C, typename Shape>
+class ShapedBoard : public FixedBoard<T, R, C> {
+public:
+    using Layout = CellLayout<R, C, Shape>;      ///< Dense numbering of the playable cells
+    static constexpr int PLAYABLE_CELLS = Layout::CELLS; ///< Number of playable cells
+
+    /** @brief Dense number of (r, c), or -1 outside the shape. */
+    static constexpr int cell_index(int r, int c) { return Layout::index_of(r, c); }
+
+protected:
+    /** @brief Construct the board with every cell outside the shape marked unplayable. */
+    ShapedBoard() {
+        for (int i = 0; i < R * C; ++i)
+            if (Layout::INDEX[i] < 0) this->mark_unplayable(i / C, i % C);
+    }
+
+    /**
+     * @brief Call f(r, c) for every playable cell, in dense order.
+     */
+    template <typename F>
+    void for_each_cell(F f) const {
+        for (uint8_t i : Layout::GRID)
+            f(i / C, i % C);
+    }
+
+    /**
+     * @brief List a placement of a symbol on every playable cell holding blank.
+     *
+     * Same moves and order as Board::generate_placements(), without
+     * visiting the dead cells.
+     */
+    void generate_placements(T blank, T symbol, MoveList<T>& moves) const {
+        moves.clear();
+        const T* cells = this->board.data();
+        for (uint8_t i : Layout::GRID)
+            if (cells[i] == blank)
+                moves.push(Move<T>(i / C, i % C, symbol));
+    }
+
+    /** @brief True if no playable cell holds blank. */
+    bool is_full(T blank) const {
+        const T* cells = this->board.data();
+        for (uint8_t i : Layout::GRID)
+            if (cells[i] == blank) return false;
+        return true;
+    }
+
+    /**
+     * @brief Exact base-3 key of the playable cells: blank is 0, first is 1, anything else 2.
+     *
+     * Dead cells take no digit, so shapes of up to 40 playable cells get
+     * distinct keys.
+     */
+    uint64_t shape_key(T blank, T first) const {
+        static_assert(Layout::CELLS <= 40, "a base-3 key holds at most 40 cells");
+        const T* cells = this->board.data();
+        uint64_t key = 0;
+        for (uint8_t i : Layout::GRID)
+            key = key * 3 + (cells[i] == blank ? 0 : cells[i] == first ? 1 : 2);
+        return key;
+    }
+};
+
+#endif // _FIXED_BOARD_H
@@ -0,0 +1,263 @@
+#include <cstring>
+#include <stdexcept>
+#include <filesystem>
+#include "GameRecord.h"
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace {
+    const char MAGIC[GameRecordFile::MAGIC_BYTES + 1] = "BGREC001";
+
+    /// Formats by menu number; a null name marks a variant that cannot be recorded
+    const RecordVariant VARIANTS[] = {
+        { nullptr, 0, 0, "" },
+        { "SUS Game", 3, 3, "" },
+        { "Connect 4", 6, 7, "" },
+        { "5x5 Tic-Tac-Toe", 5, 5, "" },
+        { "Word Tic-Tac-Toe", 3, 3, "ABCDEFGHIJKLMNOPQRSTUVWXYZ" },
+        { "Inverse Tic-Tac-Toe", 3, 3, "" },
+        { "Diamond Tic-Tac-Toe", 5, 5, "" },
+        { "Tic_Tac_Toe_4X4", 4, 4, "", true },
+        { "Pyramid Tic_Tac_Toe", 3, 5, "" },
+        { "NUMERICAL Tic_Tac_Toe", 3, 3, "123456789" },
+        { "Obstacles Tic-Tac-Toe", 6, 6, "" },
+        { "Infinity Tic-Tac-Toe", 3, 3, "" },
+        { "Ultimate Tic-Tac-Toe", 9, 9, "" },
+        { "Memory Tic-Tac-Toe", 3, 3, "" },
+    };
+    const int VARIANT_COUNT = sizeof(VARIANTS) / sizeof(VARIANTS[0]);
+
+    /// Steps of a sliding move by direction code: down, up, right, left
+    const int STEP_X[4] = { 1, -1, 0, 0 };
+    const int STEP_Y[4] = { 0, 0, 1, -1 };
+
+    uint64_t read_le(const uint8_t* p, int bytes) {
+        uint64_t value = 0;
+        for (int i = bytes - 1; i >= 0; --i)
+            value = (value << 8) | p[i];
+        return value;
+    }
+
+    void write_le(vector<uint8_t>& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i)
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    /**
+     * Bytes of a record file up to the end of its last complete game; 0 for
+     * a missing or empty file, or one whose magic was cut short.
+     * Throws if the file is not a record file.
+     */
+    size_t complete_bytes(const string& path) {
+        if (!filesystem::exists(path)) return 0;
+        FILE* in = fopen(path.c_str(), "rb");
+        if (!in)
+            throw runtime_error("cannot open game record file " + path);
+        char magic[GameRecordFile::MAGIC_BYTES] = {};
+        size_t n = fread(magic, 1, sizeof magic, in);
+        fclose(in);
+        if (n < sizeof magic && memcmp(magic, MAGIC, n) == 0) return 0;
+
+        GameRecordFile records(path);
+        size_t end = GameRecordFile::MAGIC_BYTES;
+        for (const RecordedGame& game : records)
+            end += GameRecord::HEADER_BYTES + game.plies;
+        return end;
+    }
+}
+
+//--------------------------------------- RecordVariant
+
+int RecordVariant::encode(int x, int y, char symbol, char mover, int from_x, int from_y) const {
+    if (x < 0 || x >= rows || y < 0 || y >= columns) return -1;
+    if (slides != (from_x >= 0)) return -1;
+    if (slides) {
+        if (from_x >= rows || from_y < 0 || from_y >= columns || symbol != mover) return -1;
+        for (int d = 0; d < 4; ++d)
+            if (x - from_x == STEP_X[d] && y - from_y == STEP_Y[d])
+                return (from_x * columns + from_y) * 4 + d;
+        return -1;
+    }
+    int cell = x * columns + y;
+    if (alphabet[0] == '\0')
+        return symbol == mover ? cell : -1;
+    const char* at = symbol ? strchr(alphabet, symbol) : nullptr;
+    return at ? static_cast<int>(at - alphabet) * cells() + cell : -1;
+}
+
+bool RecordVariant::decode(uint8_t code, char mover, int& x, int& y, char& symbol, int& from_x, int& from_y) const {
+    from_x = from_y = -1;
+    if (slides) {
+        if (code >= cells() * 4) return false;
+        int from = code / 4, d = code % 4;
+        x = from / columns + STEP_X[d];
+        y = from % columns + STEP_Y[d];
+        if (x < 0 || x >= rows || y < 0 || y >= columns) return false;
+        from_x = from / columns;
+        from_y = from % columns;
+        symbol = mover;
+        return true;
+    }
+    int letters = alphabet[0] == '\0' ? 1 : static_cast<int>(strlen(alphabet));
+    if (code >= letters * cells()) return false;
+    int cell = code % cells();
+    x = cell / columns;
+    y = cell % columns;
+    symbol = alphabet[0] == '\0' ? mover : alphabet[code / cells()];
+    return true;
+}
+
+const RecordVariant* record_variant(int id) {
+    if (id < 0 || id >= VARIANT_COUNT || !VARIANTS[id].name) return nullptr;
+    return &VARIANTS[id];
+}
+
+//--------------------------------------- GameRecord
+
+bool GameRecord::start(int variant_id, uint64_t board_seed, char first, char second) {
+    variant = variant_id;
+    format = record_variant(variant_id);
+    seed = board_seed;
+    result = 0;
+    symbols[0] = first;
+    symbols[1] = second;
+    moves.clear();
+    valid = format != nullptr;
+    return valid;
+}
+
+void GameRecord::add(int x, int y, char symbol, int from_x, int from_y) {
+    if (!valid) return;
+    int code = moves.size() < 0xFFFF ? format->encode(x, y, symbol, symbols[moves.size() % 2], from_x, from_y) : -1;
+    if (code < 0) valid = false;
+    else moves.push_back(static_cast<uint8_t>(code));
+}
+
+//--------------------------------------- GameRecordWriter
+
+GameRecordWriter::GameRecordWriter(const string& path) {
+    size_t keep = complete_bytes(path);
+    if (keep > 0 && filesystem::file_size(path) > keep)
+        filesystem::resize_file(path, keep); // drop the game cut short at the end
+    file = fopen(path.c_str(), keep > 0 ? "ab" : "wb");
+    if (!file)
+        throw runtime_error("cannot open game record file " + path);
+    if (keep == 0) {
+        // On disk at once, so a process killed before its first game leaves a valid file
+        fwrite(MAGIC, 1, GameRecordFile::MAGIC_BYTES, file);
+        fflush(file);
+    }
+}
+
+GameRecordWriter::~GameRecordWriter() {
+    flush();
+    fclose(file);
+}
+
+bool GameRecordWriter::write(const GameRecord& game) {
+    if (!game.valid) return false;
+    lock_guard<mutex> guard(lock);
+    write_le(buffer, game.seed, 8);
+    write_le(buffer, game.moves.size(), 2);
+    buffer.push_back(static_cast<uint8_t>(game.variant));
+    buffer.push_back(game.result);
+    buffer.push_back(static_cast<uint8_t>(game.symbols[0]));
+    buffer.push_back(static_cast<uint8_t>(game.symbols[1]));
+    buffer.insert(buffer.end(), game.moves.begin(), game.moves.end());
+    ++written;
+    if (buffer.size() >= (1 << 20)) flush_locked();
+    return true;
+}
+
+void GameRecordWriter::flush() {
+    lock_guard<mutex> guard(lock);
+    flush_locked();
+}
+
+void GameRecordWriter::flush_locked() {
+    if (!buffer.empty())
+        fwrite(buffer.data(), 1, buffer.size(), file);
+    buffer.clear();
+    fflush(file);
+}
+
+long long GameRecordWriter::games() const {
+    lock_guard<mutex> guard(lock);
+    return written;
+}
+
+//--------------------------------------- RecordedGame
+
+bool RecordedGame::move(int i, int& x, int& y, char& symbol, int& from_x, int& from_y) const {
+    if (i < 0 || i >= plies) return false;
+    const RecordVariant* format = record_variant(variant);
+    return format && format->decode(moves[i], symbols[i % 2], x, y, symbol, from_x, from_y);
+}
+
+//--------------------------------------- GameRecordFile
+
+GameRecordFile::GameRecordFile(const string& path) {
+#ifdef _WIN32
+    ifstream in(path, ios::binary);
+    if (!in)
+        throw runtime_error("cannot open game record file " + path);
+    copy.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    data = copy.data();
+    bytes = copy.size();
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("cannot open game record file " + path);
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size >= MAGIC_BYTES) {
+        void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            data = static_cast<const uint8_t*>(mapped);
+            bytes = info.st_size;
+            madvise(mapped, bytes, MADV_SEQUENTIAL);
+        }
+    }
+    close(fd);
+#endif
+    if (bytes < MAGIC_BYTES || memcmp(data, MAGIC, MAGIC_BYTES) != 0) {
+        release();
+        throw runtime_error(path + " is not a game record file");
+    }
+}
+
+GameRecordFile::~GameRecordFile() {
+    release();
+}
+
+void GameRecordFile::release() {
+#ifndef _WIN32
+    if (data) munmap(const_cast<uint8_t*>(data), bytes);
+#endif
+    data = nullptr;
+    bytes = 0;
+}
+
+void GameRecordFile::iterator::parse(const uint8_t* p) {
+    at = end;
+    if (end - p < GameRecord::HEADER_BYTES) return;
+    int plies = static_cast<int>(read_le(p + 8, 2));
+    if (end - p < GameRecord::HEADER_BYTES + plies) return; // cut short
+    at = p;
+    game.seed = read_le(p, 8);
+    game.plies = plies;
+    game.variant = p[10];
+    game.result = p[11];
+    game.symbols[0] = static_cast<char>(p[12]);
+    game.symbols[1] = static_cast<char>(p[13]);
+    game.moves = p + GameRecord::HEADER_BYTES;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file GameRecord.h
+ * @brief Compact binary game records: an append-only writer and a memory-mapped reader.
+ *
+ * A record file is the 8-byte magic "BGREC001" followed by games, back to
+ * back. Each game is a 14-byte header and then one byte per accepted move:
+ *
+ * | bytes | content                                                      |
+ * |-------|--------------------------------------------------------------|
+ * | 0-7   | seed of the board's own randomness (Board::get_seed()), LE   |
+ * | 8-9   | number of moves, LE                                          |
+ * | 10    | variant: its number in the hub menu (record_variant())       |
+ * | 11    | GameResult of the first player (ONGOING if aborted)          |
+ * | 12-13 | symbols of the first and the second player                   |
+ *
+ * A move byte is code * cells + cell, where cell is row * columns + column
+ * and code is the position of the move's symbol in the variant's alphabet
+ * (a digit or a letter), or 0 for variants whose moves carry the mover's
+ * own symbol. In variants whose moves slide a stone to a neighbouring cell
+ * (Tic_Tac_Toe_4X4) the byte is from * 4 + direction instead, from being
+ * the cell the stone leaves and direction its step: down, up, right, left.
+ * A game is written in one piece, so a file cut short by a crash loses at
+ * most its last game, which the reader skips.
+ */
+
+#ifndef _GAME_RECORD_H
+#define _GAME_RECORD_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <mutex>
+using namespace std;
+
+/**
+ * @brief Board size and move alphabet of one variant, for packing its moves.
+ */
+struct RecordVariant {
+    const char* name;     ///< Name shown in the hub menu
+    int rows;             ///< Board rows
+    int columns;          ///< Board columns
+    const char* alphabet; ///< Symbols a move may carry, or "" when it carries the mover's symbol
+    bool slides = false;  ///< Moves take the mover's stone one step from another cell
+
+    /** @brief Cells of the board. */
+    int cells() const { return rows * columns; }
+
+    /**
+     * @brief Pack a move into its byte.
+     * @param mover Symbol of the player who made it
+     * @param from_x, from_y Cell the stone leaves, or -1 for a placement
+     * @return The byte, or -1 if the move cannot be recorded in this variant
+     */
+    int encode(int x, int y, char symbol, char mover, int from_x = -1, int from_y = -1) const;
+
+    /**
+     * @brief Unpack a move byte.
+     * @param mover Symbol of the player who made it
+     * @param from_x, from_y Set to the cell the stone leaves, or to -1 for a placement
+     * @return false if the byte does not name a move of this variant
+     */
+    bool decode(uint8_t code, char mover, int& x, int& y, char& symbol, int& from_x, int& from_y) const;
+};
+
+/**
+ * @brief Move format of a hub variant.
+ * @param id Number of the game in the hub menu (1-13)
+ * @return The format, or nullptr if the variant cannot be recorded
+ */
+const RecordVariant* record_variant(int id);
+
+/**
+ * @brief One game being recorded, in its packed form.
+ */
+struct GameRecord {
+    static const int HEADER_BYTES = 14; ///< Size of a game's header in a file
+
+    int variant = 0;                       ///< Menu number of the variant
+    const RecordVariant* format = nullptr; ///< record_variant(variant)
+    uint64_t seed = 0;                     ///< Seed of the board's own randomness
+    uint8_t result = 0;                    ///< GameResult of the first player
+    char symbols[2] = { 0, 0 };            ///< Symbols of the first and the second player
+    vector<uint8_t> moves;                 ///< One byte per accepted move
+    bool valid = false;                    ///< False if recording is off or a move could not be packed
+
+    /**
+     * @brief Start recording a new game.
+     * @return false if the variant cannot be recorded; add() then does nothing.
+     */
+    bool start(int variant_id, uint64_t board_seed, char first, char second);
+
+    /**
+     * @brief Append the next accepted move; the mover is implied by the move number.
+     * @param from_x, from_y Cell a sliding move leaves, or -1 for a placement
+     */
+    void add(int x, int y, char symbol, int from_x = -1, int from_y = -1);
+};
+
+/**
+ * @brief Appends games to a record file; safe to share between threads.
+ *
+ * Games are gathered in a buffer and written in large blocks, each game
+ * whole. The destructor writes what is left.
+ */
+class GameRecordWriter {
+public:
+    /**
+     * @brief Open a record file for appending, writing the magic if it is new.
+     *
+     * A file left by a writer that was killed may end in a game cut short;
+     * it is truncated after its last complete game, so the games appended
+     * next are read back in step.
+     * @throws runtime_error if the file cannot be opened or is not a record file
+     */
+    explicit GameRecordWriter(const string& path);
+
+    /** @brief Write the buffered games and close the file. */
+    ~GameRecordWriter();
+
+    GameRecordWriter(const GameRecordWriter&) = delete;
+    GameRecordWriter& operator=(const GameRecordWriter&) = delete;
+
+    /**
+     * @brief Append a finished game.
+     * @return false (nothing written) if the game is not valid
+     */
+    bool write(const GameRecord& game);
+
+    /** @brief Write the buffered games to the file now. */
+    void flush();
+
+    /** @brief Games appended by this writer. */
+    long long games() const;
+
+private:
+    mutable mutex lock;      ///< Guards everything below
+    FILE* file = nullptr;    ///< The record file
+    vector<uint8_t> buffer;  ///< Games not written yet
+    long long written = 0;   ///< Games appended
+
+    /** @brief flush() with the lock held. */
+    void flush_locked();
+};
+
+/**
+ * @brief A game inside a mapped record file; its moves point into the mapping.
+ */
+struct RecordedGame {
+    int variant = 0;                ///< Menu number of the variant
+    uint64_t seed = 0;              ///< Seed of the board's own randomness
+    uint8_t result = 0;             ///< GameResult of the first player
+    char symbols[2] = { 0, 0 };     ///< Symbols of the first and the second player
+    int plies = 0;                  ///< Number of moves
+    const uint8_t* moves = nullptr; ///< Packed moves, plies bytes
+
+    /**
+     * @brief Move i, unpacked.
+     * @param from_x, from_y Set to the cell a sliding move leaves, or to -1 for a placement
+     * @return false if i is not below plies, or the variant or the byte is not valid
+     */
+    bool move(int i, int& x, int& y, char& symbol, int& from_x, int& from_y) const;
+};
+
+/**
+ * @brief Read-only view of a record file, memory-mapped.
+ *
+ * Iterating yields RecordedGame values that point into the mapping, so no
+ * move is copied. The file must not be truncated while it is mapped.
+ */
+class GameRecordFile {
+public:
+    /**
+     * @brief Map a record file.
+     * @throws runtime_error if the file cannot be mapped or is not a record file
+     */
+    explicit GameRecordFile(const string& path);
+
+    /** @brief Unmap the file. */
+    ~GameRecordFile();
+
+    GameRecordFile(const GameRecordFile&) = delete;
+    GameRecordFile& operator=(const GameRecordFile&) = delete;
+
+    /** @brief Forward iterator over the complete games of the file. */
+    class iterator {
+    public:
+        const RecordedGame& operator*() const { return game; }
+        const RecordedGame* operator->() const { return &game; }
+        iterator& operator++() { parse(at + GameRecord::HEADER_BYTES + game.plies); return *this; }
+        bool operator==(const iterator& other) const { return at == other.at; }
+        bool operator!=(const iterator& other) const { return at != other.at; }
+
+    private:
+        friend class GameRecordFile;
+        const uint8_t* at;   ///< Header of the current game, or end
+        const uint8_t* end;  ///< End of the mapping
+        RecordedGame game;   ///< The current game
+
+        iterator(const uint8_t* at, const uint8_t* end) : end(end) { parse(at); }
+
+        /** @brief Move to the game at p, or to end if none is complete there. */
+        void parse(const uint8_t* p);
+    };
+
+    /** @brief First game. */
+    iterator begin() const { return iterator(data + MAGIC_BYTES, data + bytes); }
+
+    /** @brief Past the last complete game. */
+    iterator end() const { return iterator(data + bytes, data + bytes); }
+
+    /** @brief Size of the file in bytes. */
+    size_t size() const { return bytes; }
+
+    static const int MAGIC_BYTES = 8; ///< Size of the file magic
+
+private:
+    const uint8_t* data = nullptr; ///< The mapping
+    size_t bytes = 0;              ///< Its size
+    vector<uint8_t> copy;          ///< File contents where mapping is not available
+
+    /** @brief Unmap the file, if it is mapped. */
+    void release();
+};
+
+#endif // _GAME_RECORD_H
@@ -0,0 +1,86 @@
+#include <sstream>
+#include "GameStats.h"
+
+using namespace std;
+
+long long Histogram::percentile(double q) const {
+    long long n = count();
+    if (n == 0) return 0;
+    long long rank = static_cast<long long>(q * (n - 1)) + 1;
+    long long seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += buckets[b].load(memory_order_relaxed);
+        if (seen >= rank) return b == 0 ? 0 : (b >= 63 ? LLONG_MAX : (1LL << b));
+    }
+    return max();
+}
+
+void Histogram::reset() {
+    for (auto& b : buckets) b.store(0, memory_order_relaxed);
+    samples.store(0, memory_order_relaxed);
+    total.store(0, memory_order_relaxed);
+    lowest.store(LLONG_MAX, memory_order_relaxed);
+    highest.store(0, memory_order_relaxed);
+}
+
+string Histogram::to_json() const {
+    ostringstream out;
+    out << "{\"count\":" << count() << ",\"sum_ns\":" << sum()
+        << ",\"min_ns\":" << min() << ",\"max_ns\":" << max()
+        << ",\"mean_ns\":" << static_cast<long long>(mean())
+        << ",\"p50_ns\":" << percentile(0.5) << ",\"p99_ns\":" << percentile(0.99)
+        << ",\"buckets\":[";
+    bool first = true;
+    for (int b = 0; b < BUCKETS; ++b) {
+        long long n = buckets[b].load(memory_order_relaxed);
+        if (n == 0) continue;
+        out << (first ? "" : ",") << "[" << (b >= 63 ? LLONG_MAX : (1LL << b)) << "," << n << "]";
+        first = false;
+    }
+    out << "]}";
+    return out.str();
+}
+
+void GameStats::record_search(long long searched, long long probes, long long hits, int depth) {
+    searches.fetch_add(1, memory_order_relaxed);
+    nodes.fetch_add(searched, memory_order_relaxed);
+    tt_probes.fetch_add(probes, memory_order_relaxed);
+    tt_hits.fetch_add(hits, memory_order_relaxed);
+    depth_total.fetch_add(depth, memory_order_relaxed);
+    int deepest = max_depth.load(memory_order_relaxed);
+    while (depth > deepest && !max_depth.compare_exchange_weak(deepest, depth, memory_order_relaxed)) {}
+}
+
+double GameStats::tt_hit_rate() const {
+    long long probes = tt_probes.load(memory_order_relaxed);
+    return probes ? double(tt_hits.load(memory_order_relaxed)) / probes : 0;
+}
+
+void GameStats::reset() {
+    get_move.reset();
+    update_board.reset();
+    outcome.reset();
+    for (atomic<long long>* c : { &games, &turns, &rejected_moves, &searches, &nodes, &tt_probes, &tt_hits, &depth_total })
+        c->store(0, memory_order_relaxed);
+    max_depth.store(0, memory_order_relaxed);
+}
+
+string GameStats::to_json() const {
+    long long n = searches.load(memory_order_relaxed);
+    ostringstream out;
+    out << "{\"games\":" << games.load(memory_order_relaxed)
+        << ",\"turns\":" << turns.load(memory_order_relaxed)
+        << ",\"rejected_moves\":" << rejected_moves.load(memory_order_relaxed)
+        << ",\"get_move\":" << get_move.to_json()
+        << ",\"update_board\":" << update_board.to_json()
+        << ",\"outcome\":" << outcome.to_json()
+        << ",\"search\":{\"searches\":" << n
+        << ",\"nodes\":" << nodes.load(memory_order_relaxed)
+        << ",\"tt_probes\":" << tt_probes.load(memory_order_relaxed)
+        << ",\"tt_hits\":" << tt_hits.load(memory_order_relaxed)
+        << ",\"tt_hit_rate\":" << tt_hit_rate()
+        << ",\"max_depth\":" << max_depth.load(memory_order_relaxed)
+        << ",\"mean_depth\":" << (n ? double(depth_total.load(memory_order_relaxed)) / n : 0)
+        << "}}";
+    return out.str();
+}
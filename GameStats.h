@@ -0,0 +1,122 @@
+/**
+ * @file GameStats.h
+ * @brief Optional per-turn instrumentation of GameManager.
+ *
+ * A GameManager given a GameStats (set_stats()) times each turn, split into
+ * asking the player for a move, applying it and checking the outcome. It
+ * also counts rejected moves and collects the search counters of AI players.
+ * Without one the game loop does no timing at all.
+ *
+ * Counters and histograms are updated with relaxed atomics, so another thread
+ * may call to_json() at any time to scrape them while games run.
+ */
+
+#ifndef _GAME_STATS_H
+#define _GAME_STATS_H
+
+#include <atomic>
+#include <string>
+#include <climits>
+using namespace std;
+
+/**
+ * @brief Histogram of durations in nanoseconds, with power-of-two buckets.
+ *
+ * Bucket b holds samples in [2^(b-1), 2^b) ns (bucket 0 holds 0 ns), so
+ * 64 buckets cover any duration with a relative error under 2x.
+ */
+class Histogram {
+public:
+    static const int BUCKETS = 64; ///< Number of buckets
+
+    /** @brief Add one sample. */
+    void record(long long ns) {
+        if (ns < 0) ns = 0;
+        int bucket = 0;
+        for (unsigned long long v = ns; v; v >>= 1) ++bucket;
+        buckets[bucket].fetch_add(1, memory_order_relaxed);
+        samples.fetch_add(1, memory_order_relaxed);
+        total.fetch_add(ns, memory_order_relaxed);
+        long long low = lowest.load(memory_order_relaxed);
+        while (ns < low && !lowest.compare_exchange_weak(low, ns, memory_order_relaxed)) {}
+        long long high = highest.load(memory_order_relaxed);
+        while (ns > high && !highest.compare_exchange_weak(high, ns, memory_order_relaxed)) {}
+    }
+
+    /** @brief Number of samples. */
+    long long count() const { return samples.load(memory_order_relaxed); }
+
+    /** @brief Sum of all samples, in ns. */
+    long long sum() const { return total.load(memory_order_relaxed); }
+
+    /** @brief Smallest sample, or 0 if there is none. */
+    long long min() const { return count() ? lowest.load(memory_order_relaxed) : 0; }
+
+    /** @brief Largest sample. */
+    long long max() const { return highest.load(memory_order_relaxed); }
+
+    /** @brief Mean sample, or 0 if there is none. */
+    double mean() const { return count() ? double(sum()) / count() : 0; }
+
+    /**
+     * @brief Upper bound of the bucket holding a quantile.
+     * @param q Quantile in [0, 1], e.g. 0.99
+     */
+    long long percentile(double q) const;
+
+    /** @brief Forget every sample. */
+    void reset();
+
+    /** @brief Count, sum, min, max, mean, p50, p99 and the non-empty buckets as [upper_ns, count] pairs. */
+    string to_json() const;
+
+private:
+    atomic<long long> buckets[BUCKETS] = {}; ///< Samples per bucket
+    atomic<long long> samples{ 0 };          ///< Number of samples
+    atomic<long long> total{ 0 };            ///< Sum of samples
+    atomic<long long> lowest{ LLONG_MAX };   ///< Smallest sample
+    atomic<long long> highest{ 0 };          ///< Largest sample
+};
+
+/**
+ * @brief Counters and latency histograms of the turns played by GameManager.
+ *
+ * One GameStats can be shared by any number of games (and threads); it
+ * accumulates until reset().
+ */
+struct GameStats {
+    Histogram get_move;     ///< Time in UI::next_move (including any search or human thinking)
+    Histogram update_board; ///< Time in Board::update_board, rejected attempts included
+    Histogram outcome;      ///< Time in check_result after each accepted move
+
+    atomic<long long> games{ 0 };          ///< Games finished
+    atomic<long long> turns{ 0 };          ///< Moves accepted
+    atomic<long long> rejected_moves{ 0 }; ///< Moves the board rejected and asked for again
+
+    atomic<long long> searches{ 0 };    ///< Moves chosen by a search
+    atomic<long long> nodes{ 0 };       ///< Positions visited by those searches
+    atomic<long long> tt_probes{ 0 };   ///< Transposition table lookups
+    atomic<long long> tt_hits{ 0 };     ///< Lookups that found the position
+    atomic<long long> depth_total{ 0 }; ///< Sum of the depths reached
+    atomic<int> max_depth{ 0 };         ///< Deepest search
+
+    /**
+     * @brief Add the counters of one search.
+     * @param searched Positions visited
+     * @param probes Transposition table lookups (0 if the search has no table)
+     * @param hits Lookups that found the position
+     * @param depth Depth reached in plies (0 if not meaningful)
+     */
+    void record_search(long long searched, long long probes, long long hits, int depth);
+
+    /** @brief Fraction of table lookups that hit, or 0 before any lookup. */
+    double tt_hit_rate() const;
+
+    /** @brief Forget everything recorded. */
+    void reset();
+
+    /** @brief All counters and histograms as one JSON object. */
+    string to_json() const;
+};
+
+#endif // _GAME_STATS_H
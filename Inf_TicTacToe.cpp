@@ -7,7 +7,8 @@ using namespace std;
 
 //--------------------------------------- Inf_XO_Board Implementation
 
-Inf_XO_Board::Inf_XO_Board() : Board(3, 3) {
+Inf_XO_Board::Inf_XO_Board() {
+    set_symmetry(Symmetry::SQUARE);
     // Initialize all cells with blank_symbol
     for (auto& row : board)
         for (auto& cell : row)
@@ -19,25 +20,35 @@ bool Inf_XO_Board::update_board(Move<char>* move) {
     int y = move->get_y();
     char mark = move->get_symbol();
 
-    Coordinates.emplace_back(x, y);
-
     // Validate move and apply if valid
     if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
         (board[x][y] == blank_symbol || mark == 0)) {
 
         if (mark == 0) { // Undo move
             n_moves--;
-            board[x][y] = blank_symbol;
+            set_cell(x, y, blank_symbol);
+            remove_mark(x * columns + y);
+            winner = 0;
+            drawn = false;
         }
         else { // Apply move
             n_moves++;
-            board[x][y] = toupper(mark);
+            set_cell(x, y, toupper(mark));
+            marks |= uint64_t(x * columns + y + 1) << (4 * live);
+            ++live;
 
             // remove the very first play on the board after 3 moves
             if( n_moves >= 3 && !((n_moves)%3)) {
-                board[Coordinates[0].first][Coordinates[0].second] = blank_symbol;
-                Coordinates.pop_front();
+                int oldest = oldest_cell();
+                set_cell(oldest / columns, oldest % columns, blank_symbol);
+                marks >>= 4;
+                --live;
             }
+
+            // Only lines through the new mark can have been completed
+            char placed = toupper(mark);
+            winner = has_line_through<3>(x * columns + y, placed) ? placed : 0;
+            drawn = !winner && isFull();
         }
 
         return true;
@@ -45,46 +56,53 @@ bool Inf_XO_Board::update_board(Move<char>* move) {
     return false;
 }
 
-bool Inf_XO_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-        };
+void Inf_XO_Board::save_state() {
+    push_state(marks);
+    push_state(live);
+    push_state(winner);
+    push_state(drawn);
+}
 
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
-    }
+void Inf_XO_Board::restore_state() {
+    pop_state(drawn);
+    pop_state(winner);
+    pop_state(live);
+    pop_state(marks);
+}
 
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
+void Inf_XO_Board::remove_mark(int cell) {
+    for (int i = 0; i < live; ++i)
+        if (int((marks >> (4 * i)) & 15) == cell + 1) {
+            uint64_t below = marks & ((uint64_t(1) << (4 * i)) - 1);
+            marks = below | ((marks >> (4 * (i + 1))) << (4 * i));
+            --live;
+            return;
+        }
+}
 
-    return false;
+bool Inf_XO_Board::is_win(Player<char>* player) {
+    return winner != 0 && winner == player->get_symbol();
 }
 
 bool Inf_XO_Board::isFull() {
-    for (auto& row : board)
-        for (auto& cell : row) {
-            if(cell == blank_symbol) {
-                return false;
-            }
-        }
-    return true;
+    return is_full(blank_symbol);
 }
 
 bool Inf_XO_Board::is_draw(Player<char>* player) {
-    return (isFull() && !is_win(player));
+    return drawn;
 }
 
 bool Inf_XO_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+void Inf_XO_Board::generate_moves(char symbol, MoveList<char>& moves) {
+    generate_placements(blank_symbol, symbol, moves);
+}
+
+uint64_t Inf_XO_Board::position_key() const {
+    return (marks << 3) | uint64_t(n_moves % 6);
+}
 
 //--------------------------------------- Inf_XO_UI Implementation
 
@@ -92,13 +110,19 @@ Inf_XO_UI::Inf_XO_UI() : UI<char>("Weclome to Infinity Tic-Tac-Toe Game", 3) {}
 
 Player<char>* Inf_XO_UI::create_player(string& name, char symbol, PlayerType type) {
     // Create player based on type
-    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
+    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : type == PlayerType::AI ? "AI" : "computer")
         << " player: " << name << " (" << symbol << ")\n";
 
+    if (type == PlayerType::AI)
+        return new Perfect_Player<char, Inf_XO_Board>(name, symbol, 'X', 'O');
     return new Player<char>(name, symbol, type);
 }
 
-Move<char>* Inf_XO_UI::get_move(Player<char>* player) {
+vector<string> Inf_XO_UI::player_type_options() const {
+    return { "Human", "Computer", "AI" };
+}
+
+Move<char> Inf_XO_UI::next_move(Player<char>* player) {
     int x, y;
 
     if (player->get_type() == PlayerType::HUMAN) {
@@ -114,8 +138,14 @@ Move<char>* Inf_XO_UI::get_move(Player<char>* player) {
         }
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
+        return computer_move(player);
+    }
+    else if (player->get_type() == PlayerType::AI) {
+        return static_cast<Searcher<char>*>(player)->choose_move();
     }
-    return new Move<char>(x, y, player->get_symbol());
+    return Move<char>(x, y, player->get_symbol());
+}
+
+Move<char> Inf_XO_UI::computer_move(Player<char>* player) {
+    return random_move(player->get_board_ptr(), player->get_symbol());
 }
\ No newline at end of file
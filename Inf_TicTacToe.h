@@ -12,23 +12,44 @@
 
 
 #include "BoardGame_Classes.h"
-#include <deque>
+#include "FixedBoard.h"
+#include "Perfect_Player.h"
+#include <cstdint>
 using namespace std;
 
 /**
  * @class Inf_XO_Board
  * @brief Represents the Tic-Tac-Toe game board.
  *
- * This class inherits from the generic `Board<char>` class and implements
+ * This class inherits from `FixedBoard<char, 3, 3>` and implements
  * the specific logic required for the Tic-Tac-Toe (X-O) game, including
  * move updates, win/draw detection, and display functions.
  *
+ * Every third move takes the oldest mark off the board, so the order of the
+ * live marks is part of the position. It is kept as a ring packed into one
+ * integer: each live mark is its cell number + 1 in 4 bits, the oldest in
+ * the lowest bits, so the whole state is a fixed size and copies and undo
+ * frames cost a few words. Since a player only gains a mark on two moves
+ * out of three, the board fills up and the game ends within 13 moves.
+ *
  * @see Board
  */
-class Inf_XO_Board : public Board<char> {
+class Inf_XO_Board final : public FixedBoard<char, 3, 3> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
-    deque<pair<int, int>> Coordinates;
+    uint64_t marks = 0;      ///< Live marks, oldest in the low 4 bits, each its cell number + 1
+    int live = 0;            ///< Number of live marks (at most 9)
+    char winner = 0;         ///< Symbol whose last move completed a line, or 0
+    bool drawn = false;      ///< True if the last move filled the board without a line
+
+    /** @brief Save the ring of marks and the cached outcome before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override;
+
+    /** @brief Take the mark on a cell out of the ring, keeping the order of the others. */
+    void remove_mark(int cell);
 public:
     /**
      * @brief Default constructor that initializes a 3x3 X-O board.
@@ -46,6 +67,8 @@ public:
      * @brief Checks if the given player has won the game.
      * @param player Pointer to the player being checked.
      * @return true if the player has a winning line, false otherwise.
+     *
+     * Reads the outcome update_board() found on the lines through the last move.
      */
     bool is_win(Player<char>* player);
 
@@ -60,6 +83,8 @@ public:
      * @brief Checks if the game has ended in a draw.
      * @param player Pointer to the player being checked.
      * @return true if all cells are filled and no player has won, false otherwise.
+     *
+     * Reads the outcome cached by update_board().
      */
     bool is_draw(Player<char>* player);
 
@@ -70,6 +95,30 @@ public:
      */
     bool game_is_over(Player<char>* player);
 
+
+    /**
+     * @brief Lists every empty cell.
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
+     */
+    void generate_moves(char symbol, MoveList<char>& moves);
+
+    /**
+     * @brief Exact key: the ring of live marks and the move count modulo 6.
+     *
+     * Which mark disappears next depends on the order the marks were
+     * placed, so the cells alone do not identify a position. The count
+     * modulo 6 gives the side to move and the moves left before the next
+     * removal, and with them the owner of every mark; it takes the low 3
+     * bits, the ring the 36 above.
+     */
+    uint64_t position_key() const override;
+
+    /** @brief Number of marks on the board. */
+    int live_marks() const { return live; }
+
+    /** @brief Cell (row * 3 + column) of the mark removed next, or -1 if there is none. */
+    int oldest_cell() const { return live ? int(marks & 15) - 1 : -1; }
     /**
      * @brief Checks if all cells on the board are filled.
      * @return true if no blank cells remain, false otherwise
@@ -104,17 +153,29 @@ public:
      * @brief Creates a player of the specified type.
      * @param name Name of the player.
      * @param symbol Character symbol ('X' or 'O') assigned to the player.
-     * @param type The type of the player (Human or Computer).
+     * @param type The type of the player (Human, Computer or AI).
      * @return Pointer to the newly created Player<char> instance.
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type);
 
+    /**
+     * @brief Offers Human, Computer and AI (perfect play) players
+     */
+    vector<string> player_type_options() const override;
+
     /**
      * @brief Retrieves the next move from a player.
      * @param player Pointer to the player whose move is being requested.
-     * @return A pointer to a new `Move<char>` object representing the player's action.
+     * @return A `Move<char>` representing the player's action.
+     */
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Picks a random legal move for a computer player.
+     * @param player Pointer to the player whose move is being requested
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if there is none
      */
-    virtual Move<char>* get_move(Player<char>* player);
+    static Move<char> computer_move(Player<char>* player);
 };
 
 #endif // XO_CLASSES_H
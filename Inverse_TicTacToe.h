@@ -20,6 +20,7 @@
 #ifndef _INVERSE_TICTACTOE_H
 #define _INVERSE_TICTACTOE_H
 #include "BoardGame_Classes.h"
+#include "FixedBoard.h"
 
  /**
   * @class InverseTicTacToe
@@ -50,7 +51,7 @@
   * - Optimal play often differs significantly from standard Tic-Tac-Toe strategy
   */
 template <typename T>
-class InverseTicTacToe : public Board<T> {
+class InverseTicTacToe final : public FixedBoard<T, 3, 3> {
 public:
     /**
      * @brief Constructs a new Inverse Tic-Tac-Toe board
@@ -63,7 +64,8 @@ public:
      * but with inverted win/lose conditions.
      */
     InverseTicTacToe(T empty_cell = static_cast<T>(' '))
-        : Board<T>(3, 3), empty_marker(empty_cell) {
+        : empty_marker(empty_cell), three(empty_cell) {
+        this->set_symmetry(Symmetry::SQUARE);
         for (int r = 0; r < 3; ++r)
             for (int c = 0; c < 3; ++c)
                 this->board[r][c] = empty_marker;
@@ -88,9 +90,8 @@ public:
      * - Target cell is currently empty
      *
      * If valid, places the symbol at the position and increments the move counter.
-     *
-     * @note Does not check if the move causes the player to lose (three in a row)
-     * @warning Does not check for game-over conditions; use game_is_over() separately
+     * It then checks the lines through the new mark for three in a row and
+     * keeps the result, which is_win(), is_lose() and is_draw() read.
      */
     virtual bool update_board(Move<T>* move) override {
         int x = move->get_x();
@@ -98,8 +99,10 @@ public:
         T sym = move->get_symbol();
         if (x < 0 || x >= this->rows || y < 0 || y >= this->columns) return false;
         if (this->board[x][y] != empty_marker) return false;
-        this->board[x][y] = sym;
+        this->set_cell(x, y, sym);
         ++this->n_moves;
+        // Only lines through the new mark can have been completed
+        three = (sym != empty_marker && this->template has_line_through<3>(x * 3 + y, sym)) ? sym : empty_marker;
         return true;
     }
 
@@ -110,18 +113,14 @@ public:
      * @return true if the opponent has three in a row (player wins); false otherwise
      *
      * @details
-     * In Inverse Tic-Tac-Toe, you win when your OPPONENT completes three in a row.
-     * This method:
-     * 1. Determines the opponent's symbol
-     * 2. Checks if the opponent has three in a row
-     * 3. Returns true if opponent loses (meaning this player wins)
+     * In Inverse Tic-Tac-Toe, you win when your OPPONENT completes three in a row,
+     * i.e. when the last move made three in a row of a symbol other than yours.
      *
      * @note This is the inverse of standard Tic-Tac-Toe win logic
      * @see is_lose() for checking if the player has made three in a row (and lost)
      */
     virtual bool is_win(Player<T>* p) override {
-        T opp = get_opponent_symbol(p);
-        return symbol_has_three_in_row(opp);
+        return three != empty_marker && three != p->get_symbol();
     }
 
     /**
@@ -131,8 +130,7 @@ public:
      * @return true if the player has three in a row (player loses); false otherwise
      *
      * @details
-     * In Inverse Tic-Tac-Toe, you lose when YOU complete three in a row.
-     * This method checks if the player's symbol appears in any winning line:
+     * In Inverse Tic-Tac-Toe, you lose when YOU complete three in a row:
      * - Any row (3 horizontal lines)
      * - Any column (3 vertical lines)
      * - Main diagonal (top-left to bottom-right)
@@ -142,8 +140,7 @@ public:
      * @note Making three in a row is the losing condition in this variant
      */
     virtual bool is_lose(Player<T>* p) override {
-        T s = p->get_symbol();
-        return symbol_has_three_in_row(s);
+        return three != empty_marker && three == p->get_symbol();
     }
 
     /**
@@ -162,12 +159,10 @@ public:
      * draws in Inverse Tic-Tac-Toe require careful maneuvering to avoid
      * being forced into three in a row.
      *
-     * @note Explicitly checks that neither 'X' nor 'O' has three in a row
+     * @note The last move is the only one that can have made three in a row
      */
     virtual bool is_draw(Player<T>*) override {
-        if (symbol_has_three_in_row(static_cast<T>('X'))) return false;
-        if (symbol_has_three_in_row(static_cast<T>('O'))) return false;
-        return this->n_moves >= this->rows * this->columns;
+        return three == empty_marker && this->n_moves >= this->rows * this->columns;
     }
 
     /**
@@ -188,68 +183,32 @@ public:
         return is_win(p) || is_lose(p) || is_draw(p);
     }
 
-private:
-    T empty_marker;  ///< Symbol representing empty cells on the board
-
     /**
-     * @brief Checks if a specific symbol has three in a row
-     *
-     * @param sym The symbol to check for
-     * @return true if the symbol has three in a row in any direction; false otherwise
+     * @brief Lists every empty cell
      *
-     * @details
-     * Scans all possible winning lines for the specified symbol:
-     * - Three rows (horizontal lines)
-     * - Three columns (vertical lines)
-     * - Main diagonal (top-left to bottom-right)
-     * - Anti-diagonal (top-right to bottom-left)
-     *
-     * Returns false immediately if sym is the empty marker (can't have three in a row).
-     *
-     * @note This is a helper method used by both is_win() and is_lose()
-     * @note Used to check if a player has lost (their own symbol) or won (opponent's symbol)
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
      */
-    bool symbol_has_three_in_row(T sym) const {
-        if (sym == empty_marker) return false;
-        for (int r = 0; r < 3; ++r)
-            if (this->board[r][0] == sym && this->board[r][1] == sym && this->board[r][2] == sym)
-                return true;
-        for (int c = 0; c < 3; ++c)
-            if (this->board[0][c] == sym && this->board[1][c] == sym && this->board[2][c] == sym)
-                return true;
-        if (this->board[0][0] == sym && this->board[1][1] == sym && this->board[2][2] == sym) return true;
-        if (this->board[0][2] == sym && this->board[1][1] == sym && this->board[2][0] == sym) return true;
-        return false;
+    virtual void generate_moves(T symbol, MoveList<T>& moves) override {
+        this->generate_placements(empty_marker, symbol, moves);
     }
 
     /**
-     * @brief Determines the opponent's symbol
-     *
-     * @param p Pointer to the Player object whose opponent to find
-     * @return The opponent's symbol (type T)
-     *
-     * @details
-     * Attempts to find the opponent's symbol by:
-     * 1. Scanning the board for a symbol that is neither the player's symbol nor empty
-     * 2. If no opponent symbol found on board, assumes standard X/O setup:
-     *    - If player is 'X', opponent is 'O'
-     *    - Otherwise, opponent is 'X'
-     *
-     * This method is robust and works even early in the game when the opponent
-     * hasn't placed any pieces yet.
-     *
-     * @note Assumes a two-player game with symbols 'X' and 'O' as fallback
-     * @note Scans entire board, so has O(n²) complexity (9 cells for 3x3)
+     * @brief Exact base-3 key of the cells ('X' is 1, the other symbol 2)
      */
-    T get_opponent_symbol(Player<T>* p) const {
-        T s = p->get_symbol();
-        for (int r = 0; r < 3; ++r)
-            for (int c = 0; c < 3; ++c) {
-                T cand = this->board[r][c];
-                if (cand != s && cand != empty_marker) return cand;
-            }
-        if (s == static_cast<T>('X')) return static_cast<T>('O');
-        return static_cast<T>('X');
+    virtual uint64_t position_key() const override {
+        return this->base3_key(empty_marker, static_cast<T>('X'));
     }
+
+protected:
+    /** @brief Save the cached outcome before make_move() applies a move. */
+    void save_state() override { this->push_state(three); }
+
+    /** @brief Restore the cached outcome. */
+    void restore_state() override { this->pop_state(three); }
+
+private:
+    T empty_marker;  ///< Symbol representing empty cells on the board
+    T three;         ///< Symbol whose last move made three in a row, or empty_marker
 };
 #endif
\ No newline at end of file
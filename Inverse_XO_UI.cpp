@@ -9,12 +9,18 @@ using namespace std;
 Inverse_XO_UI::Inverse_XO_UI() : UI<char> ("Inverse (Misere) Tic-Tac-Toe: Avoid creating three-in-a-row, you lose if you do.", 3) {}
 
 Player<char>* Inverse_XO_UI::create_player(string& name, char symbol, PlayerType type) {
-    cout << "(Inverse) Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
+    cout << "(Inverse) Creating " << (type == PlayerType::HUMAN ? "human" : type == PlayerType::AI ? "AI" : "computer")
          << " player: " << name << " (" << symbol << ")\n";
+    if (type == PlayerType::AI)
+        return new Perfect_Player<char, InverseTicTacToe<char>>(name, symbol, 'X', 'O');
     return new Player<char>(name, symbol, type);
 }
 
-Move<char>* Inverse_XO_UI::get_move(Player<char>* player) {
+vector<string> Inverse_XO_UI::player_type_options() const {
+    return { "Human", "Computer", "AI" };
+}
+
+Move<char> Inverse_XO_UI::next_move(Player<char>* player) {
     Board<char>* board = player->get_board_ptr();
     int rows = board->get_rows();
     int cols = board->get_columns();
@@ -40,57 +46,82 @@ Move<char>* Inverse_XO_UI::get_move(Player<char>* player) {
                      << ") WILL create three-in-a-row and you will lose.\n";
                 cout << "Make this move anyway? (y/n): ";
                 char c; cin >> c;
-                if (c == 'y' || c == 'Y') return new Move<char>(x, y, player->get_symbol());
+                if (c == 'y' || c == 'Y') return Move<char>(x, y, player->get_symbol());
                 else { cout << "Choose a different move.\n"; continue; }
             }
-            return new Move<char>(x, y, player->get_symbol());
+            return Move<char>(x, y, player->get_symbol());
         }
     }
-    else { // COMPUTER: prefer safe moves when possible
-        vector<pair<int,int>> all_moves;
-        for (int i = 0; i < rows; ++i)
-            for (int j = 0; j < cols; ++j) {
-                char cur = board->get_cell(i, j);
-                if (cur == '.' || cur == static_cast<char>(' ')) all_moves.emplace_back(i, j);
-            }
+    if (player->get_type() == PlayerType::AI)
+        return static_cast<Searcher<char>*>(player)->choose_move();
+    return computer_move(player);
+}
+
+Move<char> Inverse_XO_UI::computer_move(Player<char>* player) {
+    Board<char>* board = player->get_board_ptr();
+    MoveList<char> all_moves;
+    board->generate_moves(player->get_symbol(), all_moves);
+
+    // prefer safe moves when possible
+    uint16_t losing = losing_cells(player);
+    MoveList<char> safe;
+    for (auto &m : all_moves)
+        if (!(losing >> (m.get_x() * 3 + m.get_y()) & 1)) safe.push(m);
+
+    if (!safe.empty())
+        return safe[thread_rng().below(static_cast<uint32_t>(safe.size()))];
+    return random_move(board, player->get_symbol());
+}
 
-        vector<pair<int,int>> safe;
+void Inverse_XO_UI::computer_moves(Player<char>* const* players, Rng* rngs, size_t n, Move<char>* moves) {
+    // Reused by the thread's calls so a step allocates nothing once warm
+    thread_local Batch3x3 batch;
+    thread_local vector<uint16_t> losing;
+    batch.clear();
+    for (size_t k = 0; k < n; ++k) {
+        uint16_t mine, taken;
+        board_masks(players[k], mine, taken);
+        batch.add(mine, taken);
+    }
+    losing.resize(n);
+    batch.completing_cells(losing.data());
+
+    for (size_t k = 0; k < n; ++k) {
+        char sym = players[k]->get_symbol();
+        MoveList<char> all_moves;
+        players[k]->get_board_ptr()->generate_moves(sym, all_moves);
+        MoveList<char> safe;
         for (auto &m : all_moves)
-            if (!would_lose_if_move(player, m.first, m.second)) safe.push_back(m);
+            if (!(losing[k] >> (m.get_x() * 3 + m.get_y()) & 1)) safe.push(m);
 
-        if (!safe.empty()) {
-            auto sel = safe[rand() % safe.size()];
-            return new Move<char>(sel.first, sel.second, player->get_symbol());
-        }
-        if (!all_moves.empty()) {
-            auto sel = all_moves[rand() % all_moves.size()];
-            return new Move<char>(sel.first, sel.second, player->get_symbol());
-        }
-        // fallback (shouldn't happen)
-        return new Move<char>(0, 0, player->get_symbol());
+        // the same draws as computer_move() and its random_move() fallback
+        if (!safe.empty())
+            moves[k] = safe[rngs[k].below(static_cast<uint32_t>(safe.size()))];
+        else if (!all_moves.empty())
+            moves[k] = all_moves[rngs[k].below(static_cast<uint32_t>(all_moves.size()))];
+        else
+            moves[k] = Move<char>(-1, -1, sym);
     }
 }
 
-bool Inverse_XO_UI::would_lose_if_move(Player<char>* player, int x, int y) const {
+uint16_t Inverse_XO_UI::losing_cells(Player<char>* player) {
+    uint16_t mine, taken;
+    board_masks(player, mine, taken);
+    return completing_cells_3x3(mine, taken);
+}
+
+void Inverse_XO_UI::board_masks(Player<char>* player, uint16_t& mine, uint16_t& taken) {
     Board<char>* board = player->get_board_ptr();
     char sym = player->get_symbol();
+    mine = 0;
+    taken = 0;
+    for (int i = 0; i < 9; ++i) {
+        char cell = board->get_cell(i / 3, i % 3);
+        if (cell == sym) mine |= uint16_t(1u << i);
+        else if (cell != '.' && cell != ' ') taken |= uint16_t(1u << i);
+    }
+}
 
-    // Helper returns the value of cell (r,c) assuming (x,y) would be sym
-    auto cell = [&](int r, int c)->char {
-        if (r == x && c == y) return sym;
-        return board->get_cell(r, c);
-    };
-
-    int N = board->get_rows(); // 3 expected
-    // rows
-    for (int r = 0; r < N; ++r)
-        if (cell(r, 0) == sym && cell(r, 1) == sym && cell(r, 2) == sym) return true;
-    // cols
-    for (int c = 0; c < N; ++c)
-        if (cell(0, c) == sym && cell(1, c) == sym && cell(2, c) == sym) return true;
-    // diags
-    if (cell(0, 0) == sym && cell(1, 1) == sym && cell(2, 2) == sym) return true;
-    if (cell(0, 2) == sym && cell(1, 1) == sym && cell(2, 0) == sym) return true;
-
-    return false;
+bool Inverse_XO_UI::would_lose_if_move(Player<char>* player, int x, int y) {
+    return x >= 0 && x < 3 && y >= 0 && y < 3 && (losing_cells(player) >> (x * 3 + y) & 1);
 }
\ No newline at end of file
@@ -17,6 +17,9 @@
 #ifndef _INVERSE_XO_UI_H
 #define _INVERSE_XO_UI_H
 #include "BoardGame_Classes.h"
+#include "Inverse_TicTacToe.h"
+#include "Perfect_Player.h"
+#include "Batch3x3.h"
  // #include "..\..\..\Downloads\BoardGameFramework-v2.3\Inverse_TicTacToe.h"
 #include <vector>
 
@@ -83,11 +86,16 @@ public:
      */
     Player<char>* create_player(std::string& name, char symbol, PlayerType type) override;
 
+    /**
+     * @brief Offers Human, Computer and AI (perfect play) players
+     */
+    std::vector<std::string> player_type_options() const override;
+
     /**
      * @brief Prompts for and retrieves a player's move
      *
      * @param player Pointer to the Player object making the move
-     * @return Pointer to a Move object containing the selected row, column, and player symbol
+     * @return A Move containing the selected row, column, and player symbol
      *
      * @details
      * For human players, prompts for row and column coordinates.
@@ -105,13 +113,56 @@ public:
      *
      * @note May provide additional feedback about dangerous moves in inverse variant
      * @note Re-prompts the user if invalid input is detected
-     * @warning Caller is responsible for deallocating the returned Move object
      *
      * @see would_lose_if_move() for checking if a move would cause immediate loss
      */
-    Move<char>* get_move(Player<char>* player) override;
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Picks a move for a computer player
+     *
+     * @param player Pointer to the Player object making the move
+     * @return A Move for a random empty cell
+     *
+     * @details
+     * Prefers empty cells that do not complete three in a row for the player
+     * (see losing_cells()) and falls back to any empty cell. Candidates
+     * come from the board's generate_moves().
+     */
+    static Move<char> computer_move(Player<char>* player);
+
+    /**
+     * @brief Picks the moves of computer players in many games at once
+     *
+     * @param players Player to move in each game
+     * @param rngs Generator of each game
+     * @param n Number of games
+     * @param moves Receives the move of each game
+     *
+     * The policy of computer_move(), with the losing cells of all n games
+     * found by one Batch3x3 pass; a SelfPlayRunner batch policy. Game k
+     * makes the same draws from rngs[k] as computer_move() would.
+     */
+    static void computer_moves(Player<char>* const* players, Rng* rngs, size_t n, Move<char>* moves);
+
+    /**
+     * @brief Every empty cell where the player would make three in a row and lose
+     *
+     * @param player Pointer to the player to move
+     * @return 9-bit mask, bit x * 3 + y for cell (x, y)
+     *
+     * The board is packed into two masks once and all cells are tested in
+     * one pass (completing_cells_3x3()); computer_moves() does the same for
+     * many games at once. Cells holding '.' or ' ' are empty.
+     */
+    static uint16_t losing_cells(Player<char>* player);
 
 private:
+    /**
+     * @brief Packs the player's board into masks of the player's cells and the taken ones
+     */
+    static void board_masks(Player<char>* player, uint16_t& mine, uint16_t& taken);
+
     /**
      * @brief Checks if a move would cause the player to lose immediately
      *
@@ -121,15 +172,9 @@ private:
      * @return true if placing the symbol at (x,y) would create three in a row (loss); false otherwise
      *
      * @details
-     * This helper method simulates placing the player's symbol at the specified
-     * position and checks if it would complete three in a row, which means losing
-     * in Inverse Tic-Tac-Toe.
-     *
-     * The method checks:
-     * - The row containing position (x,y)
-     * - The column containing position (x,y)
-     * - The main diagonal (if x,y is on it)
-     * - The anti-diagonal (if x,y is on it)
+     * This helper method checks if placing the player's symbol at the specified
+     * position would complete three in a row, which means losing in Inverse
+     * Tic-Tac-Toe. It reads the cell's bit of losing_cells().
      *
      * Use cases:
      * - Warning players before they make a losing move
@@ -149,6 +194,6 @@ private:
      * @endcode
      */
      // Return true if placing player's symbol at (x,y) would produce a 3-in-row for that player
-    bool would_lose_if_move(Player<char>* player, int x, int y) const;
+    static bool would_lose_if_move(Player<char>* player, int x, int y);
 };
 #endif // _INVERSE_XO_UI_H
\ No newline at end of file
@@ -0,0 +1,418 @@
+/**
+ * @file MCTS_Player.h
+ * @brief Monte Carlo Tree Search computer player (PlayerType::AI).
+ *
+ * MCTS_Player grows a UCT search tree by playing random games (playouts)
+ * from the current position. It needs no evaluation function, so it suits
+ * boards whose branching factor rules out AI_Player's alpha-beta search,
+ * such as Ultimate Tic-Tac-Toe.
+ *
+ * The search plays on copies of the board, so any copyable board that
+ * implements generate_moves() can be searched; no undo is needed. The work
+ * is spread over threads by root parallelization: every thread grows its own
+ * tree from the same position and the visit counts of the root moves are
+ * summed. Each thread keeps its tree between moves and carries on from the
+ * subtree of the position actually reached.
+ */
+
+#ifndef _MCTS_PLAYER_H
+#define _MCTS_PLAYER_H
+
+#include "BoardGame_Classes.h"
+#include "Searcher.h"
+#include <vector>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Counters of the last MCTS search, summed over its threads.
+ */
+struct MCTSStats {
+    long long playouts = 0;   ///< Random games played from the tree
+    long long nodes = 0;      ///< Positions visited, in the tree and in playouts
+    long long tree_nodes = 0; ///< Tree nodes held after the search
+    long long reused = 0;     ///< Tree nodes carried over from the previous move
+    int threads = 0;          ///< Threads that searched
+    double seconds = 0;       ///< Wall-clock time of the search
+
+    /** @brief Positions visited per wall-clock second. */
+    double nodes_per_second() const { return seconds > 0 ? nodes / seconds : 0; }
+
+    /** @brief Playouts finished per wall-clock second. */
+    double playouts_per_second() const { return seconds > 0 ? playouts / seconds : 0; }
+};
+
+/**
+ * @brief Player that picks its moves with parallel Monte Carlo Tree Search.
+ *
+ * @tparam T Type of symbol placed on the board.
+ * @tparam BoardT Concrete board type; it is copied for every playout.
+ *
+ * A search stops after a playout budget, a wall-clock budget, or whichever
+ * comes first when both are set. The move returned is the root move with the
+ * most visits over all threads.
+ */
+template <typename T, typename BoardT>
+class MCTS_Player : public Searcher<T> {
+public:
+    /**
+     * @brief Construct an MCTS player.
+     * @param name Player name.
+     * @param symbol Symbol the player places.
+     * @param opponent_symbol Symbol the opponent places.
+     * @param playouts Playouts per move over all threads; 0 for no playout limit.
+     * @param seconds Wall-clock budget per move; 0 for no time limit.
+     * @param threads Search threads; 0 uses every hardware thread.
+     *
+     * With neither limit set a search runs DEFAULT_PLAYOUTS playouts.
+     */
+    MCTS_Player(string name, T symbol, T opponent_symbol, long long playouts = DEFAULT_PLAYOUTS,
+                double seconds = 0, int threads = 0)
+        : Searcher<T>(name, symbol), opponent_symbol(opponent_symbol),
+          playouts(max(playouts, 0LL)), seconds(max(seconds, 0.0)) {
+        this->think_ms = static_cast<int>(this->seconds * 1000);
+        set_threads(threads);
+    }
+
+    /**
+     * @brief Search the current board and return the most visited move.
+     * @return The move for this player, or a move at (-1, -1) if the board
+     *         offers no moves.
+     */
+    Move<T> choose_move() override {
+        const BoardT& board = *static_cast<BoardT*>(this->get_board_ptr());
+        auto start = chrono::steady_clock::now();
+        stats = MCTSStats();
+        stats.threads = threads;
+
+        if (!reuse_trees(board)) {
+            workers.clear();
+            for (int i = 0; i < threads; ++i)
+                workers.push_back(make_unique<Worker>(board, this->get_symbol(), opponent_symbol, seed()));
+        }
+        for (auto& w : workers)
+            stats.reused += w->tree.size();
+
+        long long budget = (playouts == 0 && seconds == 0) ? DEFAULT_PLAYOUTS : playouts;
+        long long per_thread = budget > 0 ? (budget + threads - 1) / threads : 0;
+        auto deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(
+                                    chrono::duration<double>(seconds));
+
+        vector<thread> pool;
+        for (int i = 1; i < threads; ++i)
+            pool.emplace_back([&, i] { search(*workers[i], board, per_thread, deadline); });
+        search(*workers[0], board, per_thread, deadline);
+        for (auto& t : pool) t.join();
+
+        Move<T> best(-1, -1, this->get_symbol());
+        long long best_visits = -1;
+        vector<pair<Move<T>, long long>> totals;
+        for (auto& w : workers) {
+            stats.playouts += w->playouts;
+            stats.nodes += w->nodes;
+            stats.tree_nodes += w->tree.size();
+            for (int c = w->tree[0].first_child; c != -1; c = w->tree[c].next_sibling) {
+                auto it = find_if(totals.begin(), totals.end(),
+                                  [&](const pair<Move<T>, long long>& t) { return t.first == w->tree[c].move; });
+                if (it == totals.end())
+                    totals.push_back({ w->tree[c].move, w->tree[c].visits });
+                else
+                    it->second += w->tree[c].visits;
+            }
+        }
+        for (auto& t : totals)
+            if (t.second > best_visits) {
+                best_visits = t.second;
+                best = t.first;
+            }
+
+        root = make_unique<BoardT>(board);
+        last_move = best;
+        stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return best;
+    }
+
+    /** @brief Playouts per move over all threads; 0 for no playout limit. */
+    void set_playouts(long long n) { playouts = max(n, 0LL); }
+
+    /** @brief Wall-clock budget per move in seconds; 0 for no time limit. */
+    void set_time_limit(double s) {
+        seconds = max(s, 0.0);
+        this->think_ms = static_cast<int>(seconds * 1000);
+    }
+
+    /** @brief Wall-clock budget per move in milliseconds; 0 for no time limit. */
+    void set_think_ms(int ms) override {
+        Searcher<T>::set_think_ms(ms);
+        seconds = this->think_ms / 1000.0;
+    }
+
+    /** @brief Number of search threads; 0 uses every hardware thread. */
+    void set_threads(int n) {
+        if (n <= 0) n = max(1, static_cast<int>(thread::hardware_concurrency()));
+        if (n != threads) {
+            threads = n;
+            workers.clear();
+            root.reset();
+        }
+    }
+
+    /** @brief Counters of the last search. */
+    const MCTSStats& get_stats() const { return stats; }
+
+    /** @brief Add the nodes of the last search to out (MCTS has no table or fixed depth). */
+    void report_search(GameStats& out) const override {
+        out.record_search(stats.nodes, 0, 0, 0);
+    }
+
+    static const long long DEFAULT_PLAYOUTS = 20000; ///< Budget when no limit is given
+
+private:
+    static constexpr double EXPLORATION = 1.41421356; ///< UCT exploration constant (sqrt 2)
+
+    /** @brief One position in a search tree; children form a sibling list. */
+    struct Node {
+        Move<T> move;          ///< Move that leads here from the parent
+        int parent = -1;       ///< Parent index, -1 for the root
+        int first_child = -1;  ///< First child index, -1 if none yet
+        int next_sibling = -1; ///< Next child of the parent, -1 for the last
+        int move_count = -1;   ///< Legal moves here; -1 until first needed
+        int expanded = 0;      ///< Children created so far, in generate_moves() order
+        int visits = 0;        ///< Playouts through this node
+        double value = 0;      ///< Playout results for the side that played move (1 win, 0.5 draw)
+        int8_t side = 1;       ///< Side that played move: 0 this player, 1 the opponent
+        int8_t result = -1;    ///< Result of move if it ended the game (2 win, 1 draw, 0 loss), else -1
+    };
+
+    /** @brief Tree, scratch board and random source owned by one thread. */
+    struct Worker {
+        vector<Node> tree;     ///< Node 0 is the root, with this player to move
+        BoardT board;          ///< Scratch copy the playouts are played on
+        Player<T> sides[2];    ///< Unnamed stand-ins used to ask the board for results
+        Rng rng;               ///< Random source of the playouts
+        long long playouts = 0;
+        long long nodes = 0;
+
+        Worker(const BoardT& b, T symbol, T opponent_symbol, uint64_t seed)
+            : tree(1), board(b),
+              sides{ Player<T>("", symbol, PlayerType::AI), Player<T>("", opponent_symbol, PlayerType::AI) },
+              rng(seed) {}
+    };
+
+    T opponent_symbol;                    ///< Symbol the opponent places
+    long long playouts;                   ///< Playout budget per move, 0 for none
+    double seconds;                       ///< Time budget per move, 0 for none
+    int threads = 0;                      ///< Search threads
+    vector<unique_ptr<Worker>> workers;   ///< One per thread, kept between moves
+    unique_ptr<BoardT> root;              ///< Position the trees were searched from
+    Move<T> last_move;                    ///< Move returned by the last search
+    MCTSStats stats;                      ///< Counters of the last search
+
+    /** @brief A fresh seed for a worker's random source, drawn from the calling thread's generator. */
+    static uint64_t seed() {
+        return thread_rng().next();
+    }
+
+    /** @brief True if two boards hold the same cells after the same number of moves. */
+    static bool same_position(const BoardT& a, const BoardT& b) {
+        if (a.get_n_moves() != b.get_n_moves()) return false;
+        BoardView<T> va = a.view(), vb = b.view();
+        for (int r = 0; r < va.get_rows(); ++r)
+            for (int c = 0; c < va.get_columns(); ++c)
+                if (va(r, c) != vb(r, c)) return false;
+        return true;
+    }
+
+    /**
+     * @brief Re-root every worker's tree at the current position.
+     *
+     * Finds the opponent's reply to the last move by replaying each of its
+     * legal moves, then keeps the matching grandchild of each root.
+     * @return false if the trees cannot be reused and must be rebuilt.
+     */
+    bool reuse_trees(const BoardT& board) {
+        if (!root || workers.empty()) return false;
+
+        BoardT after(*root);
+        Move<T> mine = last_move;
+        if (!after.update_board(&mine)) return false;
+
+        MoveList<T> replies;
+        after.generate_moves(opponent_symbol, replies);
+        const Move<T>* reply = nullptr;
+        for (const Move<T>& m : replies) {
+            BoardT next(after);
+            Move<T> move = m;
+            if (next.update_board(&move) && same_position(next, board)) {
+                reply = &m;
+                break;
+            }
+        }
+        if (!reply) return false;
+
+        for (auto& w : workers) {
+            int node = find_child(w->tree, 0, last_move);
+            if (node != -1) node = find_child(w->tree, node, *reply);
+            if (node == -1)
+                w->tree.assign(1, Node());
+            else
+                w->tree = extract(w->tree, node);
+            w->playouts = w->nodes = 0;
+        }
+        return true;
+    }
+
+    /** @brief Index of the child of a node reached by a move, or -1. */
+    static int find_child(const vector<Node>& tree, int node, const Move<T>& move) {
+        for (int c = tree[node].first_child; c != -1; c = tree[c].next_sibling)
+            if (tree[c].move == move) return c;
+        return -1;
+    }
+
+    /** @brief Copy the subtree below a node into a new tree rooted at it. */
+    static vector<Node> extract(const vector<Node>& tree, int node) {
+        vector<Node> out;
+        vector<pair<int, int>> order; // (old index, new index), breadth first
+        out.push_back(tree[node]);
+        out[0].parent = out[0].next_sibling = -1;
+        order.push_back({ node, 0 });
+        for (size_t q = 0; q < order.size(); ++q) {
+            int from = order[q].first, to = order[q].second;
+            int prev = -1;
+            out[to].first_child = -1;
+            for (int c = tree[from].first_child; c != -1; c = tree[c].next_sibling) {
+                int index = static_cast<int>(out.size());
+                out.push_back(tree[c]);
+                out[index].parent = to;
+                out[index].next_sibling = -1;
+                if (prev == -1) out[to].first_child = index;
+                else out[prev].next_sibling = index;
+                prev = index;
+                order.push_back({ c, index });
+            }
+        }
+        return out;
+    }
+
+    /** @brief Run playouts on one worker until its budget is spent. */
+    void search(Worker& w, const BoardT& board, long long budget,
+                chrono::steady_clock::time_point deadline) {
+        for (long long n = 0; budget == 0 || n < budget; ++n) {
+            if (seconds > 0 && n % 64 == 0 && chrono::steady_clock::now() >= deadline)
+                break;
+            w.board = board;
+            playout(w);
+            ++w.playouts;
+        }
+    }
+
+    /** @brief Child of a fully expanded node with the best UCT score. */
+    static int select_child(const vector<Node>& tree, int node) {
+        double log_visits = log(static_cast<double>(tree[node].visits));
+        int best = -1;
+        double best_score = -1;
+        for (int c = tree[node].first_child; c != -1; c = tree[c].next_sibling) {
+            const Node& child = tree[c];
+            double score = child.value / child.visits + EXPLORATION * sqrt(log_visits / child.visits);
+            if (score > best_score) {
+                best_score = score;
+                best = c;
+            }
+        }
+        return best;
+    }
+
+    /** @brief Play a move on the scratch board and record its result in a node. */
+    static void apply(Worker& w, Node& node) {
+        Move<T> move = node.move;
+        w.board.update_board(&move);
+        ++w.nodes;
+        switch (check_result(&w.board, &w.sides[node.side])) {
+            case GameResult::WIN:  node.result = 2; break;
+            case GameResult::LOSE: node.result = 0; break;
+            case GameResult::DRAW: node.result = 1; break;
+            default: node.result = -1; break;
+        }
+    }
+
+    /**
+     * @brief One iteration: select, expand one node, play out, back up.
+     *
+     * The tree is descended by UCT while nodes are fully expanded; the first
+     * node with an untried move gets its next child, and a random game is
+     * played from there. The winner is credited along the path.
+     */
+    void playout(Worker& w) {
+        vector<Node>& tree = w.tree;
+        MoveList<T> moves;
+        int node = 0;
+
+        while (tree[node].result < 0) {
+            int to_move = 1 - tree[node].side;
+            if (tree[node].move_count < 0 || tree[node].expanded < tree[node].move_count) {
+                w.board.generate_moves(w.sides[to_move].get_symbol(), moves);
+                tree[node].move_count = moves.size();
+                if (moves.empty()) {
+                    // Nothing to play although the board reports no result
+                    tree[node].result = 1;
+                    break;
+                }
+                if (tree[node].expanded < tree[node].move_count) {
+                    Node child;
+                    child.move = moves[tree[node].expanded];
+                    child.parent = node;
+                    child.side = static_cast<int8_t>(to_move);
+                    child.next_sibling = tree[node].first_child;
+                    int index = static_cast<int>(tree.size());
+                    tree.push_back(child);
+                    tree[node].first_child = index;
+                    ++tree[node].expanded;
+                    apply(w, tree[index]);
+                    node = index;
+                    break;
+                }
+            }
+            node = select_child(tree, node);
+            apply(w, tree[node]);
+        }
+
+        int winner = rollout(w, node); // 0, 1, or -1 for a draw
+        for (; node != -1; node = tree[node].parent) {
+            ++tree[node].visits;
+            if (winner < 0) tree[node].value += 0.5;
+            else if (winner == tree[node].side) tree[node].value += 1;
+        }
+    }
+
+    /**
+     * @brief Finish the game from a node with random moves.
+     * @return The winning side (0 this player, 1 the opponent), or -1 for a draw.
+     */
+    int rollout(Worker& w, int node) {
+        const Node& leaf = w.tree[node];
+        if (leaf.result >= 0)
+            return leaf.result == 1 ? -1 : (leaf.result == 2 ? leaf.side : 1 - leaf.side);
+
+        MoveList<T> moves;
+        int side = 1 - leaf.side;
+        while (true) {
+            w.board.generate_moves(w.sides[side].get_symbol(), moves);
+            if (moves.empty()) return -1;
+            Move<T> move = moves[w.rng.below(static_cast<uint32_t>(moves.size()))];
+            w.board.update_board(&move);
+            ++w.nodes;
+            switch (check_result(&w.board, &w.sides[side])) {
+                case GameResult::WIN:  return side;
+                case GameResult::LOSE: return 1 - side;
+                case GameResult::DRAW: return -1;
+                default: side = 1 - side;
+            }
+        }
+    }
+};
+
+#endif // _MCTS_PLAYER_H
@@ -7,7 +7,8 @@ using namespace std;
 
 //--------------------------------------- Memory_Board Implementation
 
-Memory_Board::Memory_Board() : Board(3, 3) {
+Memory_Board::Memory_Board() {
+    set_symmetry(Symmetry::SQUARE);
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
@@ -23,35 +24,30 @@ bool Memory_Board::update_board(Move<char>* move) {
 
         if (mark == 0) {
             n_moves--;
-            board[x][y] = blank_symbol;
+            set_cell(x, y, blank_symbol);
+            winner = 0;
         }
         else {
             n_moves++;
-            board[x][y] = toupper(mark);
+            set_cell(x, y, toupper(mark));
+            // Only lines through the new mark can have been completed
+            winner = has_line_through<3>(x * columns + y, toupper(mark)) ? toupper(mark) : 0;
         }
         return true;
     }
     return false;
 }
 
-bool Memory_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-        };
-
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
-    }
+void Memory_Board::save_state() {
+    push_state(winner);
+}
 
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
+void Memory_Board::restore_state() {
+    pop_state(winner);
+}
 
-    return false;
+bool Memory_Board::is_win(Player<char>* player) {
+    return winner != 0 && winner == player->get_symbol();
 }
 
 bool Memory_Board::is_lose(Player<char>* player) {
@@ -59,27 +55,41 @@ bool Memory_Board::is_lose(Player<char>* player) {
 }
 
 bool Memory_Board::is_draw(Player<char>* player) {
-    return (n_moves == 9 && !is_win(player));
+    return (n_moves == 9 && winner == 0);
 }
 
 bool Memory_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+void Memory_Board::generate_moves(char symbol, MoveList<char>& moves) {
+    generate_placements(blank_symbol, symbol, moves);
+}
+
+uint64_t Memory_Board::position_key() const {
+    return base3_key(blank_symbol, 'X');
+}
+
 Player<char>* Memory_UI::create_player(string& name, char symbol, PlayerType type) {
     // Create player based on type
-    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
+    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : type == PlayerType::AI ? "AI" : "computer")
         << " player: " << name << " (" << symbol << ")\n";
 
+    if (type == PlayerType::AI)
+        return new Perfect_Player<char, Memory_Board>(name, symbol, 'X', 'O');
     return new Player<char>(name, symbol, type);
 }
 
-void Memory_UI::display_board_matrix(const vector<vector<char>>& matrix) const
+vector<string> Memory_UI::player_type_options() const {
+    return { "Human", "Computer", "AI" };
+}
+
+void Memory_UI::display_board_matrix(const BoardView<char>& matrix) const
 {
-    if (matrix.empty() || matrix[0].empty()) return;
+    if (matrix.get_rows() == 0 || matrix.get_columns() == 0) return;
 
-    int rows = static_cast<int>(matrix.size());
-    int cols = static_cast<int>(matrix[0].size());
+    int rows = matrix.get_rows();
+    int cols = matrix.get_columns();
 
     cout << "\n";
     cout << " 0   1   2 ";
@@ -87,7 +97,7 @@ void Memory_UI::display_board_matrix(const vector<vector<char>>& matrix) const
 
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
-            if (matrix[i][j] != '.')
+            if (matrix(i, j) != '.')
                 cout << setw(2) << "#";
             else
                 cout << setw(2) << '.';
@@ -102,7 +112,7 @@ void Memory_UI::display_board_matrix(const vector<vector<char>>& matrix) const
     cout << "\n";
 }
 
-Move<char>* Memory_UI::get_move(Player<char>* player) {
+Move<char> Memory_UI::next_move(Player<char>* player) {
     int x, y;
 
     if (player->get_type() == PlayerType::HUMAN) {
@@ -110,8 +120,14 @@ Move<char>* Memory_UI::get_move(Player<char>* player) {
         cin >> x >> y;
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
+        return computer_move(player);
+    }
+    else if (player->get_type() == PlayerType::AI) {
+        return static_cast<Searcher<char>*>(player)->choose_move();
     }
-    return new Move<char>(x, y, player->get_symbol());
+    return Move<char>(x, y, player->get_symbol());
+}
+
+Move<char> Memory_UI::computer_move(Player<char>* player) {
+    return random_move(player->get_board_ptr(), player->get_symbol());
 }
\ No newline at end of file
@@ -11,6 +11,8 @@
 
 #pragma once
 #include "BoardGame_Classes.h"
+#include "FixedBoard.h"
+#include "Perfect_Player.h"
 using namespace std;
 
 /**
@@ -27,9 +29,16 @@ using namespace std;
  * can contain a player's symbol or remain empty. The memory aspect is handled
  * by the UI layer, which controls when the board is displayed to players.
  */
-class Memory_Board : public Board<char> {
+class Memory_Board final : public FixedBoard<char, 3, 3> {
 private:
     char blank_symbol = '.';  ///< Symbol representing empty cells on the board
+    char winner = 0;          ///< Symbol whose last move completed a line, or 0
+
+    /** @brief Save the cached outcome before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override;
 
 public:
     /**
@@ -64,12 +73,14 @@ public:
      * @return true if the player has three in a row in any winning configuration; false otherwise
      *
      * @details
-     * Checks all possible winning combinations for Tic-Tac-Toe:
+     * The winning combinations are those of Tic-Tac-Toe:
      * - Three horizontal rows
      * - Three vertical columns
      * - Two diagonals (main diagonal and anti-diagonal)
      *
      * A player wins by having their symbol in all three positions of any line.
+     * update_board() checks the lines through each new mark, so this only
+     * reads its result.
      */
     bool is_win(Player<char>* player) override;
 
@@ -112,6 +123,20 @@ public:
      * @note This method should be called after each move to determine if gameplay should end
      */
     bool game_is_over(Player<char>* player) override;
+
+    /**
+     * @brief Lists every empty cell
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
+     *
+     * Cells are hidden from the players but not from the generator.
+     */
+    void generate_moves(char symbol, MoveList<char>& moves) override;
+
+    /**
+     * @brief Exact base-3 key of the cells (X is 1, O is 2)
+     */
+    uint64_t position_key() const override;
 };
 
 /**
@@ -168,11 +193,16 @@ public:
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type) override;
 
+    /**
+     * @brief Offers Human, Computer and AI (perfect play) players
+     */
+    vector<string> player_type_options() const override;
+
     /**
      * @brief Prompts for and retrieves a player's move
      *
      * @param player Pointer to the Player object making the move
-     * @return Pointer to a Move object containing the selected row, column, and symbol
+     * @return A Move containing the selected row, column, and symbol
      *
      * @details
      * For human players, prompts for row and column coordinates (typically 0-2).
@@ -189,9 +219,15 @@ public:
      * - Input is properly formatted
      *
      * @note Re-prompts the user if invalid input is detected
-     * @warning Caller is responsible for deallocating the returned Move object
      */
-    Move<char>* get_move(Player<char>* player) override;
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Picks a random legal move for a computer player.
+     * @param player Pointer to the player whose move is being requested
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if there is none
+     */
+    static Move<char> computer_move(Player<char>* player);
 
     /**
      * @brief Displays the game board matrix to the console
@@ -215,5 +251,5 @@ public:
      * @note This is a const method and does not modify the board state
      * @see The UI may clear the screen after displaying to enforce the memory aspect
      */
-    void display_board_matrix(const vector<vector<char>>& matrix) const;
+    void display_board_matrix(const BoardView<char>& matrix) const;
 };
\ No newline at end of file
@@ -3,13 +3,15 @@
 #include <iostream>
 #include <iomanip>
 #include <cctype>  // for toupper()
+#include <bit>
 #include "NUMERICAL_TIC_TAC_TOE.h"
 
 using namespace std;
 
 //--------------------------------------- X_O_Board Implementation
 
-Numerical_XO_Board::Numerical_XO_Board() : Board(3, 3) {
+Numerical_XO_Board::Numerical_XO_Board() {
+    set_symmetry(Symmetry::SQUARE);
     // Initialize all cells with blank_symbol
     for (auto& row : board)
         for (auto& cell : row)
@@ -20,6 +22,7 @@ bool Numerical_XO_Board::update_board(Move<char>* move) {
     int x = move->get_x();
     int y = move->get_y();
     char mark = move->get_symbol();
+    int d = mark - '0';
 
     // Validate move and apply if valid
     if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
@@ -27,64 +30,139 @@ bool Numerical_XO_Board::update_board(Move<char>* move) {
 
         if (mark == 0) { // Undo move
             n_moves--;
-            board[x][y] = blank_symbol;
+            if (board[x][y] != blank_symbol) {
+                int old = board[x][y] - '0';
+                count_digit(x * columns + y, old, -1);
+                used &= ~(1u << old);
+            }
+            set_cell(x, y, blank_symbol);
+            line_made = false;
         }
         else {         // Apply move
+            if (d < 1 || d > 9 || (used >> d & 1)) return false;
             n_moves++;
-            board[x][y] = toupper(mark);
+            set_cell(x, y, mark);
+            used |= 1u << d;
+            count_digit(x * columns + y, d, 1);
+            // Only lines through the new number can have been completed
+            line_made = false;
+            const FixedCellLines<3>& through = lines_through<3>[x * columns + y];
+            for (int k = 0; k < through.count; ++k)
+                if (line_fill[through.line[k]] == 3 && line_sum[through.line[k]] == 15) line_made = true;
         }
         return true;
     }
     return false;
 }
 
-bool Numerical_XO_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
+void Numerical_XO_Board::count_digit(int i, int d, int sign) {
+    const FixedCellLines<3>& through = lines_through<3>[i];
+    for (int k = 0; k < through.count; ++k) {
+        line_sum[through.line[k]] += sign * d;
+        line_fill[through.line[k]] += sign;
+    }
+}
 
+int Numerical_XO_Board::needed_digit(int n) const {
+    if (line_fill[n] != 2) return 0;
+    int d = 15 - line_sum[n];
+    return d >= 1 && d <= 9 ? d : 0;
+}
 
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if (((board[i][0] + board[i][1] + board[i][2] == 159) && board[i][0]!=blank_symbol
-            && board[i][1]!=blank_symbol && board[i][2]!=blank_symbol) ||
-            ((board[0][i] + board[1][i] + board[2][i] == 159) && board[0][i]!=blank_symbol
-            && board[1][i]!=blank_symbol && board[2][i]!=blank_symbol)) {
-            return true;
-        }
-    }
+void Numerical_XO_Board::save_state() {
+    push_state(line_made);
+    push_state(used);
+    push_state(line_sum);
+    push_state(line_fill);
+}
 
-    // Check diagonals
-    if (((board[0][0] + board[1][1] + board[2][2] == 159) && board[0][0]!=blank_symbol
-        && board[1][1]!=blank_symbol && board[2][2]!=blank_symbol) ||
-        ((board[0][2] + board[1][1] + board[2][0] == 159) && board[0][2] != blank_symbol
-        && board[1][1] != blank_symbol && board[2][0] != blank_symbol))
-        return true;
+void Numerical_XO_Board::restore_state() {
+    pop_state(line_fill);
+    pop_state(line_sum);
+    pop_state(used);
+    pop_state(line_made);
+}
 
-    return false;
+bool Numerical_XO_Board::is_win(Player<char>* player) {
+    return line_made;
 }
 
 bool Numerical_XO_Board::is_draw(Player<char>* player) {
-    return (n_moves == 9 && !is_win(player));
+    return (n_moves == 9 && !line_made);
 }
 
 bool Numerical_XO_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+void Numerical_XO_Board::generate_moves(char symbol, MoveList<char>& moves) {
+    moves.clear();
+    uint16_t digits = available_digits(symbol);
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < columns; ++j) {
+            if (board[i][j] != blank_symbol) continue;
+            for (uint16_t left = digits; left; left &= left - 1)
+                moves.push(Move<char>(i, j, static_cast<char>('0' + countr_zero(left))));
+        }
+}
+
+uint16_t Numerical_XO_Board::winning_cells(char symbol) const {
+    uint16_t digits = available_digits(symbol), cells = 0;
+    for (int n = 0; n < 8; ++n) {
+        int d = needed_digit(n);
+        if (!d || !(digits >> d & 1)) continue;
+        for (uint8_t cell : lines<3>[n])
+            if (board[cell / 3][cell % 3] == blank_symbol) cells |= uint16_t(1u << cell);
+    }
+    return cells;
+}
+
+bool Numerical_XO_Board::winning_move(char symbol, Move<char>& move) const {
+    uint16_t digits = available_digits(symbol);
+    for (int n = 0; n < 8; ++n) {
+        int d = needed_digit(n);
+        if (!d || !(digits >> d & 1)) continue;
+        for (uint8_t cell : lines<3>[n])
+            if (board[cell / 3][cell % 3] == blank_symbol) {
+                move = Move<char>(cell / 3, cell % 3, static_cast<char>('0' + d));
+                return true;
+            }
+    }
+    return false;
+}
+
+int Numerical_XO_Board::evaluate(char symbol) {
+    if (winning_cells(symbol)) return 100;
+    return -10 * popcount(unsigned(winning_cells(symbol == 'X' ? 'O' : 'X')));
+}
+
+uint64_t Numerical_XO_Board::position_key() const {
+    uint64_t key = 0;
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < columns; ++j)
+            key = key * 10 + (board[i][j] == blank_symbol ? 0 : board[i][j] - '0');
+    return key;
+}
+
 //--------------------------------------- XO_UI Implementation
 
 Numerical_XO_UI::Numerical_XO_UI() : UI<char>("Weclome to FCAI X-O Game by Dr El-Ramly", 3) {}
 
 Player<char>* Numerical_XO_UI::create_player(string& name, char symbol, PlayerType type) {
     // Create player based on type
-    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
+    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : type == PlayerType::AI ? "AI" : "computer")
         << " player: " << name << "\n";
-
+    if (type == PlayerType::AI) {
+        AI_Player<char, Numerical_XO_Board>* ai = new AI_Player<char, Numerical_XO_Board>(name, symbol, symbol == 'X' ? 'O' : 'X', 9);
+        ai->set_think_ms(1000);
+        return ai;
+    }
     return new Player<char>(name, symbol, type);
 }
 
 Player<char> **Numerical_XO_UI::setup_players() {
     Player<char>** players = new Player<char>*[2];
-    vector<string> type_options = { "Human", "Computer" };
+    vector<string> type_options = { "Human", "Computer", "AI" };
 
     string nameO = get_player_name("Player 1");
     PlayerType typeO = get_player_type_choice("Player 1", type_options);
@@ -98,75 +176,30 @@ Player<char> **Numerical_XO_UI::setup_players() {
 }
 
 
-Move<char>* Numerical_XO_UI::get_move(Player<char>* player) {
-    int x, y, cnt = 0;
+Move<char> Numerical_XO_UI::next_move(Player<char>* player) {
+    int x, y;
     char num;
     if (player->get_type() == PlayerType::HUMAN) {
+        // The board knows which numbers are still free; 'X' plays the even ones
+        uint16_t digits = static_cast<Numerical_XO_Board*>(player->get_board_ptr())->available_digits(player->get_symbol());
         cout << "\nPlease enter your move x and y (0 to 2): ";
         cin >> x >> y;
         cout << "\nPlease enter a number: ";
         cin >> num;
-        for (auto i : nums) {
-            if (i == num)
-                cnt++;
-        }
-        if (player->get_symbol() == 'X') {
-            while (!(num == '2' || num == '4' || num == '6' || num == '8') || cnt != 0) {
-                cout << "\nPlease enter a valid number: ";
-                cin >> num;
-                cnt = 0;
-                for (auto i : nums) {
-                    if (i == num)
-                        cnt++;
-                }
-            }
-        }else {
-            while (!(num == '1' || num == '3' || num == '5' || num == '7' || num == '9') || cnt != 0) {
-                cout << "\nPlease enter a valid number: ";
-                cin >> num;
-                cnt = 0;
-                for (auto i : nums) {
-                    if (i == num)
-                        cnt++;
-                }
-            }
+        while (num < '1' || num > '9' || !(digits >> (num - '0') & 1)) {
+            cout << "\nPlease enter a valid number: ";
+            cin >> num;
         }
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
-        if (player->get_symbol() == 'X') {
-            char even[4] = {'2', '4', '6', '8'};
-            num = even[rand() % 4];
-            for (auto i : nums) {
-                if (i == num)
-                    cnt++;
-            }
-            while (cnt != 0) {
-                num = even[rand() % 4];
-                cnt = 0;
-                for (auto i : nums) {
-                    if (i == num)
-                        cnt++;
-                }
-            }
-        }else {
-            char odd[5] = {'1', '3', '5', '7', '9'};
-            num = odd[rand() % 5];
-            for (auto i : nums) {
-                if (i == num)
-                    cnt++;
-            }
-            while (cnt != 0) {
-                num = odd[rand() % 5];
-                cnt = 0;
-                for (auto i : nums) {
-                    if (i == num)
-                        cnt++;
-                }
-            }
-        }
+        return computer_move(player);
+    }
+    else {
+        return static_cast<Searcher<char>*>(player)->choose_move();
     }
-    nums.push_back(num);
-    return new Move<char>(x, y, num);
+    return Move<char>(x, y, num);
+}
+
+Move<char> Numerical_XO_UI::computer_move(Player<char>* player) {
+    return random_move(player->get_board_ptr(), player->get_symbol());
 }
@@ -23,6 +23,8 @@
 #ifndef NUMERICAL_TIC_TAC_TOE_H
 #define NUMERICAL_TIC_TAC_TOE_H
 #include "BoardGame_Classes.h"
+#include "FixedBoard.h"
+#include "AI_Player.h"
 #include <vector>
 using namespace std;
 
@@ -46,10 +48,36 @@ using namespace std;
  * The number 15 is chosen because it's the magic constant of a 3x3 magic square.
  * With the numbers 1-9, there are exactly 8 ways to sum to 15 using three
  * different numbers, corresponding to the 8 possible winning lines.
+ *
+ * The board keeps the numbers already played as a bitmask (bit d for the
+ * number d) and, for each of its 8 lines (FixedBoard::lines<3>), the sum
+ * and the count of the numbers on it. A move updates only the lines
+ * through its cell, so the number a line still needs (15 - sum once it
+ * holds two) and whether a player has it are mask tests.
  */
-class Numerical_XO_Board : public Board<char> {
+class Numerical_XO_Board final : public FixedBoard<char, 3, 3> {
+public:
+    static constexpr uint16_t ODD_DIGITS = 0x2AA;  ///< Bits of 1, 3, 5, 7 and 9
+    static constexpr uint16_t EVEN_DIGITS = 0x154; ///< Bits of 2, 4, 6 and 8
+
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
+    bool line_made = false;  ///< True if the last move completed a line summing to 15
+    uint16_t used = 0;       ///< Bit d set once the number d is on the board
+    array<uint8_t, 8> line_sum{};  ///< Sum of the numbers on each line
+    array<uint8_t, 8> line_fill{}; ///< Count of the numbers on each line
+
+    /** @brief Add (or with sign -1 remove) the number d on cell i to the sums of its lines. */
+    void count_digit(int i, int d, int sign);
+
+    /** @brief The number that completes line n, or 0 if it needs none or an impossible one. */
+    int needed_digit(int n) const;
+
+    /** @brief Save the cached outcome, the used numbers and the line counts before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override;
 
 public:
     /**
@@ -88,7 +116,8 @@ public:
      * @return true if the player has a line summing to 15; false otherwise
      *
      * @details
-     * Scans all possible winning lines to see if any sum to exactly 15:
+     * Reads the result update_board() found from the sums of the lines
+     * through the last number. The winning lines are those that sum to exactly 15:
      * - Three rows (horizontal)
      * - Three columns (vertical)
      * - Two diagonals (main and anti)
@@ -152,6 +181,55 @@ public:
      * @note Should be called after each move to determine if gameplay should end
      */
     bool game_is_over(Player<char>* player);
+
+    /**
+     * @brief Lists every empty cell paired with every number the player may still use
+     * @param symbol Symbol of the player to move: 'X' uses the even numbers, the other player the odd ones
+     * @param moves Buffer that receives the moves; each carries its number as the symbol
+     *
+     * A number already on the board cannot be played again.
+     */
+    void generate_moves(char symbol, MoveList<char>& moves);
+
+    /**
+     * @brief Exact key: the number in each cell as a base-10 digit (empty is 0)
+     */
+    uint64_t position_key() const override;
+
+    /**
+     * @brief Numbers a player may still play, as a mask (bit d for the number d)
+     * @param symbol Symbol of the player: 'X' uses the even numbers, the other player the odd ones
+     */
+    uint16_t available_digits(char symbol) const {
+        return (symbol == 'X' ? EVEN_DIGITS : ODD_DIGITS) & ~used;
+    }
+
+    /**
+     * @brief Cells where a player's number would complete a line now
+     * @param symbol Symbol of the player to move
+     * @return 9-bit mask, cell (r, c) at bit r * 3 + c
+     *
+     * A line counts if it holds two numbers and the one it needs is still
+     * available to the player. The opponent's mask is the set of cells the
+     * player has to block.
+     */
+    uint16_t winning_cells(char symbol) const;
+
+    /**
+     * @brief A move that completes a line for a player, if there is one
+     * @param symbol Symbol of the player to move
+     * @param move Set to the first such move, carrying its number as the symbol
+     * @return false if the player has no winning move
+     */
+    bool winning_move(char symbol, Move<char>& move) const;
+
+    /**
+     * @brief Heuristic score of the position for the player to move
+     * @param symbol Symbol of the player to move
+     * @return 100 if the player can win now, otherwise minus 10 for every
+     *         cell where the opponent threatens to
+     */
+    int evaluate(char symbol) override;
 };
 
 /**
@@ -165,27 +243,21 @@ public:
  *
  * @details
  * Key responsibilities:
- * - Display available numbers for each player
  * - Validate that players choose from their correct number set
- * - Track which numbers have been used
- * - Prevent reuse of already-played numbers
+ * - Prevent reuse of already-played numbers, read from the board
  * - Show the current board state with numbers instead of X/O
  */
 class Numerical_XO_UI : public UI<char> {
 public:
-    vector<char> nums;  ///< Vector tracking available/used numbers for the game
-
     /**
      * @brief Constructs the Numerical Tic-Tac-Toe user interface
      *
      * @details
      * Initializes the UI with appropriate settings for Numerical Tic-Tac-Toe:
      * - Sets up the game title
-     * - Initializes the nums vector with available numbers (1-9)
      * - Prepares the interface for numeric input instead of X/O
      *
-     * The nums vector will be used to track which numbers have been played
-     * and which are still available for use.
+     * The numbers already played are kept by the board.
      */
     Numerical_XO_UI();
 
@@ -201,7 +273,7 @@ public:
      * @brief Creates a single player object
      *
      * @param name Reference to string containing the player's name
-     * @param symbol Character representing the player's number type ('O' for odd, 'E' for even)
+     * @param symbol Character representing the player's number type ('O' for odd, 'X' for even)
      * @param type Type of player (human, AI, random, etc.)
      * @return Pointer to the newly created Player object
      *
@@ -211,14 +283,11 @@ public:
      * - One player gets odd numbers (1, 3, 5, 7, 9)
      * - Other player gets even numbers (2, 4, 6, 8)
      *
-     * AI players need special logic to:
-     * - Calculate which combinations can sum to 15
-     * - Track which numbers are still available
-     * - Block opponents from completing lines that sum to 15
-     * - Strategically choose numbers that create multiple winning threats
+     * AI players search with AI_Player under a time budget of one second a
+     * move, guided by the board's winning_cells() threats.
      *
      * @warning Caller is responsible for deallocating the returned Player object
-     * @note Symbol 'O' typically represents odd numbers, 'E' for even numbers
+     * @note Symbol 'O' typically represents odd numbers, 'X' for even numbers
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type);
 
@@ -226,14 +295,14 @@ public:
      * @brief Prompts for and retrieves a player's move
      *
      * @param player Pointer to the Player object making the move
-     * @return Pointer to a Move object containing position and numeric symbol
+     * @return A Move containing position and numeric symbol
      *
      * @details
      * For human players, prompts for:
      * - Row and column coordinates (0-2)
      * - The number to place (must be from player's available set)
      *
-     * For AI players, automatically calculates the best move.
+     * For computer players it calls computer_move(); AI players search.
      *
      * Validates that:
      * - Row and column are within valid range (0-2)
@@ -246,11 +315,22 @@ public:
      * - Numbers that have already been used
      * - Current board state
      *
-     * @note Updates the nums vector to mark the number as used
      * @note Re-prompts if player tries to use an invalid or already-used number
-     * @warning Caller is responsible for deallocating the returned Move object
      */
-    virtual Move<char>* get_move(Player<char>* player);
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Picks a random cell and an unused number for a computer player
+     *
+     * @param player Pointer to the player whose move is being requested
+     * @return A Move<char> carrying the chosen number as its symbol
+     *
+     * @details
+     * The move is drawn from the board's generate_moves(), which reads the numbers
+     * already used from the board, so this needs no UI state and uses no console
+     * I/O; it can drive headless games without a UI object.
+     */
+    static Move<char> computer_move(Player<char>* player);
 
     /**
      * @brief Sets up all players for the game
@@ -262,8 +342,8 @@ public:
      * - Player 1: Name, type, assigned odd numbers (1,3,5,7,9)
      * - Player 2: Name, type, assigned even numbers (2,4,6,8)
      *
-     * Initializes the nums vector with all available numbers and assigns
-     * appropriate number sets to each player.
+     * Offers Human, Computer and AI players and assigns the appropriate
+     * number sets to each player.
      *
      * @note Player 1 traditionally gets odd numbers, Player 2 gets even
      * @warning Caller is responsible for deallocating the returned array
@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "OpeningBook.h"
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace {
+    const char MAGIC[OpeningBook::MAGIC_BYTES + 1] = "BGBOOK01";
+
+    uint64_t read_le(const uint8_t* p, int bytes) {
+        uint64_t value = 0;
+        for (int i = bytes - 1; i >= 0; --i)
+            value = (value << 8) | p[i];
+        return value;
+    }
+
+    void write_le(vector<uint8_t>& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i)
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+OpeningBook::OpeningBook(const string& path) {
+#ifdef _WIN32
+    ifstream in(path, ios::binary);
+    if (!in)
+        throw runtime_error("cannot open opening book " + path);
+    copy.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    data = copy.data();
+    bytes = copy.size();
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("cannot open opening book " + path);
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size >= MAGIC_BYTES) {
+        void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped != MAP_FAILED) {
+            data = static_cast<const uint8_t*>(mapped);
+            bytes = info.st_size;
+            madvise(mapped, bytes, MADV_RANDOM);
+        }
+    }
+    close(fd);
+#endif
+    if (bytes < MAGIC_BYTES || memcmp(data, MAGIC, MAGIC_BYTES) != 0 ||
+        (bytes - MAGIC_BYTES) % ENTRY_BYTES != 0) {
+        release();
+        throw runtime_error(path + " is not an opening book");
+    }
+    entries = (bytes - MAGIC_BYTES) / ENTRY_BYTES;
+}
+
+OpeningBook::~OpeningBook() {
+    release();
+}
+
+void OpeningBook::release() {
+#ifndef _WIN32
+    if (data) munmap(const_cast<uint8_t*>(data), bytes);
+#endif
+    data = nullptr;
+    bytes = 0;
+    entries = 0;
+}
+
+BookEntry OpeningBook::entry(size_t i) const {
+    const uint8_t* p = data + MAGIC_BYTES + i * ENTRY_BYTES;
+    BookEntry e;
+    e.key = read_le(p, 8);
+    e.cell = p[8];
+    e.depth = p[9];
+    e.score = static_cast<int16_t>(read_le(p + 10, 2));
+    return e;
+}
+
+bool OpeningBook::find(uint64_t key, BookEntry& found) const {
+    size_t low = 0, high = entries;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        uint64_t at = read_le(data + MAGIC_BYTES + mid * ENTRY_BYTES, 8);
+        if (at < key) low = mid + 1;
+        else high = mid;
+    }
+    if (low == entries) return false;
+    found = entry(low);
+    return found.key == key;
+}
+
+void OpeningBook::write(const string& path, vector<BookEntry> positions) {
+    sort(positions.begin(), positions.end());
+    vector<uint8_t> out(MAGIC, MAGIC + MAGIC_BYTES);
+    out.reserve(MAGIC_BYTES + positions.size() * ENTRY_BYTES);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        if (i > 0 && positions[i].key == positions[i - 1].key)
+            throw runtime_error("two book positions share a key");
+        write_le(out, positions[i].key, 8);
+        out.push_back(positions[i].cell);
+        out.push_back(positions[i].depth);
+        write_le(out, static_cast<uint16_t>(positions[i].score), 2);
+    }
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file)
+        throw runtime_error("cannot write opening book " + path);
+    bool ok = fwrite(out.data(), 1, out.size(), file) == out.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok)
+        throw runtime_error("cannot write opening book " + path);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file OpeningBook.h
+ * @brief Read-only opening book: a sorted table of searched positions, memory-mapped.
+ *
+ * A book file is the 8-byte magic "BGBOOK01" followed by 12-byte entries
+ * sorted by key, with no gaps:
+ *
+ * | bytes | content                                                      |
+ * |-------|--------------------------------------------------------------|
+ * | 0-7   | key of the position (the board's canonical book key), LE     |
+ * | 8     | best move, as a cell index row * columns + column            |
+ * | 9     | depth (plies) the position was searched to                   |
+ * | 10-11 | score for the side to move, signed LE (see OpeningBook::WIN) |
+ *
+ * The move is given in the orientation the key was taken in; the board
+ * that made the key maps it back (Board::book_move()). Lookups are a
+ * binary search in the mapping, so opening a book reads nothing up front
+ * and every process that maps the same file shares its pages.
+ */
+
+#ifndef _OPENING_BOOK_H
+#define _OPENING_BOOK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief One position of a book.
+ */
+struct BookEntry {
+    uint64_t key = 0;  ///< Key of the position
+    uint8_t cell = 0;  ///< Best move, as a cell index
+    uint8_t depth = 0; ///< Plies the position was searched to
+    int16_t score = 0; ///< Score for the side to move
+
+    bool operator<(const BookEntry& other) const { return key < other.key; }
+};
+
+/**
+ * @brief A book file, memory-mapped; safe to share between threads.
+ */
+class OpeningBook {
+public:
+    static const int MAGIC_BYTES = 8;  ///< Size of the file magic
+    static const int ENTRY_BYTES = 12; ///< Size of one entry in a file
+    static const int WIN = 30000;      ///< Score of a win on the next move; one less per further ply
+
+    /**
+     * @brief Map a book file.
+     * @throws runtime_error if the file cannot be mapped or is not a book file
+     */
+    explicit OpeningBook(const string& path);
+
+    /** @brief Unmap the file. */
+    ~OpeningBook();
+
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    /**
+     * @brief Look a position up.
+     * @return false if the book does not hold the key
+     */
+    bool find(uint64_t key, BookEntry& entry) const;
+
+    /** @brief Number of positions in the book. */
+    size_t size() const { return entries; }
+
+    /**
+     * @brief Write a book file, sorting the entries first.
+     * @throws runtime_error if the file cannot be written or two entries share a key
+     */
+    static void write(const string& path, vector<BookEntry> positions);
+
+private:
+    const uint8_t* data = nullptr; ///< The mapping
+    size_t bytes = 0;              ///< Its size
+    size_t entries = 0;            ///< Entries after the magic
+    vector<uint8_t> copy;          ///< File contents where mapping is not available
+
+    /** @brief Entry i, unpacked. */
+    BookEntry entry(size_t i) const;
+
+    /** @brief Unmap the file, if it is mapped. */
+    void release();
+};
+
+#endif // _OPENING_BOOK_H
@@ -0,0 +1,247 @@
+/**
+ * @file Perfect_Player.h
+ * @brief Solved game-value tables and the table-driven perfect player.
+ *
+ * Some boards are small enough to solve completely: every position that can
+ * be reached from the empty board is visited once and its value under
+ * perfect play is stored. A Perfect_Player then picks its move by looking up
+ * the value of each position it can move to, with no search at all.
+ *
+ * The solver plays moves in place (make_move()/unmake_move()) and asks the board itself for
+ * legal moves (generate_moves()) and results (check_result()), so the table
+ * follows each variant's own rules. The board's position_key() must be exact:
+ * two different positions reachable in a game must never share a key.
+ */
+
+#ifndef _PERFECT_PLAYER_H
+#define _PERFECT_PLAYER_H
+
+#include "BoardGame_Classes.h"
+#include "Searcher.h"
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Values of every reachable position of a board, solved once.
+ *
+ * @tparam T Type of symbol placed on the board.
+ * @tparam BoardT Concrete board type; it must be default-constructible to
+ *         the opening position, copyable, and have an exact position_key().
+ *
+ * A value is from the point of view of the side to move: 0 is a draw, a
+ * positive value a win and a negative value a loss. The magnitude shrinks by
+ * one per ply, so faster wins and slower losses score better.
+ *
+ * Keys below DENSE_LIMIT (e.g. base-3 encodings of a 3x3 board) are stored in
+ * a flat array indexed by key; larger key spaces are stored as sorted
+ * key/value arrays. Either way a table costs about one byte per position once
+ * solved, and never changes afterwards, so it can be shared between threads.
+ */
+template <typename T, typename BoardT>
+class Perfect_Table {
+public:
+    static constexpr int WIN = 126;              ///< Value of a win on the next move
+    static constexpr int8_t UNKNOWN = INT8_MIN;  ///< Value of a position not in the table
+    static constexpr uint64_t DENSE_LIMIT = 1 << 22; ///< Largest key space stored as a flat array
+
+    /**
+     * @brief The table of games where `first` moves first, solved on first use.
+     * @param first Symbol of the player who moves first.
+     * @param second Symbol of the other player.
+     */
+    static const Perfect_Table& instance(T first, T second) {
+        static mutex lock;
+        static map<pair<T, T>, unique_ptr<Perfect_Table>> tables;
+        lock_guard<mutex> guard(lock);
+        auto& table = tables[{ first, second }];
+        if (!table) table.reset(new Perfect_Table(first, second));
+        return *table;
+    }
+
+    /**
+     * @brief Value of a position for the side to move.
+     * @return The solved value, or UNKNOWN if the position cannot be reached
+     *         from the opening position.
+     */
+    int8_t value(const BoardT& board) const {
+        uint64_t key = board.position_key();
+        if (!dense.empty())
+            return key < dense.size() ? dense[key] : UNKNOWN;
+        auto it = lower_bound(keys.begin(), keys.end(), key);
+        return (it != keys.end() && *it == key) ? values[it - keys.begin()] : UNKNOWN;
+    }
+
+    /** @brief Symbol of the side to move in a position of this table. */
+    T side_to_move(const BoardT& board) const {
+        return board.get_n_moves() % 2 == 0 ? symbols[0] : symbols[1];
+    }
+
+    /** @brief Number of solved positions. */
+    size_t size() const { return count; }
+
+    /** @brief Bytes used by the stored values (and keys, for sparse tables). */
+    size_t bytes() const { return dense.size() + keys.size() * sizeof(uint64_t) + values.size(); }
+
+    /** @brief Seconds spent solving. */
+    double solve_seconds() const { return seconds; }
+
+    /**
+     * @brief Value for the mover of playing a move, or UNKNOWN.
+     *
+     * Plays the move in place with make_move() and takes it back before
+     * returning; a move that ends the game is scored by check_result(), any
+     * other by the table value of the reply.
+     */
+    int move_value(BoardT& board, const Move<T>& m) const {
+        Player<T> mover("", side_to_move(board), PlayerType::AI);
+        if (!board.make_move(m)) return UNKNOWN;
+        int result;
+        switch (check_result(&board, &mover)) {
+            case GameResult::WIN:  result = WIN; break;
+            case GameResult::LOSE: result = -WIN; break;
+            case GameResult::DRAW: result = 0; break;
+            default:
+                result = value(board);
+                if (result != UNKNOWN) result = back_up(result);
+                break;
+        }
+        board.unmake_move();
+        return result;
+    }
+
+private:
+    T symbols[2];            ///< Symbols of the first and second player
+    vector<int8_t> dense;    ///< Values indexed by key (dense tables)
+    vector<uint64_t> keys;   ///< Sorted keys (sparse tables)
+    vector<int8_t> values;   ///< Values matching keys (sparse tables)
+    size_t count = 0;        ///< Solved positions
+    double seconds = 0;      ///< Time spent solving
+
+    /** @brief Solve every position reachable from BoardT's opening position. */
+    Perfect_Table(T first, T second) : symbols{ first, second } {
+        auto start = chrono::steady_clock::now();
+        unordered_map<uint64_t, int8_t> solved;
+        Player<T> players[2] = { Player<T>("", first, PlayerType::AI), Player<T>("", second, PlayerType::AI) };
+        BoardT opening;
+        solve(opening, players, solved);
+
+        count = solved.size();
+        uint64_t max_key = 0;
+        for (auto& s : solved) max_key = max(max_key, s.first);
+        if (max_key < DENSE_LIMIT) {
+            dense.assign(max_key + 1, UNKNOWN);
+            for (auto& s : solved) dense[s.first] = s.second;
+        }
+        else {
+            vector<pair<uint64_t, int8_t>> sorted(solved.begin(), solved.end());
+            sort(sorted.begin(), sorted.end());
+            for (auto& s : sorted) {
+                keys.push_back(s.first);
+                values.push_back(s.second);
+            }
+        }
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    /** @brief Value for the mover of a reply worth `reply` to the opponent. */
+    static int back_up(int reply) {
+        int v = -reply;
+        if (v > 0) return v - 1;
+        if (v < 0) return v + 1;
+        return 0;
+    }
+
+    /** @brief Negamax over every reachable position, memoised by key; leaves the board as it found it. */
+    int8_t solve(BoardT& board, Player<T>* players, unordered_map<uint64_t, int8_t>& solved) {
+        uint64_t key = board.position_key();
+        auto it = solved.find(key);
+        if (it != solved.end()) return it->second;
+
+        Player<T>* mover = &players[board.get_n_moves() % 2];
+        MoveList<T> moves;
+        board.generate_moves(mover->get_symbol(), moves);
+
+        int best = moves.empty() ? 0 : -WIN - 1;
+        for (const Move<T>& m : moves) {
+            if (!board.make_move(m)) continue;
+            int v;
+            switch (check_result(&board, mover)) {
+                case GameResult::WIN:  v = WIN; break;
+                case GameResult::LOSE: v = -WIN; break;
+                case GameResult::DRAW: v = 0; break;
+                default: v = back_up(solve(board, players, solved)); break;
+            }
+            board.unmake_move();
+            best = max(best, v);
+        }
+        if (best < -WIN) best = 0;
+        solved[key] = static_cast<int8_t>(best);
+        return static_cast<int8_t>(best);
+    }
+};
+
+/**
+ * @brief Player that plays perfectly by table lookup (PlayerType::AI).
+ *
+ * @tparam T Type of symbol placed on the board.
+ * @tparam BoardT Concrete board type with an exact position_key().
+ *
+ * The first Perfect_Player of a board type solves the table (see
+ * Perfect_Table); later players and moves reuse it. Among equally good moves
+ * the first in generate_moves() order is played. A lookup takes no time,
+ * so the Searcher time budget is not used.
+ */
+template <typename T, typename BoardT>
+class Perfect_Player : public Searcher<T> {
+public:
+    /**
+     * @brief Construct a perfect player.
+     * @param name Player name.
+     * @param symbol Symbol the player places.
+     * @param first Symbol of the player who moves first in this game.
+     * @param second Symbol of the player who moves second.
+     */
+    Perfect_Player(string name, T symbol, T first, T second)
+        : Searcher<T>(name, symbol), table(Perfect_Table<T, BoardT>::instance(first, second)) {}
+
+    /**
+     * @brief The best move on the current board, found by table lookups.
+     * @return The move for this player, or a move at (-1, -1) if the board
+     *         offers no moves.
+     *
+     * Positions missing from the table (which cannot arise in a normal game)
+     * count as draws. Like AI_Player, the candidates are played on the real
+     * board and taken back, so no board is copied.
+     */
+    Move<T> choose_move() override {
+        BoardT& board = *static_cast<BoardT*>(this->get_board_ptr());
+        MoveList<T> moves;
+        board.generate_moves(this->get_symbol(), moves);
+
+        Move<T> best(-1, -1, this->get_symbol());
+        int best_value = INT32_MIN;
+        for (const Move<T>& m : moves) {
+            int v = table.move_value(board, m);
+            if (v == Perfect_Table<T, BoardT>::UNKNOWN) v = 0;
+            if (v > best_value) {
+                best_value = v;
+                best = m;
+            }
+        }
+        return best;
+    }
+
+    /** @brief The shared table this player reads. */
+    const Perfect_Table<T, BoardT>& get_table() const { return table; }
+
+private:
+    const Perfect_Table<T, BoardT>& table; ///< Solved values, shared by all players of the board type
+};
+
+#endif // _PERFECT_PLAYER_H
@@ -2,13 +2,26 @@
 #include <iomanip>
 #include <cctype>
 #include "Pyramid_Tic_Tac_Toe.h"
+#include "Searcher.h"
 
 using namespace std;
 
+using Pyramid_Cells = Pyramid_XO_Board::Layout;
+
+/** @brief The 7 winning lines of the pyramid, as masks of the grid cells r * 5 + c. */
+static constexpr uint16_t PYRAMID_LINES[7] = {
+    Pyramid_Cells::mask_of(6, 7, 8),                                     // middle row
+    Pyramid_Cells::mask_of(10, 11, 12), Pyramid_Cells::mask_of(11, 12, 13),
+    Pyramid_Cells::mask_of(12, 13, 14),                                  // base row
+    Pyramid_Cells::mask_of(2, 7, 12),                                    // centre column
+    Pyramid_Cells::mask_of(2, 8, 14), Pyramid_Cells::mask_of(2, 6, 10)   // diagonals from the apex
+};
+
 //--------------------------------------- X_O_Board Implementation
 
-Pyramid_XO_Board::Pyramid_XO_Board() : Board(3, 5) {
-    // Initialize all cells with blank_symbol
+Pyramid_XO_Board::Pyramid_XO_Board() {
+    set_symmetry(Symmetry::MIRROR);
+    // Initialize all cells with blank_symbol; ShapedBoard has marked the dead ones
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
@@ -19,56 +32,75 @@ bool Pyramid_XO_Board::update_board(Move<char>* move) {
     int y = move->get_y();
     char mark = move->get_symbol();
 
-    // Validate move and apply if valid
-    if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
-        (board[x][y] == blank_symbol || mark == 0)) {
+    int bit = cell_index(x, y);
 
+    // Validate move and apply if valid
+    if (bit >= 0 && (board[x][y] == blank_symbol || mark == 0)) {
         if (mark == 0) { // Undo move
             n_moves--;
-            board[x][y] = blank_symbol;
+            if (side_of(board[x][y]) >= 0) stones[side_of(board[x][y])] &= ~(1u << bit);
+            set_cell(x, y, blank_symbol);
+            winner = 0;
         }
         else {         // Apply move
+            char sym = toupper(mark);
             n_moves++;
-            board[x][y] = toupper(mark);
+            set_cell(x, y, sym);
+            if (side_of(sym) >= 0) stones[side_of(sym)] |= 1u << bit;
+            // Only lines through the new mark can have been completed
+            winner = line_through(bit, sym) ? sym : 0;
         }
         return true;
     }
     return false;
 }
 
-bool Pyramid_XO_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-        };
+uint16_t Pyramid_XO_Board::cells_of(char sym) const {
+    if (side_of(sym) >= 0) return stones[side_of(sym)];
+    uint16_t mask = 0;
+    for (int i = 0; i < PLAYABLE_CELLS; ++i)
+        if (board.data()[Layout::GRID[i]] == sym) mask |= 1u << i;
+    return mask;
+}
 
-    // Check rows and columns
-    if ((all_equal(board[1][1], board[1][2], board[1][3]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][2], board[2][2]) && board[0][2] == sym))
-        return true;
-    for (int i = 0; i < 3; i++) {
-        if (all_equal(board[2][i], board[2][i+1], board[2][i+2]) && board[2][i] == sym)
+bool Pyramid_XO_Board::line_through(int bit, char sym) const {
+    uint16_t mine = cells_of(sym);
+    for (uint16_t line : PYRAMID_LINES)
+        if ((line >> bit & 1) && (mine & line) == line)
             return true;
-    }
+    return false;
+}
 
+void Pyramid_XO_Board::save_state() {
+    push_state(winner);
+    push_state(stones);
+}
 
-    // Check diagonals
-    if ((all_equal(board[0][2], board[1][3], board[2][4]) && board[0][2] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
+void Pyramid_XO_Board::restore_state() {
+    pop_state(stones);
+    pop_state(winner);
+}
 
-    return false;
+bool Pyramid_XO_Board::is_win(Player<char>* player) {
+    return winner != 0 && winner == player->get_symbol();
 }
 
 bool Pyramid_XO_Board::is_draw(Player<char>* player) {
-    return (n_moves == 9 && !is_win(player));
+    return (n_moves == 9 && winner == 0);
 }
 
 bool Pyramid_XO_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+void Pyramid_XO_Board::generate_moves(char symbol, MoveList<char>& moves) {
+    generate_placements(blank_symbol, symbol, moves);
+}
+
+uint64_t Pyramid_XO_Board::position_key() const {
+    return shape_key(blank_symbol, 'X');
+}
+
 //--------------------------------------- XO_UI Implementation
 
 Pyramid_XO_UI::Pyramid_XO_UI() : UI<char>("Weclome to FCAI X-O Game by Dr El-Ramly", 3) {}
@@ -81,24 +113,26 @@ Player<char>* Pyramid_XO_UI::create_player(string& name, char symbol, PlayerType
     return new Player<char>(name, symbol, type);
 }
 
-Move<char>* Pyramid_XO_UI::get_move(Player<char>* player) {
-    int x, y;
+Move<char> Pyramid_XO_UI::next_move(Player<char>* player) {
+    int x = -1, y = -1;
 
     if (player->get_type() == PlayerType::HUMAN) {
         cout << "\nPlease enter your move x and y (0 to 2): ";
         cin >> x >> y;
-        while ((x == 0 && y != 2) || (x == 1 && (y == 0 || y == 4))) {
+        while (!player->get_board_ptr()->is_playable(x, y)) {
             cout<<"\nInvalid Move! Please enter your move x and y: ";
             cin >> x >> y;
         }
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
-        while ((x == 0 && y != 2) || (x == 1 && (y == 0 || y == 4))) {
-            x = rand() % player->get_board_ptr()->get_rows();
-            y = rand() % player->get_board_ptr()->get_columns();
-        }
+        return computer_move(player);
     }
-    return new Move<char>(x, y, player->get_symbol());
+    else if (player->get_type() == PlayerType::AI) {
+        return static_cast<Searcher<char>*>(player)->choose_move();
+    }
+    return Move<char>(x, y, player->get_symbol());
+}
+
+Move<char> Pyramid_XO_UI::computer_move(Player<char>* player) {
+    return random_move(player->get_board_ptr(), player->get_symbol());
 }
@@ -32,8 +32,16 @@
 #define PYRAMID_TIC_TAC_TOE_H
 
 #include "BoardGame_Classes.h"
+#include "FixedBoard.h"
 using namespace std;
 
+/**
+ * @brief The pyramid inside its 3x5 grid: row r spans columns 2 - r .. 2 + r.
+ */
+struct Pyramid_Shape {
+    static constexpr bool playable(int r, int c) { return (c > 2 ? c - 2 : 2 - c) <= r; }
+};
+
 /**
  * @class Pyramid_XO_Board
  * @brief Game board implementation for Pyramid Tic-Tac-Toe
@@ -53,10 +61,31 @@ using namespace std;
  * - Base provides more positioning options
  * - Winning lines must be identified within the pyramid structure
  * - Some traditional Tic-Tac-Toe strategies don't apply due to shape
+ *
+ * The 9 cells are numbered by ShapedBoard's Layout (apex 0, base 4-8), and
+ * the cells of 'X' and 'O' and the 7 winning lines are 9-bit masks over
+ * those numbers.
  */
-class Pyramid_XO_Board : public Board<char> {
+class Pyramid_XO_Board final : public ShapedBoard<char, 3, 5, Pyramid_Shape> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
+    char winner = 0;         ///< Symbol whose last move completed a line, or 0
+    uint16_t stones[2] = { 0, 0 }; ///< Cells of 'X' (index 0) and 'O' (index 1), by Layout number
+
+    /** @brief Index of a symbol in stones: 0 for 'X', 1 for 'O', -1 for any other symbol. */
+    static int side_of(char sym) { return sym == 'X' ? 0 : sym == 'O' ? 1 : -1; }
+
+    /** @brief Cells holding sym, by Layout number. */
+    uint16_t cells_of(char sym) const;
+
+    /** @brief True if a line through playable cell bit holds sym in every cell. */
+    bool line_through(int bit, char sym) const;
+
+    /** @brief Save the cached outcome and the stone masks before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override;
 
 public:
     /**
@@ -66,7 +95,7 @@ public:
      * Constructs a board with 3 rows and 5 columns, but only specific cells
      * are valid for the pyramid structure:
      * - Initializes all cells with the blank symbol
-     * - Sets up the pyramid configuration
+     * - Sets up the pyramid configuration as the board's valid-cell mask
      * - Prepares win-checking logic for the pyramid shape
      */
     Pyramid_XO_Board();
@@ -106,6 +135,8 @@ public:
      *
      * The win-checking logic is adapted for the non-rectangular board shape,
      * considering only valid cell combinations within the pyramid.
+     * update_board() checks the lines through each new mark, so this only
+     * reads its result.
      *
      * @note Winning patterns differ from standard 3x3 Tic-Tac-Toe due to pyramid shape
      */
@@ -155,6 +186,18 @@ public:
      * @note Should be called after each move to check game status
      */
     bool game_is_over(Player<char>* player);
+
+    /**
+     * @brief Lists every empty cell of the pyramid
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
+     */
+    void generate_moves(char symbol, MoveList<char>& moves);
+
+    /**
+     * @brief Exact key: a base-3 digit for each of the 9 pyramid cells
+     */
+    uint64_t position_key() const override;
 };
 
 
@@ -225,7 +268,7 @@ public:
      * @brief Retrieves the next move from a player
      *
      * @param player Pointer to the player whose move is being requested
-     * @return A pointer to a new `Move<char>` object representing the player's action
+     * @return A `Move<char>` representing the player's action
      *
      * @details
      * For human players, prompts for row and column coordinates.
@@ -243,14 +286,21 @@ public:
      * - Row 2: Columns 0, 1, 2, 3, or 4
      *
      * @note Re-prompts if invalid position or occupied cell is selected
-     * @warning Caller is responsible for deallocating the returned Move object
      */
-    virtual Move<char>* get_move(Player<char>* player);
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Picks a random empty pyramid cell for a computer player
+     *
+     * @param player Pointer to the player whose move is being requested
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if there is none
+     */
+    static Move<char> computer_move(Player<char>* player);
 
     /**
      * @brief Displays the pyramid-shaped game board
      *
-     * @param matrix Constant reference to a 2D vector representing the board state
+     * @param matrix Read-only view of the board, with the pyramid as its valid-cell mask
      *
      * @details
      * Creates a visual representation of the pyramid board structure:
@@ -276,17 +326,17 @@ public:
      * - Row 0: Only column 2 displayed with borders
      * - Row 1: Columns 1-3 displayed with borders
      * - Row 2: All columns 0-4 displayed with borders
-     * - Invalid positions shown as blank spaces
+     * - Invalid positions (per the view's mask) shown as blank spaces
      * - Uses cell_width for consistent spacing
      *
      * @note This is a const method and does not modify the board
      * @note Empty check prevents crashes on uninitialized boards
      */
-    void display_board_matrix(const vector<vector<char>>& matrix) const override {
-        if (matrix.empty() || matrix[0].empty()) return;
+    void display_board_matrix(const BoardView<char>& matrix) const override {
+        if (matrix.get_rows() == 0 || matrix.get_columns() == 0) return;
 
-        int rows = matrix.size();
-        int cols = matrix[0].size();
+        int rows = matrix.get_rows();
+        int cols = matrix.get_columns();
 
         cout << "\n    ";
         for (int j = 0; j < cols; ++j)
@@ -295,23 +345,15 @@ public:
 
         for (int i = 0; i < rows; ++i) {
             cout << setw(2) << i;
-            if (i == 2)
-                cout << " |";
             for (int j = 0; j < cols; ++j)
-                if (i == 0 && j == 2) {
-                    cout << " |" << setw(cell_width) << matrix[i][j] << " |";
-                }
-                else if (i == 1 && j == 1) {
-                    cout << " |" << setw(cell_width) << matrix[i][j] << " |";
-                }
-                else if (i == 1 && (j == 2 || j == 3)) {
-                    cout << setw(cell_width) << matrix[i][j] << " |";
-                }
-                else if (i == 2) {
-                    cout << setw(cell_width) << matrix[i][j] << " |";
+                if (!matrix.is_valid(i, j)) {
+                    cout << setw(cell_width) << "     ";
                 }
                 else {
-                    cout << setw(cell_width) << "     ";
+                    // The left border opens each run of pyramid cells
+                    if (j == 0 || !matrix.is_valid(i, j - 1))
+                        cout << " |";
+                    cout << setw(cell_width) << matrix(i, j) << " |";
                 }
 
             cout << "\n   " << string((cell_width + 2) * cols, '-') << "\n";
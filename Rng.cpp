@@ -0,0 +1,33 @@
+#include <atomic>
+#include "Rng.h"
+
+using namespace std;
+
+namespace {
+    atomic<uint64_t> master{ 0x2545F4914F6CDD1Dull }; ///< Master seed until seed_random() is called
+    atomic<uint64_t> next_stream{ 0 };                ///< Stream of the next thread to draw
+}
+
+void seed_random(uint64_t seed) {
+    master.store(seed);
+    Rng& rng = thread_rng();
+    next_stream.store(1);
+    rng = stream_rng(0);
+}
+
+uint64_t random_seed() {
+    return master.load();
+}
+
+Rng stream_rng(uint64_t stream) {
+    return Rng(master.load() ^ Rng::mix(stream + 0x9E3779B97F4A7C15ull));
+}
+
+Rng& thread_rng() {
+    static thread_local Rng rng = stream_rng(next_stream.fetch_add(1));
+    return rng;
+}
+
+void set_thread_stream(uint64_t stream) {
+    thread_rng() = stream_rng(stream);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file Rng.h
+ * @brief Seedable, thread-safe random number streams for the whole hub.
+ *
+ * Every random decision (computer moves, obstacles, playouts) draws from an
+ * Rng, a xoshiro256** generator. Generators are never shared between
+ * threads: each thread owns one (thread_rng()), and any other consumer gets
+ * its own stream with stream_rng(). All streams are derived from a single
+ * master seed, so a run started with seed_random(s) can be repeated
+ * bit for bit.
+ */
+
+#ifndef _RNG_H
+#define _RNG_H
+
+#include <cstdint>
+using namespace std;
+
+/**
+ * @brief xoshiro256** pseudo-random generator.
+ *
+ * Fast, 32 bytes of state and trivially copyable, so boards can keep one
+ * and save it with their undo state. Satisfies UniformRandomBitGenerator,
+ * so it also works with the standard distributions.
+ */
+class Rng {
+public:
+    using result_type = uint64_t;
+
+    /** @brief Construct a generator from a seed (expanded with splitmix64). */
+    explicit Rng(uint64_t seed = 0) { this->seed(seed); }
+
+    /** @brief Restart the generator from a seed. */
+    void seed(uint64_t seed) {
+        for (uint64_t& word : s) {
+            seed += 0x9E3779B97F4A7C15ull;
+            word = mix(seed);
+        }
+    }
+
+    /** @brief Next 64 random bits. */
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    result_type operator()() { return next(); }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    /**
+     * @brief Uniform integer in [0, n), without modulo bias.
+     * @param n Number of outcomes; must be positive.
+     */
+    uint32_t below(uint32_t n) {
+        uint64_t m = (next() >> 32) * n;
+        if (uint32_t(m) < n) {
+            uint32_t threshold = uint32_t(-n) % n;
+            while (uint32_t(m) < threshold)
+                m = (next() >> 32) * n;
+        }
+        return uint32_t(m >> 32);
+    }
+
+    /** @brief Uniform double in [0, 1). */
+    double uniform() { return (next() >> 11) * 0x1.0p-53; }
+
+    /** @brief splitmix64 finalizer, used to turn seeds and stream numbers into state. */
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t s[4]; ///< Generator state
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+/**
+ * @brief Set the master seed every stream is derived from.
+ *
+ * Restarts the calling thread's generator as stream 0; threads that first
+ * draw afterwards take streams 1, 2, ... in the order they start. Call it
+ * before starting worker threads.
+ */
+void seed_random(uint64_t master);
+
+/** @brief The current master seed. */
+uint64_t random_seed();
+
+/**
+ * @brief An independent generator for a numbered stream of the master seed.
+ * @param stream Stream number, e.g. a game or worker index
+ */
+Rng stream_rng(uint64_t stream);
+
+/** @brief The calling thread's generator. */
+Rng& thread_rng();
+
+/**
+ * @brief Restart the calling thread's generator as a given stream.
+ *
+ * Workers that call this before each unit of work (e.g. with the game
+ * number) give the same results however the work is spread over threads.
+ */
+void set_thread_stream(uint64_t stream);
+
+#endif // _RNG_H
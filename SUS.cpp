@@ -6,6 +6,7 @@ using namespace std;
 //--------------------------------------- SUS_Board Implementation
 
 SUS_Board::SUS_Board() : Board(3, 3) {
+    set_symmetry(Symmetry::SQUARE);
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
@@ -22,14 +23,14 @@ bool SUS_Board::update_board(Move<char>* move) {
         if (mark == 0)
         {
             n_moves--;
-            board[x][y] = blank_symbol;
+            set_cell(x, y, blank_symbol);
         }
         else
         {
             last_row_play = x;
             last_col_play = y;
             n_moves++;
-            board[x][y] = toupper(mark);
+            set_cell(x, y, toupper(mark));
             condition(x, y, toupper(mark));
         }
         return true;
@@ -37,6 +38,20 @@ bool SUS_Board::update_board(Move<char>* move) {
     return false;
 }
 
+void SUS_Board::save_state() {
+    push_state(count1);
+    push_state(count2);
+    push_state(last_row_play);
+    push_state(last_col_play);
+}
+
+void SUS_Board::restore_state() {
+    pop_state(last_col_play);
+    pop_state(last_row_play);
+    pop_state(count2);
+    pop_state(count1);
+}
+
 bool SUS_Board::is_win(Player<char>* player) {
     if (n_moves == 9)
     {
@@ -63,11 +78,20 @@ bool SUS_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player) || is_lose(player);
 }
 
+void SUS_Board::generate_moves(char symbol, MoveList<char>& moves) {
+    generate_placements(blank_symbol, symbol, moves);
+}
+
+uint64_t SUS_Board::position_key() const {
+    // 19683 = 3^9 cell encodings; each score is at most 8
+    return base3_key(blank_symbol, 'S') + 19683 * uint64_t(count1 * 9 + count2);
+}
+
 
 
 Player<char>** SUS_UI::setup_players() {
     Player<char>** players = new Player<char>*[2];
-    vector<string> type_options = { "Human", "Computer" };
+    vector<string> type_options = player_type_options();
 
     string nameX = get_player_name("Player 1");
     PlayerType typeX = get_player_type_choice("Player 1", type_options);
@@ -81,13 +105,19 @@ Player<char>** SUS_UI::setup_players() {
 
 Player<char>* SUS_UI::create_player(string& name, char symbol, PlayerType type)
 {
-    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
+    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : type == PlayerType::AI ? "AI" : "computer")
         << " player: " << name << " (" << symbol << ")\n";
 
+    if (type == PlayerType::AI)
+        return new Perfect_Player<char, SUS_Board>(name, symbol, 'S', 'U');
     return new Player<char>(name, symbol, type);
 }
 
-Move<char>* SUS_UI::get_move(Player<char>* player)
+vector<string> SUS_UI::player_type_options() const {
+    return { "Human", "Computer", "AI" };
+}
+
+Move<char> SUS_UI::next_move(Player<char>* player)
 {
     int x, y;
 
@@ -104,10 +134,16 @@ Move<char>* SUS_UI::get_move(Player<char>* player)
         }
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
+        return computer_move(player);
     }
-    return new Move<char>(x, y, player->get_symbol());
+    else if (player->get_type() == PlayerType::AI) {
+        return static_cast<Searcher<char>*>(player)->choose_move();
+    }
+    return Move<char>(x, y, player->get_symbol());
+}
+
+Move<char> SUS_UI::computer_move(Player<char>* player) {
+    return random_move(player->get_board_ptr(), player->get_symbol());
 }
 
 void SUS_Board::condition(int x, int y, char symbol) {
@@ -11,6 +11,7 @@
 #ifndef SUS_H
 #define SUS_H
 #include "BoardGame_Classes.h"
+#include "Perfect_Player.h"
 using namespace std;
 
 /**
@@ -20,7 +21,7 @@ using namespace std;
  * This class manages the SUS game board state, tracking player scores
  * as they form the word "SUS" horizontally, vertically, or diagonally.
  */
-class SUS_Board : public Board<char> {
+class SUS_Board final : public Board<char> {
 private:
     char blank_symbol = '.';  ///< Symbol used to represent empty cells on the board
     int last_row_play = 0;    ///< Row coordinate of the last played move
@@ -28,6 +29,12 @@ private:
     int count1 = 0;           ///< Score counter for player 1
     int count2 = 0;           ///< Score counter for player 2
 
+    /** @brief Save the scores and last move before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override;
+
 public:
     /**
      * @brief Default constructor for SUS_Board
@@ -73,6 +80,20 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+
+    /**
+     * @brief Lists every empty cell.
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
+     */
+    void generate_moves(char symbol, MoveList<char>& moves) override;
+
+    /**
+     * @brief Exact key: the base-3 cells (S is 1, U is 2) and both scores.
+     *
+     * Scores depend on who completed each line, not only on the cells.
+     */
+    uint64_t position_key() const override;
     /**
      * @brief Checks for "SUS" formations after a move
      * @param x Row coordinate to check from
@@ -123,13 +144,25 @@ public:
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type) override;
 
+    /**
+     * @brief Offers Human, Computer and AI (perfect play) players
+     */
+    vector<string> player_type_options() const override;
+
     /**
      * @brief Gets a move from the specified player
      * @param player Pointer to the Player making the move
-     * @return Pointer to a Move object containing the player's chosen move
+     * @return A Move containing the player's chosen move
      *
      * Prompts the player for their move (position and letter S or U) and validates input.
      */
-    Move<char>* get_move(Player<char>* player) override;
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Picks a random legal move for a computer player.
+     * @param player Pointer to the player whose move is being requested
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if there is none
+     */
+    static Move<char> computer_move(Player<char>* player);
 };
 #endif
\ No newline at end of file
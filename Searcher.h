@@ -0,0 +1,60 @@
+/**
+ * @file Searcher.h
+ * @brief Common interface of the computer players that search for their move.
+ *
+ * AI_Player (alpha-beta), MCTS_Player and Perfect_Player all derive from
+ * Searcher<T>. A UI or the game loop can then ask any of them for a move
+ * and give it a time budget without knowing which search it runs. The
+ * boards only supply generate_moves() and, for AI_Player, evaluate().
+ */
+
+#ifndef _SEARCHER_H
+#define _SEARCHER_H
+
+#include "BoardGame_Classes.h"
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief A PlayerType::AI player that chooses its own moves.
+ *
+ * @tparam T Type of symbol placed on the board.
+ */
+template <typename T>
+class Searcher : public Player<T> {
+public:
+    /**
+     * @brief Construct a search player.
+     * @param name Player name.
+     * @param symbol Symbol the player places.
+     */
+    Searcher(string name, T symbol) : Player<T>(name, symbol, PlayerType::AI) {}
+
+    /**
+     * @brief Search the current board and return the move to play.
+     * @return The move for this player, or a move at (-1, -1) if the board
+     *         offers no moves.
+     */
+    virtual Move<T> choose_move() = 0;
+
+    /**
+     * @brief Set the wall-clock budget of each move in milliseconds; 0 for none.
+     *
+     * A search with a budget returns the best move it has when the time is
+     * up. Searches that never take long (table lookups) ignore it.
+     */
+    virtual void set_think_ms(int ms) { think_ms = max(ms, 0); }
+
+    /** @brief Wall-clock budget of each move in milliseconds, 0 for none. */
+    int get_think_ms() const { return think_ms; }
+
+protected:
+    int think_ms = 0; ///< Budget of each move in milliseconds, 0 for none
+
+    /** @brief When a search started at start has to stop. */
+    chrono::steady_clock::time_point deadline_from(chrono::steady_clock::time_point start) const {
+        return start + chrono::milliseconds(think_ms);
+    }
+};
+
+#endif // _SEARCHER_H
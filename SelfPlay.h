@@ -0,0 +1,395 @@
+/**
+ * @file SelfPlay.h
+ * @brief Headless, multi-threaded self-play runner built on the board framework.
+ *
+ * GameManager drives a game through a UI object: it prints the board after
+ * every move and blocks on the console for human input. SelfPlayRunner plays
+ * the same game loop without any console I/O, so large numbers of
+ * computer-vs-computer games can be generated for testing and training data.
+ *
+ * Every game owns a fresh board created by a factory, and every worker thread
+ * owns its players, so workers share no game state. Game number i of a batch
+ * draws its random decisions from stream i of the master seed (see
+ * Rng.h), so a batch gives the same results on any number of threads.
+ * Games can be appended to a record file (GameRecord.h) as they finish.
+ *
+ * run_batched() instead keeps many games of each worker live in lockstep and
+ * asks a batch policy for the moves of all of them at once, so a policy can
+ * evaluate the whole batch in one pass (see Batch3x3.h).
+ */
+
+#ifndef _SELF_PLAY_H
+#define _SELF_PLAY_H
+
+#include "BoardGame_Classes.h"
+#include <functional>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Win/draw/loss tally and throughput of a batch of headless games.
+ *
+ * Wins and losses are counted from the first player's point of view.
+ */
+struct SelfPlayStats {
+    long long games = 0;        ///< Games played (finished or aborted)
+    long long first_wins = 0;   ///< Games won by the first player
+    long long second_wins = 0;  ///< Games won by the second player
+    long long draws = 0;        ///< Drawn games
+    long long aborted = 0;      ///< Games stopped by the ply or retry limit
+    long long plies = 0;        ///< Moves accepted by the boards
+    long long rejected = 0;     ///< Moves rejected by update_board
+    double seconds = 0;         ///< Wall-clock time of the batch
+
+    /** @brief Number of games finished per wall-clock second. */
+    double games_per_second() const {
+        return seconds > 0 ? games / seconds : 0;
+    }
+
+    /** @brief Add the counters of another batch (time is not summed). */
+    void merge(const SelfPlayStats& other) {
+        games += other.games;
+        first_wins += other.first_wins;
+        second_wins += other.second_wins;
+        draws += other.draws;
+        aborted += other.aborted;
+        plies += other.plies;
+        rejected += other.rejected;
+    }
+};
+
+/**
+ * @brief Plays computer-vs-computer games without a UI.
+ *
+ * @tparam T Type of symbol used on the board.
+ * @tparam B Board type played. Naming the concrete (final) board class lets
+ *         the game loop call update_board() and the result checks directly;
+ *         the default Board<T> plays any board through its vtable.
+ *
+ * A game follows exactly the GameManager loop: players alternate, a rejected
+ * move is requested again, and after each accepted move the result is taken
+ * from check_result() for the player who moved.
+ *
+ * Usage:
+ * @code
+ * SelfPlayRunner<char> runner(
+ *     [] { return new CONNECT_Board(); },
+ *     CONNECT_UI::computer_move, CONNECT_UI::computer_move, 'X', 'O');
+ * SelfPlayStats stats = runner.run(1000, 4); // 1000 games on each of 4 threads
+ * @endcode
+ */
+template <typename T, typename B = Board<T>>
+class SelfPlayRunner {
+public:
+    /** @brief Creates a fresh board for one game; the runner takes ownership. */
+    using BoardFactory = function<B*()>;
+
+    /**
+     * @brief Chooses the next move of a player, returned by value.
+     *
+     * Policies are called concurrently from all worker threads, so they must
+     * not keep shared mutable state. Any UI's static computer_move() fits,
+     * since none touches the console (see random_move()).
+     */
+    using MovePolicy = function<Move<T>(Player<T>*)>;
+
+    /**
+     * @brief Chooses the moves of many games in one call.
+     *
+     * moves[k] receives the move of players[k], whose random decisions are
+     * drawn from rngs[k], so a game's moves do not depend on the other games
+     * of the batch. Called concurrently from all worker threads.
+     */
+    using BatchPolicy = function<void(Player<T>* const* players, Rng* rngs, size_t n, Move<T>* moves)>;
+
+    /**
+     * @brief Construct a runner for one game variant.
+     * @param factory Creates the board of each game.
+     * @param first Policy of the player who moves first.
+     * @param second Policy of the player who moves second.
+     * @param first_symbol Symbol of the first player.
+     * @param second_symbol Symbol of the second player.
+     */
+    SelfPlayRunner(BoardFactory factory, MovePolicy first, MovePolicy second,
+                   T first_symbol, T second_symbol)
+        : factory(factory), symbols{ first_symbol, second_symbol } {
+        policies[0] = first;
+        policies[1] = second;
+    }
+
+    /**
+     * @brief Set the limits that stop a game which cannot finish.
+     * @param plies Maximum number of accepted moves per game.
+     * @param retries Maximum consecutive rejected moves in a single turn.
+     */
+    void set_limits(int plies, int retries) {
+        max_plies = plies;
+        max_retries = retries;
+    }
+
+    /**
+     * @brief Append every game played, aborted ones included, to a record file.
+     * @param w Writer shared by all worker threads, or nullptr to stop recording
+     * @param variant_id Menu number of the game (see record_variant())
+     */
+    void set_record(GameRecordWriter* w, int variant_id) {
+        writer = w;
+        variant = variant_id;
+    }
+
+    /**
+     * @brief Set the policies run_batched() asks for the moves of all its games.
+     * @param first Batch policy of the player who moves first.
+     * @param second Batch policy of the player who moves second.
+     *
+     * A move the board rejects is asked again from the single-game policy.
+     */
+    void set_batch_policies(BatchPolicy first, BatchPolicy second) {
+        batch_policies[0] = first;
+        batch_policies[1] = second;
+    }
+
+    /**
+     * @brief Play one game on a new board.
+     * @param stats Counters updated with the outcome of the game.
+     * @return Result from the first player's point of view; ONGOING means aborted.
+     */
+    GameResult play_game(SelfPlayStats& stats) const {
+        Player<T> first("Player 1", symbols[0], PlayerType::COMPUTER);
+        Player<T> second("Player 2", symbols[1], PlayerType::COMPUTER);
+        return play_game(stats, &first, &second);
+    }
+
+    /**
+     * @brief Play one game on a new board between two given players.
+     * @param stats Counters updated with the outcome of the game.
+     * @param first Player who moves first; must place the first symbol.
+     * @param second Player who moves second; must place the second symbol.
+     * @return Result from the first player's point of view; ONGOING means aborted.
+     *
+     * The players are pointed at the game's board and handed to the move
+     * policies, so a policy can tell a search player from a random one.
+     */
+    GameResult play_game(SelfPlayStats& stats, Player<T>* first, Player<T>* second) const {
+        unique_ptr<B> board(factory());
+        Player<T>* players[2] = { first, second };
+        first->set_board_ptr(board.get());
+        second->set_board_ptr(board.get());
+
+        // Reused by the thread's games so recording allocates nothing once warm
+        thread_local GameRecord record;
+        GameRecord* recording = nullptr;
+        if (writer && record.start(variant, board->get_seed(), static_cast<char>(symbols[0]), static_cast<char>(symbols[1])))
+            recording = &record;
+
+        GameResult result = GameResult::ONGOING;
+        for (int ply = 0; ply < max_plies && result == GameResult::ONGOING; ++ply) {
+            int i = ply % 2;
+            if (!apply_policy_move(board.get(), i, players[i], stats, recording))
+                break;
+            ++stats.plies;
+            result = result_after(board.get(), i, players[i]);
+        }
+
+        finish_game(stats, result, recording);
+        return result;
+    }
+
+    /**
+     * @brief Play a batch of games spread over worker threads.
+     * @param games_per_thread Number of games each worker plays.
+     * @param threads Number of worker threads (at least one is used).
+     * @return Combined counters and the wall-clock time of the batch.
+     */
+    SelfPlayStats run(int games_per_thread, int threads = thread::hardware_concurrency()) const {
+        threads = max(threads, 1);
+        vector<SelfPlayStats> partial(threads);
+
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back([this, &partial, t, games_per_thread] {
+                for (int g = 0; g < games_per_thread; ++g) {
+                    set_thread_stream(static_cast<uint64_t>(t) * games_per_thread + g);
+                    play_game(partial[t]);
+                }
+            });
+        for (auto& w : workers)
+            w.join();
+
+        SelfPlayStats total;
+        for (auto& p : partial)
+            total.merge(p);
+        total.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return total;
+    }
+
+    /**
+     * @brief Play a batch of games, each worker keeping many of them live in lockstep.
+     * @param games_per_thread Number of games each worker plays.
+     * @param threads Number of worker threads (at least one is used).
+     * @param width Games each worker keeps in play; a finished game is replaced by the next.
+     * @return Combined counters and the wall-clock time of the batch.
+     *
+     * Every step calls each batch policy once, for all the live games where
+     * its player is to move. Game g of worker t still draws from stream
+     * t * games_per_thread + g, so a batch policy that makes the same draws
+     * as the single-game one gives the tallies of run().
+     */
+    SelfPlayStats run_batched(int games_per_thread, int threads = thread::hardware_concurrency(), int width = 256) const {
+        if (!batch_policies[0] || !batch_policies[1])
+            throw runtime_error("run_batched needs batch policies (see set_batch_policies)");
+        threads = max(threads, 1);
+        vector<SelfPlayStats> partial(threads);
+
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back([this, &partial, t, games_per_thread, width] {
+                play_lockstep(t, games_per_thread, width, partial[t]);
+            });
+        for (auto& w : workers)
+            w.join();
+
+        SelfPlayStats total;
+        for (auto& p : partial)
+            total.merge(p);
+        total.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return total;
+    }
+
+private:
+    /** @brief A game of play_lockstep() and the generator its random decisions come from. */
+    struct LiveGame {
+        unique_ptr<B> board;
+        unique_ptr<Player<T>> players[2];
+        Rng rng;
+        int ply = 0;
+        GameRecord record;
+        bool recording = false;
+    };
+
+    BoardFactory factory;     ///< Creates the board of each game
+    MovePolicy policies[2];   ///< Move policy of each player
+    BatchPolicy batch_policies[2]; ///< Batch policy of each player, for run_batched()
+    T symbols[2];             ///< Symbol of each player
+    int max_plies = 1000;     ///< Accepted moves after which a game is aborted
+    int max_retries = 10000;  ///< Rejected moves in one turn after which a game is aborted
+    GameRecordWriter* writer = nullptr; ///< Record file, or nullptr when not recording
+    int variant = 0;          ///< Menu number of the game, for its records
+
+    /**
+     * @brief Ask a policy for moves until the board accepts one.
+     * @param record Receives the accepted move, or nullptr when not recording.
+     * @param first Move to try before asking the policy, or nullptr.
+     * @return false if the retry limit was reached.
+     */
+    bool apply_policy_move(B* board, int i, Player<T>* player, SelfPlayStats& stats, GameRecord* record,
+                           const Move<T>* first = nullptr) const {
+        for (int attempt = 0; attempt <= max_retries; ++attempt) {
+            Move<T> move = attempt == 0 && first ? *first : policies[i](player);
+            Move<T> submitted = move;
+            if (board->update_board(&move)) {
+                if (record) record->add(submitted.get_x(), submitted.get_y(), static_cast<char>(submitted.get_symbol()),
+                                        submitted.get_from_x(), submitted.get_from_y());
+                return true;
+            }
+            ++stats.rejected;
+        }
+        return false;
+    }
+
+    /** @brief Result of a game after player i has moved, from the first player's point of view. */
+    GameResult result_after(B* board, int i, Player<T>* mover) const {
+        GameResult result = check_result(board, mover);
+        if (i == 1 && result == GameResult::WIN) result = GameResult::LOSE;
+        else if (i == 1 && result == GameResult::LOSE) result = GameResult::WIN;
+        return result;
+    }
+
+    /** @brief Count a finished or aborted game and write its record. */
+    void finish_game(SelfPlayStats& stats, GameResult result, GameRecord* record) const {
+        ++stats.games;
+        switch (result) {
+            case GameResult::WIN:  ++stats.first_wins; break;
+            case GameResult::LOSE: ++stats.second_wins; break;
+            case GameResult::DRAW: ++stats.draws; break;
+            default:               ++stats.aborted; break;
+        }
+        if (record) {
+            record->result = static_cast<uint8_t>(result);
+            writer->write(*record);
+        }
+    }
+
+    /** @brief Start game number `started` of worker t in a slot; false once all have started. */
+    bool start_game(LiveGame& game, int t, int games_per_thread, int& started) const {
+        if (started == games_per_thread) return false;
+        set_thread_stream(static_cast<uint64_t>(t) * games_per_thread + started++);
+        game.board.reset(factory());
+        for (int i = 0; i < 2; ++i) {
+            if (!game.players[i])
+                game.players[i].reset(new Player<T>(i == 0 ? "Player 1" : "Player 2", symbols[i], PlayerType::COMPUTER));
+            game.players[i]->set_board_ptr(game.board.get());
+        }
+        game.ply = 0;
+        game.recording = writer && game.record.start(variant, game.board->get_seed(), static_cast<char>(symbols[0]),
+                                                     static_cast<char>(symbols[1]));
+        game.rng = thread_rng();
+        return true;
+    }
+
+    /** @brief The games of worker t for run_batched(), up to width at a time. */
+    void play_lockstep(int t, int games_per_thread, int width, SelfPlayStats& stats) const {
+        vector<LiveGame> games(max(1, min(width, games_per_thread)));
+        vector<LiveGame*> live;
+        int started = 0;
+        for (LiveGame& game : games)
+            if (start_game(game, t, games_per_thread, started)) live.push_back(&game);
+
+        vector<LiveGame*> movers;
+        vector<Player<T>*> players;
+        vector<Rng> rngs;
+        vector<Move<T>> moves;
+        while (!live.empty()) {
+            for (int i = 0; i < 2; ++i) {
+                movers.clear();
+                players.clear();
+                rngs.clear();
+                for (LiveGame* game : live)
+                    if (game->board && game->ply % 2 == i) {
+                        movers.push_back(game);
+                        players.push_back(game->players[i].get());
+                        rngs.push_back(game->rng);
+                    }
+                if (movers.empty()) continue;
+                moves.assign(movers.size(), Move<T>());
+                batch_policies[i](players.data(), rngs.data(), movers.size(), moves.data());
+
+                for (size_t k = 0; k < movers.size(); ++k) {
+                    LiveGame& game = *movers[k];
+                    // Retries and the board draw from the game's own generator
+                    thread_rng() = rngs[k];
+                    GameRecord* recording = game.recording ? &game.record : nullptr;
+                    GameResult result = GameResult::ONGOING;
+                    bool moved = apply_policy_move(game.board.get(), i, players[k], stats, recording, &moves[k]);
+                    if (moved) {
+                        ++stats.plies;
+                        result = result_after(game.board.get(), i, players[k]);
+                    }
+                    game.rng = thread_rng();
+                    if (!moved || result != GameResult::ONGOING || ++game.ply >= max_plies) {
+                        finish_game(stats, result, recording);
+                        if (!start_game(game, t, games_per_thread, started)) game.board.reset();
+                    }
+                }
+            }
+            live.erase(remove_if(live.begin(), live.end(), [](LiveGame* game) { return !game->board; }), live.end());
+        }
+    }
+};
+
+#endif // _SELF_PLAY_H
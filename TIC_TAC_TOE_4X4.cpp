@@ -1,11 +1,14 @@
 #include <iostream>
 #include <iomanip>
 #include <cctype>
+#include <cstdlib>
+#include <limits>
 #include "TIC_TAC_TOE_4X4.h"
 
 using namespace std;
 
-XO_4x4_Board::XO_4x4_Board() : Board(4, 4) {
+XO_4x4_Board::XO_4x4_Board() {
+    set_symmetry(Symmetry::SQUARE);
 
     for (int i = 0; i < 4; i++) {
         for (int j = 0; j < 4; j++) {
@@ -23,64 +26,34 @@ XO_4x4_Board::XO_4x4_Board() : Board(4, 4) {
 }
 
 bool XO_4x4_Board::update_board(Move<char>* move) {
+    int from_x = move->get_from_x();
+    int from_y = move->get_from_y();
     int x = move->get_x();
     int y = move->get_y();
-    if (move->get_symbol() == board[x][y]) {
-        mark = 0;
-        xold = x;
-        yold = y;
-    }
-    else if (board[x][y] == blank_symbol && mark == 0 && ((x == xold+1 && y == yold) || (x == xold-1 && y == yold)||
-        (y == yold+1 && x == xold) || (y == yold-1 && x == xold))){mark = move->get_symbol();}
-    else {return false;}
+    char symbol = toupper(move->get_symbol());
+    if (from_x < 0 || from_x >= rows || from_y < 0 || from_y >= columns) {return false;}
+    if (x < 0 || x >= rows || y < 0 || y >= columns) {return false;}
+    if (abs(x - from_x) + abs(y - from_y) != 1) {return false;}
+    if (board[from_x][from_y] != symbol || board[x][y] != blank_symbol) {return false;}
+
+    set_cell(from_x, from_y, blank_symbol);
+    set_cell(x, y, symbol);
+    n_moves++;
+    // Only lines through the destination can have been completed
+    winner = has_line_through<3>(x * columns + y, symbol) ? symbol : 0;
+    return true;
+}
 
-    // Validate move and apply if valid
-    if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
-        (board[x][y] == blank_symbol || mark == 0)) {
+void XO_4x4_Board::save_state() {
+    push_state(winner);
+}
 
-        if (mark == 0) { // Undo move
-            n_moves--;
-            board[x][y] = blank_symbol;
-        }
-        else {         // Apply move
-            n_moves++;
-            board[x][y] = toupper(mark);
-        }
-        return true;
-    }
-    return false;
+void XO_4x4_Board::restore_state() {
+    pop_state(winner);
 }
 
 bool XO_4x4_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-        };
-
-    // Check rows and columns
-    for (int j=0; j<2; ++j) {
-        for (int i = 0; i < rows; ++i) {
-            if ((all_equal(board[i][j], board[i][j+1], board[i][j+2]) && board[i][j] == sym) ||
-                (all_equal(board[j][i], board[j+1][i], board[j+2][i]) && board[j][i] == sym))
-                return true;
-        }
-
-    }
-
-
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym) ||
-        (all_equal(board[1][1], board[2][2], board[3][3]) && board[2][2] == sym) ||
-        (all_equal(board[0][1], board[1][2], board[2][3]) && board[1][2] == sym) ||
-        (all_equal(board[1][0], board[2][1], board[3][2]) && board[2][1] == sym) ||
-        (all_equal(board[0][3], board[1][2], board[2][1]) && board[1][2] == sym) ||
-        (all_equal(board[1][2], board[2][1], board[3][0]) && board[2][1] == sym) ||
-        (all_equal(board[1][3], board[2][2], board[3][1]) && board[3][1] == sym))
-        return true;
-
-    return false;
+    return winner != 0 && winner == player->get_symbol();
 }
 
 bool XO_4x4_Board::is_draw(Player<char>* player) {return false;}
@@ -89,40 +62,81 @@ bool XO_4x4_Board::game_is_over(Player<char>* player) {
     return is_win(player);
 }
 
+void XO_4x4_Board::generate_moves(char symbol, MoveList<char>& moves) {
+    const int dx[4] = {1, -1, 0, 0};
+    const int dy[4] = {0, 0, 1, -1};
+    auto is_free = [&](int x, int y) {
+        return x >= 0 && x < rows && y >= 0 && y < columns && board[x][y] == blank_symbol;
+    };
+
+    moves.clear();
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < columns; ++j) {
+            if (board[i][j] != symbol) continue;
+            for (int d = 0; d < 4; ++d)
+                if (is_free(i + dx[d], j + dy[d]))
+                    moves.push(Move<char>(i, j, i + dx[d], j + dy[d], symbol));
+        }
+}
+
+int XO_4x4_Board::evaluate(char symbol) {
+    const char* cells = board.data();
+    int score = 0;
+    for (const auto& line : lines<3>) {
+        int own = 0, opp = 0;
+        for (uint8_t cell : line) {
+            if (cells[cell] == symbol) ++own;
+            else if (cells[cell] != blank_symbol) ++opp;
+        }
+        if (opp == 0) score += own * own;
+        if (own == 0) score -= opp * opp;
+    }
+    return score;
+}
+
 //--------------------------------------- XO_UI Implementation
 
 XO_4x4_UI::XO_4x4_UI() : UI<char>("Weclome to FCAI X-O Game by Dr El-Ramly", 3) {}
 
 Player<char>* XO_4x4_UI::create_player(string& name, char symbol, PlayerType type) {
     // Create player based on type
-    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
+    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : type == PlayerType::AI ? "AI" : "computer")
         << " player: " << name << " (" << symbol << ")\n";
-
+    if (type == PlayerType::AI) {
+        AI_Player<char, XO_4x4_Board>* ai = new AI_Player<char, XO_4x4_Board>(name, symbol, symbol == 'X' ? 'O' : 'X', 12);
+        ai->set_think_ms(1000);
+        return ai;
+    }
     return new Player<char>(name, symbol, type);
 }
 
-Move<char>* XO_4x4_UI::get_move(Player<char>* player) {
-    int x, y;
+vector<string> XO_4x4_UI::player_type_options() const {
+    return { "Human", "Computer", "AI" };
+}
+
+Move<char> XO_4x4_UI::next_move(Player<char>* player) {
+    int from_x = -1, from_y = -1, x = -1, y = -1;
 
     if (player->get_type() == PlayerType::HUMAN) {
         cout << "\nPlease enter x and y you move from (0 to 3): ";
-        cin >> x >> y;
-
-        player->get_board_ptr()->update_board(
-        new Move<char>(x, y, player->get_symbol())
-        );
+        cin >> from_x >> from_y;
 
         cout << "\nPlease enter your move x and y (0 to 3): ";
         cin >> x >> y;
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        }
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
-        player->get_board_ptr()->update_board(
-        new Move<char>(x, y, player->get_symbol())
-        );
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
+        return computer_move(player);
     }
-    return new Move<char>(x, y, player->get_symbol());
+    else if (player->get_type() == PlayerType::AI) {
+        return static_cast<Searcher<char>*>(player)->choose_move();
+    }
+    return Move<char>(from_x, from_y, x, y, player->get_symbol());
+}
+
+Move<char> XO_4x4_UI::computer_move(Player<char>* player) {
+    return random_move(player->get_board_ptr(), player->get_symbol());
 }
\ No newline at end of file
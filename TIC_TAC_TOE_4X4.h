@@ -11,20 +11,22 @@
  * @details
  * Game Rules:
  * - Played on a 4x4 grid (16 cells total)
- * - Players alternate placing X and O marks
+ * - Each player starts with four tokens, alternating along the top and bottom rows
+ * - A turn slides one of the player's tokens to a free orthogonal neighbour
  * - Win by getting three in a row (not four) - horizontal, vertical, or diagonal
- * - If all 16 cells are filled with no three-in-a-row, the game is a draw
+ * - There are no draws; a player with no slide cannot move
  *
  * The 4x4 board creates interesting strategic depth:
  * - More possible winning lines than 3x3
  * - More opportunities for multiple threats
  * - Requires longer-term planning
- * - The xold/yold tracking suggests possible move history or special rules
  */
 
 #ifndef TIC_TAC_TOE_4X4_H
 #define TIC_TAC_TOE_4X4_H
 #include "BoardGame_Classes.h"
+#include "FixedBoard.h"
+#include "AI_Player.h"
 using namespace std;
 
 /**
@@ -38,60 +40,59 @@ using namespace std;
  * @details
  * The board maintains:
  * - A 4x4 grid of cells (16 total positions)
- * - Move validation and placement logic
+ * - Move validation and sliding logic
  * - Win detection for three-in-a-row patterns
- * - Tracking variables (xold, yold, mark) for special game mechanics
  *
  * Winning patterns check:
  * - 4 horizontal rows (each can start at 2 positions for 3-in-a-row)
  * - 4 vertical columns (each can start at 2 positions)
  * - Multiple diagonal lines of length 3+
  *
- * The xold/yold variables (initialized to 4) suggest tracking of:
- * - Previous move positions
- * - Special move restrictions
- * - Turn-based mechanics
+ * A turn is one Move with a source cell (Move::has_from()), so a slide is
+ * applied, searched and undone like any placement and AI_Player can play
+ * the game.
  */
-class XO_4x4_Board : public Board<char> {
+class XO_4x4_Board final : public FixedBoard<char, 4, 4> {
 private:
     char blank_symbol = '.';  ///< Character used to represent an empty cell on the board
-    char mark = 1;            ///< Mark variable for tracking game state or special conditions
-    int xold = 4, yold = 4;   ///< Previous move coordinates (initialized to 4, outside 0-3 range)
+    char winner = 0;          ///< Symbol whose last slide completed a line, or 0
+
+    /** @brief Save the cached outcome before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override;
 
 public:
     /**
      * @brief Constructs a new 4x4 Tic-Tac-Toe board
      *
      * @details
-     * Initializes a 4x4 grid with all cells empty.
-     * Sets up initial state including:
-     * - All 16 cells filled with blank_symbol
+     * Sets up the starting position:
+     * - Row 0 holds O X O X and row 3 holds X O X O
+     * - The middle rows are filled with blank_symbol
      * - Move counter set to zero
-     * - Previous move trackers (xold, yold) initialized to 4 (invalid position)
-     * - Mark variable initialized to 1
      */
     XO_4x4_Board();
 
     /**
-     * @brief Updates the board with a player's move
+     * @brief Slides a player's token
      *
-     * @param move Pointer to Move object containing position and player symbol
-     * @return true if the move was valid and successfully placed; false otherwise
+     * @param move Pointer to a Move from the token's cell to its destination
+     * @return true if the slide was valid and applied; false otherwise
      *
      * @details
-     * Validates and applies a move to the board. A move is valid if:
-     * - Position is within the 4x4 grid boundaries (0-3 for both row and column)
-     * - Target cell is currently empty
-     * - Any special move restrictions are satisfied (based on xold/yold)
+     * A move is valid if:
+     * - It has a source cell holding one of the player's tokens
+     * - The destination is inside the 4x4 grid and empty
+     * - The destination is an orthogonal neighbour of the source
      *
-     * After placing the move:
-     * - Updates the board with the player's symbol
-     * - Updates xold and yold to track this move
+     * After the slide:
+     * - The source cell is empty and the destination holds the token
      * - Increments the move counter
-     * - May update the mark variable
+     * - Checks only the lines through the destination for three in a row
      *
-     * @note The xold/yold tracking suggests possible move-ordering rules
-     * @warning Does not check for game-over conditions
+     * Moves without a source cell are rejected.
      */
     bool update_board(Move<char>* move);
 
@@ -123,6 +124,7 @@ public:
      *
      * @note Win requires exactly three in a row, not four
      * @note More winning patterns than standard 3x3 Tic-Tac-Toe
+     * @note update_board() checks the lines through each placed stone; this reads its result
      */
     bool is_win(Player<char>* player);
 
@@ -171,6 +173,21 @@ public:
      * @note Should be called after each move to determine if gameplay should end
      */
     bool game_is_over(Player<char>* player);
+
+    /**
+     * @brief Lists every slide of a player's tokens to a free orthogonal neighbour
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves, token by token in row order
+     */
+    void generate_moves(char symbol, MoveList<char>& moves);
+
+    /**
+     * @brief Heuristic score of the position for a player
+     * @param symbol The player the score is for
+     * @return Sum over the lines of three the opponent is not on of the square
+     *         of the player's tokens in them, minus the same for the opponent
+     */
+    int evaluate(char symbol);
 };
 
 /**
@@ -178,9 +195,8 @@ public:
  * @brief User interface handler for 4x4 Tic-Tac-Toe game
  *
  * This class manages all user interactions for the 4x4 Tic-Tac-Toe game,
- * handling player setup, move collection, and board display. The UI must
- * accommodate the larger 4x4 grid and potentially more complex move input
- * if special rules based on xold/yold are implemented.
+ * handling player setup, move collection, and board display. A move is
+ * entered as the token's cell and the cell it slides to.
  *
  * @details
  * Key responsibilities:
@@ -188,7 +204,6 @@ public:
  * - Collect player moves with validation
  * - Handle both human and AI player types
  * - Show game status and available moves
- * - Potentially enforce move restrictions based on previous moves
  */
 class XO_4x4_UI : public UI<char> {
 public:
@@ -224,44 +239,39 @@ public:
      *
      * @details
      * Factory method that instantiates the appropriate Player subclass based
-     * on the specified type. For 4x4 Tic-Tac-Toe, AI players need strategy for:
-     * - Larger search space (16 positions vs 9 in standard)
-     * - Multiple simultaneous threats possible
-     * - More complex winning pattern recognition
-     * - Longer-term strategic planning
-     * - Potential move restrictions based on game rules
+     * on the specified type. AI players search with AI_Player under a time
+     * budget of one second a move.
      *
      * @warning Caller is responsible for deallocating the returned Player object
-     * @note AI complexity increases significantly with the larger board
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type);
 
+    /**
+     * @brief Offers Human, Computer and AI players.
+     */
+    vector<string> player_type_options() const override;
+
     /**
      * @brief Prompts for and retrieves a player's move
      *
      * @param player Pointer to the Player object making the move
-     * @return Pointer to a Move object containing the selected row, column, and symbol
+     * @return A Move from the selected token to its destination
      *
      * @details
-     * For human players, prompts for row and column coordinates (0-3).
-     * For AI players, automatically calculates the move based on the AI algorithm.
-     *
-     * Validates that:
-     * - Row and column numbers are within valid range (0-3)
-     * - Selected cell is empty
-     * - Input is properly formatted
-     * - Any special move restrictions are satisfied
+     * Human players enter the cell of the token to move and then its
+     * destination (0 to 3 each). Computer players are handed to
+     * computer_move() and AI players search for their move instead.
      *
-     * The UI should display:
-     * - Current board state with all 16 positions
-     * - Row and column numbers for reference
-     * - Which player's turn it is
-     * - Any move restrictions if applicable
+     * The board rejects an illegal slide and the player is asked again.
+     */
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Slides a random movable token for a computer player
      *
-     * @note The 4x4 board provides 16 possible moves per turn
-     * @note Re-prompts the user if invalid input is detected
-     * @warning Caller is responsible for deallocating the returned Move object
+     * @param player Pointer to the player whose move is being requested
+     * @return One of the board's generate_moves() slides; a blocked player gets (-1, -1)
      */
-    virtual Move<char>* get_move(Player<char>* player);
+    static Move<char> computer_move(Player<char>* player);
 };
 #endif
\ No newline at end of file
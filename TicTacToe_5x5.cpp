@@ -1,8 +1,58 @@
 #include <bits/stdc++.h>
 #include "TicTacToe_5x5.h"
 
+namespace {
+    /// Lines of three cells (as row * 5 + column) in every direction
+    vector<array<int, 3>> make_windows() {
+        vector<array<int, 3>> lines;
+        const int dirs[4][2] = { {0, 1}, {1, 0}, {1, 1}, {1, -1} };
+        for (int r = 0; r < 5; r++)
+            for (int c = 0; c < 5; c++)
+                for (auto& d : dirs) {
+                    int r2 = r + 2 * d[0], c2 = c + 2 * d[1];
+                    if (r2 < 0 || r2 >= 5 || c2 < 0 || c2 >= 5) continue;
+                    lines.push_back({ r * 5 + c, (r + d[0]) * 5 + c + d[1], r2 * 5 + c2 });
+                }
+        return lines;
+    }
+
+    /// Cells in search order: centre first, corners last
+    vector<int> make_cell_order() {
+        vector<int> cells(25);
+        iota(cells.begin(), cells.end(), 0);
+        stable_sort(cells.begin(), cells.end(), [](int a, int b) {
+            return abs(a / 5 - 2) + abs(a % 5 - 2) < abs(b / 5 - 2) + abs(b % 5 - 2);
+        });
+        return cells;
+    }
+
+    /// For every cell, the windows that contain it
+    vector<vector<int>> make_cell_windows(const vector<array<int, 3>>& lines) {
+        vector<vector<int>> through(25);
+        for (int w = 0; w < static_cast<int>(lines.size()); w++)
+            for (int cell : lines[w])
+                through[cell].push_back(w);
+        return through;
+    }
+
+    /// Weight of a window by the number of stones of one player in it
+    const int line_weight[4] = { 0, 1, 4, 32 };
+
+    /// Contribution of a window to evaluate('X')
+    int window_value(int x_count, int o_count) {
+        int value = 0;
+        if (o_count == 0) value += line_weight[x_count];
+        if (x_count == 0) value -= line_weight[o_count];
+        return value;
+    }
+}
+
+const vector<array<int, 3>> TicTacToe_5x5_board::windows = make_windows();
+const vector<vector<int>> TicTacToe_5x5_board::cell_windows = make_cell_windows(windows);
+
 
 TicTacToe_5x5_board::TicTacToe_5x5_board() : Board(5, 5){
+    set_symmetry(Symmetry::SQUARE);
     for (auto& row : board)
         for (auto& cell : row) {
             cell = blank_symbol;
@@ -20,122 +70,68 @@ bool TicTacToe_5x5_board::update_board(Move<char>* move) {
 
         if (symbol == 0) { // Undo move
             n_moves--;
-            board[x][y] = blank_symbol;
+            if (board[x][y] == 'X' || board[x][y] == 'O')
+                update_counts(x * 5 + y, board[x][y] == 'X' ? 0 : 1, -1);
+            set_cell(x, y, blank_symbol);
         }
         else { // Apply move
             n_moves++;
-            board[x][y] = toupper(symbol);
+            set_cell(x, y, toupper(symbol));
+            if (board[x][y] == 'X' || board[x][y] == 'O')
+                update_counts(x * 5 + y, board[x][y] == 'X' ? 0 : 1, +1);
         }
         return true;
     }
     return false;
 }
 
+void TicTacToe_5x5_board::save_state() {
+    push_state(triples);
+    push_state(line_count);
+    push_state(potential);
+}
 
-void TicTacToe_5x5_board::consecutive_cells(char symbol) {
-    // Horizontal
-    for(int i=0;i<get_rows();i++) {
-        int cnt = 0;
-        for(int j=0;j<get_columns();j++) {
-            if(get_cell(i,j) == symbol) {
-                cnt++;
-            }else {
-                if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-                else cntO+= (cnt>=3) ? cnt-2 : 0;
-                cnt=0;
-            }
-        }
-        if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-        else cntO+= (cnt>=3) ? cnt-2 : 0;
-    }
-    // vertical
-    for(int j=0;j<get_columns();j++) {
-        int cnt = 0;
-        for(int i=0;i<get_rows();i++) {
-            if(get_cell(i,j) == symbol) {
-                cnt++;
-            }else {
-                if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-                else cntO+= (cnt>=3) ? cnt-2 : 0;
-                cnt=0;
-            }
-        }
-        if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-        else cntO+= (cnt>=3) ? cnt-2 : 0;
-    }
-    // Main diagonals (top-left to bottom-right) starting from top row
-    for(int start = 0 ;start<=2;start++) {
-        int cnt=0;
-        for(int i=0, j = start; i<get_rows() && j<get_columns();i++, j++) {
-            if(get_cell(i,j) == symbol) {
-                cnt++;
-            }else {
-                if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-                else cntO+= (cnt>=3) ? cnt-2 : 0;
-                cnt=0;
-            }
-        }
-        if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-        else cntO+= (cnt>=3) ? cnt-2 : 0;
-    }
+void TicTacToe_5x5_board::restore_state() {
+    pop_state(potential);
+    pop_state(line_count);
+    pop_state(triples);
+}
 
-    // Main diagonals starting from left column (below top-left)
-    for(int start = 1 ;start<=2;start++) {
-        int cnt=0;
-        for(int i=start, j = 0; i<get_rows() && j<get_columns();i++, j++) {
-            if(get_cell(i,j) == symbol) {
-                cnt++;
-            }else {
-                if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-                else cntO+= (cnt>=3) ? cnt-2 : 0;
-                cnt=0;
-            }
-        }
-        if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-        else cntO+= (cnt>=3) ? cnt-2 : 0;
-    }
-    // Anti-diagonals (top-right to bottom-left) starting from top row
-    for(int start = 4 ;start>=2;start--) {
-        int cnt=0;
-        for(int i=0, j = start; i<get_rows() && j>=0 ;i++, j--) {
-            if(get_cell(i,j) == symbol) {
-                cnt++;
-            }else {
-                if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-                else cntO+= (cnt>=3) ? cnt-2 : 0;
-                cnt=0;
-            }
-        }
-        if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-        else cntO+= (cnt>=3) ? cnt-2 : 0;
+void TicTacToe_5x5_board::update_counts(int cell, int side, int delta) {
+    for (int w : cell_windows[cell]) {
+        unsigned char* count = &line_count[side][w];
+        potential -= window_value(line_count[0][w], line_count[1][w]);
+        // A window is a completed line exactly while its count is 3
+        if (*count == 3) triples[side]--;
+        *count += delta;
+        if (*count == 3) triples[side]++;
+        potential += window_value(line_count[0][w], line_count[1][w]);
     }
+}
 
-    // Anti-diagonals starting from right column (below top-right)
-    for(int start = 1 ;start<=2;start++) {
-        int cnt=0;
-        for(int i=start, j = 4; i<get_rows() && j>=0 ;i++, j--) {
-            if(get_cell(i,j) == symbol) {
-                cnt++;
-            }else {
-                if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-                else cntO+= (cnt>=3) ? cnt-2 : 0;
-                cnt=0;
-            }
-        }
-        if(symbol == 'X') cntX+= (cnt>=3) ? cnt-2 : 0;
-        else cntO+= (cnt>=3) ? cnt-2 : 0;
-    }
+int TicTacToe_5x5_board::score(char symbol) const {
+    return symbol == 'X' ? triples[0] : symbol == 'O' ? triples[1] : 0;
+}
+
+
+int TicTacToe_5x5_board::consecutive_cells(char symbol) const {
+    // A run of n >= 3 cells scores n-2, i.e. one point per line of three
+    int total = 0;
+    for (const auto& w : windows)
+        if (board[w[0] / 5][w[0] % 5] == symbol &&
+            board[w[1] / 5][w[1] % 5] == symbol &&
+            board[w[2] / 5][w[2] % 5] == symbol)
+            total++;
+    return total;
 }
 
 bool TicTacToe_5x5_board::is_win(Player<char>* player) {
-    if (names.size() <2) names.push_back(player->get_name());
+    // Search players ask with an unnamed stand-in for their opponent
+    if (!player->get_name().empty())
+        (player->get_symbol() == 'X' ? name_x : name_o) = player->get_name();
     if (get_n_moves() == 24) {
       // The last move is for player 'O'.
-        consecutive_cells('X');
-        consecutive_cells('O');
-        if (cntO > cntX) {
-            cout<<"\n"<< names.front() <<" (X) has "<< cntX << " three-in-a-row sequence(s)";
-            cout<<"\n"<< names.back() <<" (O) has "<< cntO << " three-in-a-row sequence(s)\n";
+        if (score('O') > score('X')) {
             return true;
         }
     };
@@ -145,9 +141,7 @@ bool TicTacToe_5x5_board::is_win(Player<char>* player) {
 bool TicTacToe_5x5_board::is_lose(Player<char>* player) {
     if (get_n_moves() == 24) {
         // The last move is for player 'O'
-        if(cntO < cntX) {
-            cout<<"\n"<< names.front() <<" (X) has "<< cntX << " three-in-a-row sequence(s)";
-            cout<<"\n"<< names.back() <<" (O) has "<< cntO << " three-in-a-row sequence(s)\n";
+        if(score('O') < score('X')) {
             return true;
         }
     }
@@ -156,9 +150,7 @@ bool TicTacToe_5x5_board::is_lose(Player<char>* player) {
 
 bool TicTacToe_5x5_board::is_draw(Player<char>* player) {
     if (get_n_moves() == 24) {
-        if(cntO == cntX) {
-            cout<<"\n"<< names.front() <<" (X) has "<< cntX << " three-in-a-row sequence(s)";
-            cout<<"\n"<< names.back() <<" (O) has "<< cntO << " three-in-a-row sequence(s)\n";
+        if(score('O') == score('X')) {
             return true;
         }
     }
@@ -169,17 +161,54 @@ bool TicTacToe_5x5_board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player) || is_lose(player);
 }
 
+void TicTacToe_5x5_board::generate_moves(char symbol, MoveList<char>& moves) {
+    static const vector<int> order = make_cell_order();
+    moves.clear();
+    if (get_n_moves() >= 24) return;
+    for (int cell : order)
+        if (board[cell / 5][cell % 5] == blank_symbol)
+            moves.push(Move<char>(cell / 5, cell % 5, symbol));
+}
+
+int TicTacToe_5x5_board::evaluate(char symbol) {
+    // Completed lines dominate; open lines count as potential
+    return symbol == 'X' ? potential : -potential;
+}
+
+uint64_t TicTacToe_5x5_board::position_key() const {
+    uint64_t key = 0;
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            key = key * 3 + (board[i][j] == 'X' ? 1 : board[i][j] == 'O' ? 2 : 0);
+    return key;
+}
+
+string TicTacToe_5x5_board::result_summary() const {
+    if (get_n_moves() != 24) return "";
+    return "\n" + (name_x.empty() ? "X" : name_x) + " (X) has " + to_string(score('X')) + " three-in-a-row sequence(s)"
+         + "\n" + (name_o.empty() ? "O" : name_o) + " (O) has " + to_string(score('O')) + " three-in-a-row sequence(s)";
+}
+
 
 TicTacToe_5x5_UI::TicTacToe_5x5_UI() : UI<char>("Welcome to 5x5 Tic-Tac-Toe Game", 5) {}
 
 Player<char>* TicTacToe_5x5_UI::create_player(string& name, char symbol, PlayerType type) {
     // Create player based on type
-    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
+    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : type == PlayerType::AI ? "AI" : "computer")
         << " player: " << name << " (" << symbol << ")\n";
+    if (type == PlayerType::AI) {
+        AI_Player<char, TicTacToe_5x5_board>* ai = new AI_Player<char, TicTacToe_5x5_board>(name, symbol, symbol == 'X' ? 'O' : 'X', 6);
+        ai->set_canonical_keys(true); // rotated and reflected positions share table entries
+        return ai;
+    }
     return new Player<char>(name, symbol, type);
 }
 
-Move<char>* TicTacToe_5x5_UI::get_move(Player<char>* player) {
+vector<string> TicTacToe_5x5_UI::player_type_options() const {
+    return { "Human", "Computer", "AI" };
+}
+
+Move<char> TicTacToe_5x5_UI::next_move(Player<char>* player) {
     int x, y;
 
     if (player->get_type() == PlayerType::HUMAN) {
@@ -195,10 +224,14 @@ Move<char>* TicTacToe_5x5_UI::get_move(Player<char>* player) {
         }
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
+        return computer_move(player);
     }
-    return new Move<char>(x, y, player->get_symbol());
+    else if (player->get_type() == PlayerType::AI) {
+        return static_cast<Searcher<char>*>(player)->choose_move();
+    }
+    return Move<char>(x, y, player->get_symbol());
 }
 
-
+Move<char> TicTacToe_5x5_UI::computer_move(Player<char>* player) {
+    return random_move(player->get_board_ptr(), player->get_symbol());
+}
@@ -10,6 +10,8 @@
 #pragma once
 
 #include "BoardGame_Classes.h"
+#include "AI_Player.h"
+#include <array>
 
 /**
  * @class TicTacToe_5x5_board
@@ -21,18 +23,37 @@
  *
  * @see Board
  */
-class TicTacToe_5x5_board : public Board<char>{
+class TicTacToe_5x5_board final : public Board<char>{
 private:
     char blank_symbol = '.'; ///< Symbol representing an empty cell
-    int cntX = 0; ///< Counter for player X's three-in-a-row sequences
-    int cntO = 0; ///< Counter for player O's three-in-a-row sequences
-    vector<string> names; ///< Stores player names for result display
+    string name_x; ///< Name of player X for result display
+    string name_o; ///< Name of player O for result display
+    static const vector<array<int, 3>> windows; ///< All 48 lines of three cells (row * 5 + column)
+    static const vector<vector<int>> cell_windows; ///< Indices of the windows through each cell
+
+    int triples[2] = { 0, 0 };             ///< Completed lines of three of 'X' (index 0) and 'O' (index 1)
+    unsigned char line_count[2][48] = {};  ///< Stones of each player in each window
+    int potential = 0;                     ///< evaluate('X'), kept up to date move by move
+
+    /** @brief Save the line counters before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override;
+
+    /**
+     * @brief Add or remove a stone and update the counters of the windows through its cell.
+     * @param cell Cell index (row * 5 + column)
+     * @param side 0 for 'X', 1 for 'O'
+     * @param delta +1 when the stone is placed, -1 when it is taken back
+     */
+    void update_counts(int cell, int side, int delta);
 
 public:
     /**
      * @brief Default constructor that initializes a 5x5 board.
      *
-     * Sets all cells to blank and initializes sequence counters to zero.
+     * Sets all cells to blank and clears the per-window stone counts.
      */
     TicTacToe_5x5_board();
 
@@ -47,7 +68,7 @@ public:
      * @brief Checks if player O has won (more sequences than X).
      *
      * Calculates sequences for both players at move 24 and determines
-     * if O has more. Displays the sequence counts.
+     * if O has more.
      *
      * @param player Pointer to the player being checked
      * @return true if O has more sequences than X, false otherwise
@@ -58,7 +79,6 @@ public:
      * @brief Checks if player X has won (more sequences than O).
      *
      * Determines if X has more sequences than O at move 24.
-     * Displays the sequence counts.
      *
      * @param player Pointer to the player being checked
      * @return true if X has more sequences than O, false otherwise
@@ -69,7 +89,6 @@ public:
      * @brief Checks if the game has ended in a draw.
      *
      * A draw occurs at move 24 when both players have equal sequences.
-     * Displays the sequence counts.
      *
      * @param player Pointer to the player being checked
      * @return true if both players have equal sequences, false otherwise
@@ -83,16 +102,62 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /**
+     * @brief Describes the final sequence counts of both players.
+     * @return The per-player counts once the game is over, empty otherwise
+     */
+    string result_summary() const override;
+
+    /**
+     * @brief Lists the empty cells, centre first, until the 24th move.
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
+     */
+    void generate_moves(char symbol, MoveList<char>& moves) override;
+
+    /**
+     * @brief Scores lines of three for a player.
+     *
+     * Completed lines weigh most; lines still open to one player count as
+     * potential for that player. The sum is maintained by update_board(), so
+     * this is O(1).
+     *
+     * @param symbol The player the score is for
+     * @return Own line score minus the opponent's
+     */
+    int evaluate(char symbol) override;
+
+    /**
+     * @brief Base-3 encoding of the 25 cells.
+     * @return Unique key of the position
+     */
+    uint64_t position_key() const override;
+
+    /**
+     * @brief Running three-in-a-row count of a symbol.
+     *
+     * Kept up to date by update_board() (including undo) by looking only at
+     * the lines through the changed cell, so it is cheap at every search node.
+     *
+     * @param symbol The player's symbol ('X' or 'O')
+     * @return The same value consecutive_cells() would compute
+     */
+    int score(char symbol) const;
+
     /**
      * @brief Counts all three-in-a-row sequences for a symbol.
      *
      * Scans the board in all directions (horizontal, vertical, main diagonal,
      * anti-diagonal) and counts consecutive sequences of 3 or more cells.
-     * Updates the appropriate counter (cntX or cntO) based on the symbol.
+     * A sequence of n cells counts n-2, which is the number of lines of
+     * three it contains.
+     *
+     * Full rescan of the board; score() returns the same value incrementally.
      *
      * @param symbol The player's symbol ('X' or 'O') to count sequences for
+     * @return The number of sequences; the board is not modified
      */
-    void consecutive_cells(char symbol);
+    int consecutive_cells(char symbol) const;
 };
 
 /**
@@ -130,7 +195,19 @@ public:
     /**
      * @brief Retrieves the next move from a player.
      * @param player Pointer to the player whose move is being requested
-     * @return Pointer to a Move<char> object representing the player's move
+     * @return A Move<char> representing the player's move
+     */
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Offers Human, Computer and AI players.
+     */
+    vector<string> player_type_options() const override;
+
+    /**
+     * @brief Picks a random legal move for a computer player.
+     * @param player Pointer to the player whose move is being requested
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if there is none
      */
-    Move<char>* get_move(Player<char>* player) override;
+    static Move<char> computer_move(Player<char>* player);
 };
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "Tournament.h"
+
+using namespace std;
+
+namespace {
+    const double MAX_ELO = 1200; ///< Largest difference reported
+
+    /** @brief Mean and variance of the points of one game, with half a game of each outcome added. */
+    void smoothed_moments(const MatchScore& score, double& mean, double& variance) {
+        double w = score.wins + 0.5, d = score.draws + 0.5, l = score.losses + 0.5;
+        double n = w + d + l;
+        mean = (w + 0.5 * d) / n;
+        variance = (w * (1 - mean) * (1 - mean) + d * (0.5 - mean) * (0.5 - mean) + l * mean * mean) / n;
+    }
+}
+
+double elo_to_score(double elo) {
+    return 1 / (1 + pow(10.0, -elo / 400));
+}
+
+double score_to_elo(double score) {
+    double low = elo_to_score(-MAX_ELO);
+    score = min(max(score, low), 1 - low);
+    return 400 * log10(score / (1 - score));
+}
+
+EloEstimate elo_estimate(const MatchScore& score, double z) {
+    EloEstimate e;
+    if (score.games() == 0) {
+        e.low = -MAX_ELO;
+        e.high = MAX_ELO;
+        return e;
+    }
+    double mean, variance;
+    smoothed_moments(score, mean, variance);
+    double error = z * sqrt(variance / score.games());
+    e.elo = score_to_elo(score.score());
+    e.low = min(e.elo, score_to_elo(score.score() - error));
+    e.high = max(e.elo, score_to_elo(score.score() + error));
+    return e;
+}
+
+Sprt::Sprt(double elo0, double elo1, double alpha, double beta) {
+    if (elo1 <= elo0)
+        throw runtime_error("SPRT needs elo1 above elo0");
+    if (alpha <= 0 || alpha >= 0.5 || beta <= 0 || beta >= 0.5)
+        throw runtime_error("SPRT error rates must be between 0 and 0.5");
+    score0 = elo_to_score(elo0);
+    score1 = elo_to_score(elo1);
+    lower = log(beta / (1 - alpha));
+    upper = log((1 - beta) / alpha);
+}
+
+double Sprt::llr(const MatchScore& score) const {
+    double mean, variance;
+    smoothed_moments(score, mean, variance);
+    return score.games() * (score1 - score0) * (2 * mean - score0 - score1) / (2 * variance);
+}
+
+SprtDecision Sprt::decide(const MatchScore& score) const {
+    double ratio = llr(score);
+    if (ratio >= upper) return SprtDecision::H1;
+    if (ratio <= lower) return SprtDecision::H0;
+    return SprtDecision::CONTINUE;
+}
+
+vector<Rating> fit_ratings(int entrants, const vector<PairingScore>& pairings, double z) {
+    vector<Rating> ratings(entrants);
+    vector<vector<double>> games(entrants, vector<double>(entrants, 0));
+    vector<double> points(entrants, 0);
+    for (const PairingScore& p : pairings) {
+        const MatchScore& s = p.score;
+        if (s.games() == 0 || p.a == p.b) continue;
+        if (games[p.a][p.b] == 0) {
+            // The virtual draw of this pair
+            games[p.a][p.b] = games[p.b][p.a] = 1;
+            points[p.a] += 0.5;
+            points[p.b] += 0.5;
+        }
+        games[p.a][p.b] += s.games();
+        games[p.b][p.a] += s.games();
+        points[p.a] += s.wins + 0.5 * s.draws;
+        points[p.b] += s.losses + 0.5 * s.draws;
+        ratings[p.a].games += s.games();
+        ratings[p.b].games += s.games();
+        ratings[p.a].score += s.wins + 0.5 * s.draws;
+        ratings[p.b].score += s.losses + 0.5 * s.draws;
+    }
+
+    // Minorization-maximization of the Bradley-Terry likelihood, strengths normalized to a geometric mean of 1
+    vector<double> strength(entrants, 1);
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+        double change = 0, log_sum = 0;
+        int rated = 0;
+        for (int i = 0; i < entrants; ++i) {
+            double denominator = 0;
+            for (int j = 0; j < entrants; ++j)
+                if (games[i][j] > 0) denominator += games[i][j] / (strength[i] + strength[j]);
+            if (denominator == 0) continue;
+            double next = points[i] / denominator;
+            change = max(change, fabs(next - strength[i]) / strength[i]);
+            strength[i] = next;
+            log_sum += log(next);
+            ++rated;
+        }
+        if (rated == 0) break;
+        double scale = exp(log_sum / rated);
+        for (int i = 0; i < entrants; ++i)
+            if (ratings[i].games > 0) strength[i] /= scale;
+        if (change < 1e-10) break;
+    }
+
+    for (int i = 0; i < entrants; ++i) {
+        Rating& r = ratings[i];
+        if (r.games == 0) continue;
+        double information = 0;
+        for (int j = 0; j < entrants; ++j) {
+            double p = strength[i] / (strength[i] + strength[j]);
+            information += games[i][j] * p * (1 - p);
+        }
+        r.elo = 400 * log10(strength[i]);
+        r.error = z * 400 / log(10.0) / sqrt(information);
+        r.score /= r.games;
+    }
+    return ratings;
+}
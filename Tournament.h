@@ -0,0 +1,428 @@
+/**
+ * @file Tournament.h
+ * @brief Ranks computer players of one variant by playing them against each other.
+ *
+ * A Tournament holds a list of entrants (random, alpha-beta at several
+ * depths, MCTS, table players...) and plays them either round-robin (every
+ * pair) or as a gauntlet (one entrant against every other). Games of all
+ * pairings are handed out in turn to a pool of threads; each game is
+ * played by SelfPlayRunner on a fresh board with players created for it,
+ * and the two entrants of a pairing take the first move in turn.
+ *
+ * Each pairing stops early once a sequential probability ratio test
+ * (Sprt) decides which side is stronger, or after a maximum number of
+ * games. Scores are then turned into Elo differences with confidence
+ * intervals, and into one rating per entrant (fit_ratings()).
+ *
+ * With a record directory, every game is appended to the record file of
+ * its pairing and colour (see GameRecord.h). A tournament started again
+ * on the same directory first tallies those files, so an interrupted
+ * tournament resumes where it stopped.
+ */
+
+#ifndef _TOURNAMENT_H
+#define _TOURNAMENT_H
+
+#include "BoardGame_Classes.h"
+#include "SelfPlay.h"
+#include "Searcher.h"
+#include <filesystem>
+#include <mutex>
+
+/**
+ * @brief Wins, draws and losses of one side of a pairing.
+ */
+struct MatchScore {
+    long long wins = 0;   ///< Games won
+    long long draws = 0;  ///< Games drawn (aborted games count as draws)
+    long long losses = 0; ///< Games lost
+
+    /** @brief Games counted. */
+    long long games() const { return wins + draws + losses; }
+
+    /** @brief Points per game, a win being 1 and a draw 1/2; 0.5 before any game. */
+    double score() const { return games() > 0 ? (wins + 0.5 * draws) / games() : 0.5; }
+
+    /** @brief Count a game by its result for this side; ONGOING counts as a draw. */
+    void add(GameResult result) {
+        if (result == GameResult::WIN) ++wins;
+        else if (result == GameResult::LOSE) ++losses;
+        else ++draws;
+    }
+
+    /** @brief The same games seen from the other side. */
+    MatchScore reversed() const { return { losses, draws, wins }; }
+};
+
+/** @brief Expected score of a player rated elo points above its opponent. */
+double elo_to_score(double elo);
+
+/** @brief Elo difference that gives an expected score; clamped to +/-1200 at 0 and 1. */
+double score_to_elo(double score);
+
+/**
+ * @brief Elo difference of a pairing with a confidence interval.
+ */
+struct EloEstimate {
+    double elo = 0;  ///< Most likely difference
+    double low = 0;  ///< Lower end of the interval
+    double high = 0; ///< Upper end of the interval
+};
+
+/**
+ * @brief Elo difference of side A over side B from A's score.
+ * @param z Width of the interval in standard errors (1.96 for 95%)
+ *
+ * The interval is the normal interval of the mean score mapped to Elo.
+ */
+EloEstimate elo_estimate(const MatchScore& score, double z = 1.96);
+
+/** @brief Outcome of a sequential test. */
+enum class SprtDecision {
+    CONTINUE, ///< Not decided yet
+    H0,       ///< The difference is elo0 rather than elo1
+    H1        ///< The difference is elo1 rather than elo0
+};
+
+/**
+ * @brief Sequential probability ratio test between two Elo differences.
+ *
+ * The log-likelihood ratio of "A is elo1 stronger" against "A is elo0
+ * stronger" uses the normal approximation of the trinomial (win, draw,
+ * loss) score. With the default elo0 = -elo1 a decision tells which side
+ * is stronger; equal players run until the game limit of the pairing.
+ */
+class Sprt {
+public:
+    /**
+     * @param elo0 Difference of the null hypothesis
+     * @param elo1 Difference of the alternative hypothesis (above elo0)
+     * @param alpha Chance of accepting H1 when H0 holds
+     * @param beta Chance of accepting H0 when H1 holds
+     * @throws runtime_error if elo1 <= elo0 or alpha, beta are not in (0, 1/2)
+     */
+    Sprt(double elo0 = -30, double elo1 = 30, double alpha = 0.05, double beta = 0.05);
+
+    /**
+     * @brief Log-likelihood ratio of H1 over H0 for side A's score.
+     *
+     * Half a game of each outcome is added to the counts, so a few games
+     * with a single outcome give a finite ratio.
+     */
+    double llr(const MatchScore& score) const;
+
+    /** @brief Accept H0 or H1 once the ratio crosses a bound. */
+    SprtDecision decide(const MatchScore& score) const;
+
+    /** @brief Ratio at or below which H0 is accepted. */
+    double lower_bound() const { return lower; }
+
+    /** @brief Ratio at or above which H1 is accepted. */
+    double upper_bound() const { return upper; }
+
+private:
+    double score0, score1; ///< Expected scores of the two hypotheses
+    double lower, upper;   ///< Decision bounds on the ratio
+};
+
+/**
+ * @brief Games of two entrants, by their index in the tournament.
+ */
+struct PairingScore {
+    int a = 0;        ///< First entrant
+    int b = 0;        ///< Second entrant
+    MatchScore score; ///< Results of a against b
+};
+
+/**
+ * @brief Rating of one entrant, relative to the mean of all entrants.
+ */
+struct Rating {
+    double elo = 0;     ///< Rating
+    double error = 0;   ///< Half-width of its confidence interval
+    long long games = 0;///< Games played
+    double score = 0;   ///< Points per game
+};
+
+/**
+ * @brief Ratings that best explain the results of every pairing.
+ * @param entrants Number of entrants
+ * @param pairings Results, any number per pair of entrants
+ * @param z Width of the intervals in standard errors
+ *
+ * Fits a Bradley-Terry model, a draw being half a win, by minorization-
+ * maximization. Each pair that played gets one extra virtual draw, so an
+ * entrant that never scored still has a finite rating. Ratings are
+ * shifted to average 0; an entrant without games is rated 0.
+ */
+vector<Rating> fit_ratings(int entrants, const vector<PairingScore>& pairings, double z = 1.96);
+
+/** @brief How the entrants of a tournament are paired. */
+enum class TournamentFormat {
+    ROUND_ROBIN, ///< Every entrant against every other
+    GAUNTLET     ///< The first entrant against every other
+};
+
+/**
+ * @brief Plays and scores the pairings of a set of entrants on one variant.
+ *
+ * @tparam T Type of symbol used on the board.
+ * @tparam B Board type played (see SelfPlayRunner).
+ *
+ * Searcher entrants (PlayerType::AI) are asked for their move with
+ * choose_move(); any other entrant plays the variant's random policy.
+ * Every game creates its own players, so entrants share nothing between
+ * threads; searches should use a single thread each, as the tournament
+ * already keeps every core busy.
+ *
+ * Game j of a pairing draws from random stream (pairing, j), so a
+ * tournament repeats exactly on any thread count as long as no pairing
+ * stops early. Games already under way when a pairing is decided still
+ * count, because they are recorded.
+ *
+ * Usage:
+ * @code
+ * Tournament<char, CONNECT_Board> t([] { return new CONNECT_Board(); }, CONNECT_UI::computer_move, 'X', 'O');
+ * t.add_entrant("random", [](char s, char) { return new Player<char>("random", s, PlayerType::COMPUTER); });
+ * t.add_entrant("ab4", [](char s, char o) { return new AI_Player<char, CONNECT_Board>("ab4", s, o, 4); });
+ * t.run(8);
+ * vector<Rating> ratings = t.ratings();
+ * @endcode
+ */
+template <typename T, typename B = Board<T>>
+class Tournament {
+public:
+    using Runner = SelfPlayRunner<T, B>;
+    using BoardFactory = typename Runner::BoardFactory;
+    using MovePolicy = typename Runner::MovePolicy;
+
+    /** @brief Creates a player of an entrant given its symbol and the opponent's; the game owns it. */
+    using PlayerFactory = function<Player<T>*(T symbol, T opponent_symbol)>;
+
+    /**
+     * @brief Current state of one pairing.
+     */
+    struct Pairing {
+        int a = 0;                ///< Index of the first entrant
+        int b = 0;                ///< Index of the second entrant
+        MatchScore score;         ///< Results of a against b
+        long long resumed = 0;    ///< Games read back from the record files
+        long long issued = 0;     ///< Games started, resumed ones included
+        SprtDecision decision = SprtDecision::CONTINUE; ///< H1: a is stronger, H0: b is
+    };
+
+    /**
+     * @brief Construct a tournament of one variant.
+     * @param factory Creates the board of each game.
+     * @param random_policy Move of an entrant that is not a Searcher.
+     * @param first_symbol Symbol of the player who moves first.
+     * @param second_symbol Symbol of the player who moves second.
+     */
+    Tournament(BoardFactory factory, MovePolicy random_policy, T first_symbol, T second_symbol)
+        : factory(factory), symbols{ first_symbol, second_symbol } {
+        policy = [random_policy](Player<T>* player) {
+            if (player->get_type() == PlayerType::AI)
+                return static_cast<Searcher<T>*>(player)->choose_move();
+            return random_policy(player);
+        };
+    }
+
+    /**
+     * @brief Add an entrant.
+     * @param name Short name, used in reports and record file names.
+     * @param make Creates the entrant's player for one game.
+     * @return Index of the entrant
+     */
+    int add_entrant(const string& name, PlayerFactory make) {
+        names.push_back(name);
+        makers.push_back(make);
+        return static_cast<int>(names.size()) - 1;
+    }
+
+    /** @brief Round-robin (the default) or a gauntlet of the first entrant. */
+    void set_format(TournamentFormat f) { format = f; }
+
+    /** @brief Largest number of games of a pairing, resumed ones included. */
+    void set_max_games(int games) { max_games = max(games, 1); }
+
+    /** @brief Test that stops a pairing early. */
+    void set_sprt(const Sprt& test) { sprt = test; }
+
+    /** @brief Limits of each game (see SelfPlayRunner::set_limits()). */
+    void set_limits(int plies, int retries) {
+        max_plies = plies;
+        max_retries = retries;
+    }
+
+    /**
+     * @brief Record every game and resume from the games already recorded.
+     * @param dir Directory of the record files, created if needed
+     * @param variant_id Menu number of the game (see record_variant())
+     *
+     * The games where entrant a moves first against entrant b go to
+     * dir/v<variant>-<a>-<b>.rec, named after the entrants.
+     */
+    void set_record(const string& dir, int variant_id) {
+        record_dir = dir;
+        variant = variant_id;
+    }
+
+    /**
+     * @brief Play every pairing until it is decided or reaches the game limit.
+     * @param threads Number of worker threads (at least one is used).
+     * @throws runtime_error if there are fewer than two entrants or a record file is not valid
+     */
+    void run(int threads = thread::hardware_concurrency()) {
+        if (names.size() < 2)
+            throw runtime_error("a tournament needs at least two entrants");
+        make_pairings();
+
+        // One runner per pairing and colour: runners[2p + c] has entrant b first if c is 1
+        vector<unique_ptr<Runner>> runners;
+        vector<unique_ptr<GameRecordWriter>> writers;
+        for (Pairing& p : pairings) {
+            for (int c = 0; c < 2; ++c) {
+                runners.push_back(make_unique<Runner>(factory, policy, policy, symbols[0], symbols[1]));
+                runners.back()->set_limits(max_plies, max_retries);
+                if (record_dir.empty()) continue;
+                string path = record_path(c == 0 ? p.a : p.b, c == 0 ? p.b : p.a);
+                // The writer first drops a game cut short by a killed run
+                writers.push_back(make_unique<GameRecordWriter>(path));
+                resume(p, path, c == 1);
+                runners.back()->set_record(writers.back().get(), variant);
+            }
+            p.issued = p.resumed;
+            p.decision = sprt.decide(p.score);
+        }
+
+        auto start = chrono::steady_clock::now();
+        size_t cursor = 0;
+        vector<thread> workers;
+        for (int t = 0; t < max(threads, 1); ++t)
+            workers.emplace_back([&] {
+                size_t i;
+                long long game;
+                while (next_game(cursor, i, game)) {
+                    Pairing& p = pairings[i];
+                    bool swapped = game % 2 == 1;
+                    unique_ptr<Player<T>> first(makers[swapped ? p.b : p.a](symbols[0], symbols[1]));
+                    unique_ptr<Player<T>> second(makers[swapped ? p.a : p.b](symbols[1], symbols[0]));
+                    set_thread_stream((static_cast<uint64_t>(i) << 32) + game);
+                    SelfPlayStats stats;
+                    GameResult result = runners[2 * i + swapped]->play_game(stats, first.get(), second.get());
+                    if (!writers.empty())
+                        writers[2 * i + swapped]->flush(); // an interrupted run keeps every finished game
+                    finish_game(p, swapped ? reversed(result) : result);
+                }
+            });
+        for (auto& w : workers)
+            w.join();
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    /** @brief Names of the entrants, by index. */
+    const vector<string>& get_names() const { return names; }
+
+    /** @brief Pairings of the last run(). */
+    const vector<Pairing>& get_pairings() const { return pairings; }
+
+    /** @brief Wall-clock time of the last run(). */
+    double get_seconds() const { return seconds; }
+
+    /** @brief Rating of every entrant from the pairings of the last run(). */
+    vector<Rating> ratings(double z = 1.96) const {
+        vector<PairingScore> scores;
+        for (const Pairing& p : pairings)
+            scores.push_back({ p.a, p.b, p.score });
+        return fit_ratings(static_cast<int>(names.size()), scores, z);
+    }
+
+private:
+    BoardFactory factory;        ///< Creates the board of each game
+    MovePolicy policy;           ///< Searcher move or random move
+    T symbols[2];                ///< Symbols of the first and second player
+    vector<string> names;        ///< Entrant names
+    vector<PlayerFactory> makers;///< Entrant player factories
+    vector<Pairing> pairings;    ///< Pairings of the current run
+    TournamentFormat format = TournamentFormat::ROUND_ROBIN; ///< How entrants are paired
+    int max_games = 200;         ///< Games per pairing at most
+    Sprt sprt;                   ///< Early stopping test
+    int max_plies = 1000;        ///< Accepted moves after which a game is aborted
+    int max_retries = 10000;     ///< Rejected moves in one turn after which a game is aborted
+    string record_dir;           ///< Record directory, empty when not recording
+    int variant = 0;             ///< Menu number of the game, for its records
+    mutex lock;                  ///< Guards the pairings while games run
+    double seconds = 0;          ///< Wall-clock time of the last run
+
+    /** @brief A result seen from the other player. */
+    static GameResult reversed(GameResult result) {
+        if (result == GameResult::WIN) return GameResult::LOSE;
+        if (result == GameResult::LOSE) return GameResult::WIN;
+        return result;
+    }
+
+    /** @brief List the pairings of the format, none played yet. */
+    void make_pairings() {
+        pairings.clear();
+        int n = static_cast<int>(names.size());
+        for (int a = 0; a < n; ++a)
+            for (int b = a + 1; b < n; ++b)
+                if (format == TournamentFormat::ROUND_ROBIN || a == 0) {
+                    Pairing p;
+                    p.a = a;
+                    p.b = b;
+                    pairings.push_back(p);
+                }
+    }
+
+    /** @brief Record file of the games where entrant first moves first against entrant second. */
+    string record_path(int first, int second) const {
+        filesystem::create_directories(record_dir);
+        return (filesystem::path(record_dir) /
+                ("v" + to_string(variant) + "-" + names[first] + "-" + names[second] + ".rec")).string();
+    }
+
+    /**
+     * @brief Tally the games of a pairing already in its record file for one colour.
+     *
+     * A missing file, or one shorter than the magic (killed before its
+     * first game), holds no games.
+     */
+    void resume(Pairing& p, const string& path, bool swapped) {
+        if (!filesystem::exists(path) || filesystem::file_size(path) < GameRecordFile::MAGIC_BYTES) return;
+        GameRecordFile file(path);
+        for (const RecordedGame& game : file) {
+            if (game.variant != variant) continue;
+            GameResult result = static_cast<GameResult>(game.result);
+            p.score.add(swapped ? reversed(result) : result);
+            ++p.resumed;
+        }
+    }
+
+    /**
+     * @brief Hand out the next game, visiting the open pairings in turn.
+     * @return false once every pairing is decided or has all its games
+     */
+    bool next_game(size_t& cursor, size_t& i, long long& game) {
+        lock_guard<mutex> guard(lock);
+        for (size_t tried = 0; tried < pairings.size(); ++tried) {
+            i = cursor++ % pairings.size();
+            Pairing& p = pairings[i];
+            if (p.decision == SprtDecision::CONTINUE && p.issued < max_games) {
+                game = p.issued++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief Count a finished game for entrant a and test its pairing. */
+    void finish_game(Pairing& p, GameResult result) {
+        lock_guard<mutex> guard(lock);
+        p.score.add(result);
+        if (p.decision == SprtDecision::CONTINUE)
+            p.decision = sprt.decide(p.score);
+    }
+};
+
+#endif // _TOURNAMENT_H
@@ -30,6 +30,7 @@
 
 #include "BoardGame_Classes.h"
 #include <vector>
+#include <array>
 #include <algorithm>
 
  /**
@@ -66,7 +67,7 @@
   * Each small board internally is a standard 3x3 Tic-Tac-Toe grid.
   */
 template <typename T>
-class UltimateTicTacToe : public Board<T> {
+class UltimateTicTacToe final : public Board<T> {
 public:
     /**
      * @brief Constructs a new Ultimate Tic-Tac-Toe board
@@ -83,13 +84,15 @@ public:
      * with all 81 cells available for moves.
      */
     UltimateTicTacToe(T empty_cell = static_cast<T>(' '))
-        : Board<T>(9, 9), empty_marker(empty_cell) {
+        : Board<T>(9, 9), empty_marker(empty_cell), meta_winner(empty_cell) {
+        this->set_symmetry(Symmetry::SQUARE);
 
         for (int r = 0; r < this->rows; ++r)
             for (int c = 0; c < this->columns; ++c)
                 this->board[r][c] = empty_marker;
 
-        winners.assign(3, std::vector<T>(3, empty_marker));
+        for (auto& row : winners)
+            row.fill(empty_marker);
     }
 
     /**
@@ -136,7 +139,7 @@ public:
         if (winners[br][bc] != empty_marker) return false;
 
 
-        this->board[x][y] = sym;
+        this->set_cell(x, y, sym);
         ++this->n_moves;
 
         if (check_and_set_small_winner(br, bc)) {
@@ -149,6 +152,14 @@ public:
             }
         }
 
+        // Only a newly decided small board can change the meta outcome
+        T decided_by = winners[br][bc];
+        if (decided_by != empty_marker) {
+            ++decided;
+            if (three_in_row_winners(decided_by, br, bc))
+                meta_winner = decided_by;
+        }
+
         return true;
     }
 
@@ -167,10 +178,11 @@ public:
      * Only considers the player's actual symbol; draws ('D') don't count as wins.
      *
      * @note This is the meta-game win condition, not individual small board wins
+     * @note update_board() checks the meta lines through each newly decided
+     *       small board, so this only reads its result
      */
     virtual bool is_win(Player<T>* p) override {
-        T s = p->get_symbol();
-        return three_in_row_winners(s);
+        return meta_winner != empty_marker && meta_winner == p->get_symbol();
     }
 
     /**
@@ -183,11 +195,10 @@ public:
      * In Ultimate Tic-Tac-Toe, a player loses when their opponent wins
      * by claiming three small boards in a row on the meta-level.
      *
-     * Determines the opponent's symbol and checks if they have won.
+     * Reads the meta winner cached by update_board().
      */
     virtual bool is_lose(Player<T>* p) override {
-        T opp = get_opponent_symbol(p);
-        return three_in_row_winners(opp);
+        return meta_winner != empty_marker && meta_winner != p->get_symbol();
     }
 
     /**
@@ -205,19 +216,9 @@ public:
      * but no player has a winning line on the meta-level.
      *
      * @note Small boards marked as 'D' (draw) count as decided boards
-     * @note Explicitly checks that neither 'X' nor 'O' has won
      */
     virtual bool is_draw(Player<T>*) override {
-
-        if (three_in_row_winners(static_cast<T>('X'))) return false;
-        if (three_in_row_winners(static_cast<T>('O'))) return false;
-
-
-        for (int r = 0; r < 3; ++r)
-            for (int c = 0; c < 3; ++c)
-                if (winners[r][c] == empty_marker) return false;
-
-        return true;
+        return meta_winner == empty_marker && decided == 9;
     }
 
     /**
@@ -238,9 +239,42 @@ public:
         return is_win(p) || is_lose(p) || is_draw(p);
     }
 
+    /**
+     * @brief Lists every empty cell of the small boards still in play
+     *
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
+     *
+     * Small boards that are won or drawn are dead: none of their cells is listed.
+     */
+    virtual void generate_moves(T symbol, MoveList<T>& moves) override {
+        moves.clear();
+        for (int r = 0; r < this->rows; ++r)
+            for (int c = 0; c < this->columns; ++c)
+                if (this->board[r][c] == empty_marker && winners[r / 3][c / 3] == empty_marker)
+                    moves.push(Move<T>(r, c, symbol));
+    }
+
+protected:
+    /** @brief Save the winners grid and the meta outcome before make_move() applies a move. */
+    void save_state() override {
+        this->push_state(winners);
+        this->push_state(meta_winner);
+        this->push_state(decided);
+    }
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override {
+        this->pop_state(decided);
+        this->pop_state(meta_winner);
+        this->pop_state(winners);
+    }
+
 private:
-    std::vector<std::vector<T>> winners;  ///< 3x3 grid tracking small board winners (player symbol or 'D' for draw)
+    std::array<std::array<T, 3>, 3> winners; ///< 3x3 grid tracking small board winners (player symbol or 'D' for draw); inline so boards copy cheaply
     T empty_marker;                       ///< Symbol representing empty cells
+    T meta_winner;                        ///< Symbol with three small boards in a row, or empty_marker
+    int decided = 0;                      ///< Small boards won or drawn
 
     /**
      * @brief Returns the symbol used to mark drawn small boards
@@ -341,16 +375,18 @@ private:
     }
 
     /**
-     * @brief Checks if a symbol has three in a row in the winners grid
+     * @brief Checks if a symbol has three in a row in the winners grid through one small board
      *
      * @param s The symbol to check for (typically 'X' or 'O')
+     * @param br Row of the small board the line must pass through (0-2)
+     * @param bc Column of the small board the line must pass through (0-2)
      * @return true if symbol has three in a row in winners grid; false otherwise
      *
      * @details
-     * Checks the 3x3 winners grid for three consecutive positions with the symbol:
-     * - Three rows
-     * - Three columns
-     * - Two diagonals
+     * Checks the lines of the 3x3 winners grid through (br, bc):
+     * - Its row
+     * - Its column
+     * - The diagonals it lies on
      *
      * This is the meta-game win condition - winning three small boards in a line.
      *
@@ -358,45 +394,17 @@ private:
      * as these cannot contribute to a win.
      *
      * @note This checks the meta-level, not individual small boards
-     * @note Used by both is_win() and is_draw() methods
+     * @note Called by update_board() for each newly decided small board
      */
-    bool three_in_row_winners(T s) const {
+    bool three_in_row_winners(T s, int br, int bc) const {
         if (s == draw_marker() || s == empty_marker) return false;
-        for (int r = 0; r < 3; ++r)
-
-            if (winners[r][0] == s && winners[r][1] == s && winners[r][2] == s)
-                return true;
-
-        for (int c = 0; c < 3; ++c)
-            if (winners[0][c] == s && winners[1][c] == s && winners[2][c] == s)
-                return true;
-
-        if (winners[0][0] == s && winners[1][1] == s && winners[2][2] == s) return true;
-        if (winners[0][2] == s && winners[1][1] == s && winners[2][0] == s) return true;
+        if (winners[br][0] == s && winners[br][1] == s && winners[br][2] == s) return true;
+        if (winners[0][bc] == s && winners[1][bc] == s && winners[2][bc] == s) return true;
+        if (br == bc && winners[0][0] == s && winners[1][1] == s && winners[2][2] == s) return true;
+        if (br + bc == 2 && winners[0][2] == s && winners[1][1] == s && winners[2][0] == s) return true;
 
         return false;
     }
-
-    /**
-     * @brief Determines the opponent's symbol
-     *
-     * @param p Pointer to the Player object whose opponent to find
-     * @return The opponent's symbol (type T)
-     *
-     * @details
-     * Uses a simple two-player assumption:
-     * - If player is 'X', opponent is 'O'
-     * - Otherwise, opponent is 'X'
-     *
-     * This is used to check if the player has lost (opponent has won).
-     *
-     * @note Assumes standard two-player game with 'X' and 'O' symbols
-     */
-    T get_opponent_symbol(Player<T>* p) const {
-        T s = p->get_symbol();
-        if (s == static_cast<T>('X')) return static_cast<T>('O');
-        return static_cast<T>('X');
-    }
 };
 
 #endif
\ No newline at end of file
@@ -22,6 +22,8 @@
 #ifndef _ULTIMATE_UI_H
 #define _ULTIMATE_UI_H
 #include "BoardGame_Classes.h"
+#include "Ultimate_TicTacToe.h"
+#include "MCTS_Player.h"
 #include <iostream>
 #include <iomanip>
 #include <limits>
@@ -73,6 +75,32 @@ public:
      */
     ~Ultimate_UI() override {}
 
+    /**
+     * @brief Creates a human, random computer or MCTS player
+     *
+     * @param name Name of the player
+     * @param symbol Symbol the player places ('X' or 'O')
+     * @param type Type of player
+     * @return Pointer to the new player; the caller owns it
+     *
+     * AI players search for one second per move on every hardware thread.
+     */
+    Player<char>* create_player(string& name, char symbol, PlayerType type) override {
+        cout << "Creating " << (type == PlayerType::HUMAN ? "human" : type == PlayerType::AI ? "AI" : "computer")
+             << " player: " << name << " (" << symbol << ")\n";
+
+        if (type == PlayerType::AI)
+            return new MCTS_Player<char, UltimateTicTacToe<char>>(name, symbol, symbol == 'X' ? 'O' : 'X', 0, 1.0);
+        return new Player<char>(name, symbol, type);
+    }
+
+    /**
+     * @brief Offers Human, Computer and AI (Monte Carlo Tree Search) players
+     */
+    vector<string> player_type_options() const override {
+        return { "Human", "Computer", "AI" };
+    }
+
     /**
      * @brief Displays the 9x9 game board with visual small board separators
      *
@@ -115,10 +143,10 @@ public:
      * @note Visual dividers appear at positions divisible by 3
      * @note This is a const method and does not modify the board
      */
-    void display_board_matrix(const std::vector<std::vector<char>>& matrix) const override {
-        if (matrix.empty() || matrix[0].empty()) return;
-        int rows = static_cast<int>(matrix.size());
-        int cols = static_cast<int>(matrix[0].size());
+    void display_board_matrix(const BoardView<char>& matrix) const override {
+        if (matrix.get_rows() == 0 || matrix.get_columns() == 0) return;
+        int rows = matrix.get_rows();
+        int cols = matrix.get_columns();
         std::cout << "\n    ";
         for (int c = 0; c < cols; ++c) {
             std::cout << std::setw(2) << c << ((c % 3 == 2 && c != cols - 1) ? " |" : " ");
@@ -127,7 +155,7 @@ public:
         for (int r = 0; r < rows; ++r) {
             std::cout << std::setw(3) << r << " ";
             for (int c = 0; c < cols; ++c) {
-                char ch = matrix[r][c];
+                char ch = matrix(r, c);
                 if (ch == static_cast<char>(' ')) ch = '.';
                 std::cout << " " << ch << ((c % 3 == 2 && c != cols - 1) ? " |" : " ");
             }
@@ -143,7 +171,7 @@ public:
      * @brief Prompts for and retrieves a player's move in global coordinates
      *
      * @param player Pointer to the Player object making the move
-     * @return Pointer to a Move object containing the selected global row, column, and symbol
+     * @return A Move containing the selected global row, column, and symbol
      *
      * @details
      * Prompts the player to enter global coordinates for their move.
@@ -173,13 +201,20 @@ public:
      * // This is: small board (0,1), local position (2,1)
      * @endcode
      *
+     * Computer players are handed to computer_move() instead, and AI
+     * players run their tree search.
+     *
      * @note Loops indefinitely until valid integer input in range is received
      * @note Does not validate move legality (empty cell, board availability)
-     * @warning Caller is responsible for deallocating the returned Move object
      *
      * @see UltimateTicTacToe::update_board() for move legality validation
      */
-    Move<char>* get_move(Player<char>* player) override {
+    Move<char> next_move(Player<char>* player) override {
+        if (player->get_type() == PlayerType::COMPUTER)
+            return computer_move(player);
+        if (player->get_type() == PlayerType::AI)
+            return static_cast<Searcher<char>*>(player)->choose_move();
+
         int x = 0, y = 0;
         while (true) {
             std::cout << player->get_name() << " (" << player->get_symbol() << ") enter move (row col) [0-8]: ";
@@ -193,8 +228,21 @@ public:
                 std::cout << "Coordinates out of range. Use values 0..8.\n";
                 continue;
             }
-            return new Move<char>(x, y, player->get_symbol());
+            return Move<char>(x, y, player->get_symbol());
         }
     }
+
+    /**
+     * @brief Picks a random legal global cell [0..8] x [0..8] for a computer player
+     *
+     * @param player Pointer to the Player object making the move
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if there is none
+     *
+     * @details
+     * Occupied cells and cells of decided small boards are never chosen.
+     */
+    static Move<char> computer_move(Player<char>* player) {
+        return random_move(player->get_board_ptr(), player->get_symbol());
+    }
 };
 #endif
\ No newline at end of file
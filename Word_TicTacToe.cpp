@@ -3,12 +3,49 @@
 
 using namespace std;
 
-word_XO_Board::word_XO_Board() : Board(3, 3) {
+//--------------------------------------- Word_Dictionary Implementation
+
+Word_Dictionary::Word_Dictionary() {
+    ifstream file("dic.txt");
+    if (!file.is_open()) {
+        throw runtime_error("dic.txt not found!");
+    }
+    string word;
+    while (getline(file, word)) {
+        if (!word.empty() && word.back() == '\r') word.pop_back();
+        if (word.size() != 3) continue;
+        int w[3];
+        for (int i = 0; i < 3; ++i) w[i] = code(word[i]);
+        if (w[0] == wildcard || w[1] == wildcard || w[2] == wildcard) continue;
+
+        words.set((w[0] * letters + w[1]) * letters + w[2]);
+
+        // Every way of blanking out cells, for the word and its reverse
+        for (int mask = 0; mask < 8; ++mask) {
+            int f[3], r[3];
+            for (int i = 0; i < 3; ++i) {
+                f[i] = (mask >> i & 1) ? wildcard : w[i];
+                r[i] = (mask >> i & 1) ? wildcard : w[2 - i];
+            }
+            patterns.set(pattern_index(f[0], f[1], f[2]));
+            patterns.set(pattern_index(r[0], r[1], r[2]));
+        }
+    }
+}
+
+const Word_Dictionary& Word_Dictionary::instance() {
+    static const Word_Dictionary dictionary;
+    return dictionary;
+}
+
+//--------------------------------------- word_XO_Board Implementation
+
+word_XO_Board::word_XO_Board() : dictionary(Word_Dictionary::instance()) {
+    set_symmetry(Symmetry::SQUARE);
     // Initialize all cells with blank_symbol
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
-    loadWords();
 }
 
 
@@ -23,11 +60,16 @@ bool word_XO_Board::update_board(Move<char>* move) {
 
         if (mark == 0) { // Undo move
             n_moves--;
-            board[x][y] = blank_symbol;
+            set_cell(x, y, blank_symbol);
+            word_made = false;
         }
         else { // Apply move
             n_moves++;
-            board[x][y] = toupper(mark);
+            set_cell(x, y, toupper(mark));
+            // Only lines through the new letter can have become words
+            word_made = any_line_through<3>(x * columns + y, [this](const array<char, 3>& line) {
+                return dictionary.is_word(line[0], line[1], line[2]);
+            });
         }
 
         return true;
@@ -35,58 +77,40 @@ bool word_XO_Board::update_board(Move<char>* move) {
     return false;
 }
 
-bool word_XO_Board::is_win(Player<char>* player) {
-
-    // Check rows and columns
-
-    for (int i = 0; i < rows; ++i) {
-        string row_word = { board[i][0], board[i][1], board[i][2] };
-        string col_word = {board[0][i], board[1][i], board[2][i] };
-        if((row_word.find(blank_symbol) == string::npos && checkinFile(row_word)) ||
-           (col_word.find(blank_symbol) == string::npos && checkinFile(col_word)) ) {
-            return true;
-        }
-    }
+void word_XO_Board::save_state() {
+    push_state(word_made);
+}
 
-    string mainDiagonal = {board[0][0], board[1][1], board[2][2]};
-    string subdiagonal = {board[0][2], board[1][1], board[2][0]};
-    // Check diagonals
-    if ((mainDiagonal.find(blank_symbol) == string::npos && checkinFile(mainDiagonal)) ||
-           (subdiagonal.find(blank_symbol) == string::npos && checkinFile(subdiagonal)))
-        return true;
+void word_XO_Board::restore_state() {
+    pop_state(word_made);
+}
 
-    return false;
+bool word_XO_Board::is_win(Player<char>* player) {
+    return word_made;
 }
 
 
 
 bool word_XO_Board::is_draw(Player<char>* player) {
-    return (n_moves==9 && !is_win(player));
+    return (n_moves==9 && !word_made);
 }
 
 bool word_XO_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
-void word_XO_Board::loadWords() {
-    file.open("dic.txt");
-    if (!file.is_open()) {
-        throw runtime_error("dic.txt not found!");
-    }
-    string word;
-    while (getline(file, word))
-        words.insert(word);
-    file.close();
+void word_XO_Board::generate_moves(char symbol, MoveList<char>& moves) {
+    moves.clear();
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < columns; ++j) {
+            if (board[i][j] != blank_symbol) continue;
+            for (char letter = 'A'; letter <= 'Z'; ++letter)
+                moves.push(Move<char>(i, j, letter));
+        }
 }
 
-
-bool word_XO_Board::checkinFile(string& target) {
-    string rev = target;
-    reverse(rev.begin(), rev.end());
-
-    if (words.contains(target) || words.contains(rev))
-        return true;
-    return false;
+bool word_XO_Board::checkinFile(const string& target) const {
+    return target.size() == 3 && dictionary.is_word(target[0], target[1], target[2]);
 }
 
 
@@ -119,7 +143,7 @@ Player<char> **word_XO_UI::setup_players() {
 }
 
 
-Move<char>* word_XO_UI::get_move(Player<char>* player) {
+Move<char> word_XO_UI::next_move(Player<char>* player) {
     int x, y;
     char letter;
     if (player->get_type() == PlayerType::HUMAN) {
@@ -146,9 +170,11 @@ Move<char>* word_XO_UI::get_move(Player<char>* player) {
     }
 
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % 3;
-        y = rand() % 3;
-        letter = 'A' + (rand() % 26);
+        return computer_move(player);
     }
-    return new Move<char>(x, y, letter);
+    return Move<char>(x, y, letter);
+}
+
+Move<char> word_XO_UI::computer_move(Player<char>* player) {
+    return random_move(player->get_board_ptr(), player->get_symbol());
 }
@@ -28,8 +28,84 @@
 
 #include <bits/stdc++.h>
 #include "BoardGame_Classes.h"
+#include "FixedBoard.h"
 using namespace std;
 
+/**
+ * @class Word_Dictionary
+ * @brief Process-wide, read-only index of the 3-letter words in "dic.txt".
+ *
+ * The dictionary is read once, on the first call to instance(), and shared
+ * by every word_XO_Board afterwards. Words are stored as a 26x26x26 bitset,
+ * so a lookup is a single bit test with no string allocation.
+ *
+ * @details
+ * Alongside the exact-word bitset the index keeps a pattern table over
+ * 27x27x27 entries (26 letters plus a wildcard). A pattern is set when some
+ * dictionary word matches it read forward or backward, which answers
+ * "can any word still complete this line?" in O(1) for search players.
+ *
+ * The index never changes after construction, so it can be read from any
+ * number of threads without locking.
+ */
+class Word_Dictionary {
+private:
+    static constexpr int letters = 26;      ///< Letters A-Z
+    static constexpr int wildcard = 26;     ///< Pattern code for an empty cell
+
+    bitset<letters * letters * letters> words; ///< Exact words, forward only
+    bitset<27 * 27 * 27> patterns;             ///< Partial lines some word can complete, either direction
+
+    /**
+     * @brief Reads "dic.txt" from the working directory and fills both tables.
+     * @throws runtime_error if "dic.txt" cannot be opened
+     */
+    Word_Dictionary();
+
+    /** @brief Maps a cell to its pattern code: 0-25 for A-Z, wildcard otherwise. */
+    static int code(char c) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+        return (c >= 'A' && c <= 'Z') ? c - 'A' : wildcard;
+    }
+
+    /** @brief Index of a pattern in the 27x27x27 table. */
+    static int pattern_index(int a, int b, int c) { return (a * 27 + b) * 27 + c; }
+
+public:
+    Word_Dictionary(const Word_Dictionary&) = delete;
+    Word_Dictionary& operator=(const Word_Dictionary&) = delete;
+
+    /**
+     * @brief Returns the shared dictionary, loading it on first use.
+     * @throws runtime_error if "dic.txt" cannot be opened (the next call retries)
+     */
+    static const Word_Dictionary& instance();
+
+    /** @brief True if a, b, c spell a dictionary word left to right. */
+    bool contains(char a, char b, char c) const {
+        int x = code(a), y = code(b), z = code(c);
+        if (x == wildcard || y == wildcard || z == wildcard) return false;
+        return words[(x * letters + y) * letters + z];
+    }
+
+    /** @brief True if a, b, c spell a dictionary word forward or backward. */
+    bool is_word(char a, char b, char c) const {
+        int x = code(a), y = code(b), z = code(c);
+        if (x == wildcard || y == wildcard || z == wildcard) return false;
+        return patterns[pattern_index(x, y, z)];
+    }
+
+    /**
+     * @brief True if filling the non-letter cells of a line can form a word.
+     *
+     * Any character other than A-Z (such as the board's '.') is treated as
+     * an empty cell. A full line reduces to is_word().
+     */
+    bool can_complete(char a, char b, char c) const {
+        return patterns[pattern_index(code(a), code(b), code(c))];
+    }
+};
+
 /**
  * @class word_XO_Board
  * @brief Represents a Word-based Tic-Tac-Toe game board.
@@ -44,7 +120,7 @@ using namespace std;
  * - Each cell can contain any uppercase letter A-Z
  * - Empty cells represented by '.'
  * - All letters automatically converted to uppercase
- * - Dictionary loaded once during initialization for efficiency
+ * - Dictionary shared with every other board through Word_Dictionary
  *
  * Win Condition:
  * - Complete any row, column, or diagonal with letters
@@ -53,7 +129,7 @@ using namespace std;
  * - First valid word formation wins the game
  *
  * Dictionary System:
- * - Words loaded from "dic.txt" file into unordered_set for O(1) lookup
+ * - Words loaded once per process from "dic.txt" into Word_Dictionary
  * - File must contain one word per line
  * - Case-insensitive matching (all stored as uppercase)
  * - Supports both forward and reversed word validation
@@ -66,30 +142,37 @@ using namespace std;
  *
  * @see Board
  */
-class word_XO_Board : public Board<char> {
+class word_XO_Board final : public FixedBoard<char, 3, 3> {
 private:
     char blank_symbol = '.'; ///< Character representing an empty cell on the board
-    ifstream file; ///< File stream for reading dictionary file
-    unordered_set<string> words; ///< Set of valid English words loaded from dictionary
+    const Word_Dictionary& dictionary; ///< Shared word index used for validation
+    bool word_made = false;  ///< True if the last move completed a word
+
+    /** @brief Save the cached outcome before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override;
 
 public:
     /**
      * @brief Default constructor that initializes a 3x3 word board.
      *
-     * Initializes all cells to blank and loads the word dictionary
-     * from "dic.txt" file for word validation.
+     * Initializes all cells to blank and binds the shared word dictionary.
      *
      * @details
      * Construction process:
      * 1. Initializes 3x3 grid with blank symbols ('.')
      * 2. Sets move counter to 0
-     * 3. Calls loadWords() to populate the dictionary from "dic.txt"
+     * 3. Binds Word_Dictionary::instance(), which reads "dic.txt" only
+     *    the first time any board is created
      * 4. Prepares board for immediate gameplay
      *
      * @note Dictionary file "dic.txt" must exist in the working directory
-     * @throws May throw exceptions if dictionary file cannot be loaded
+     * @throws runtime_error if the dictionary has not been loaded yet and
+     *         "dic.txt" cannot be opened
      *
-     * @see loadWords() for dictionary loading details
+     * @see Word_Dictionary::instance()
      */
     word_XO_Board();
 
@@ -141,9 +224,8 @@ public:
      * 4. Checks anti-diagonal (top-right to bottom-left)
      *
      * For each complete line:
-     * - Extracts 3-character sequence
      * - Skips lines with blank cells
-     * - Validates against dictionary using checkinFile()
+     * - Validates the three cells against the shared dictionary
      * - Checks both forward and reverse spellings
      *
      * Example winning scenarios:
@@ -163,7 +245,8 @@ public:
      *
      * @note Any player can win regardless of who placed which letters
      * @note Words can be read forward or backward
-     * @see checkinFile() for dictionary validation logic
+     * @note update_board() looks up the lines through each new letter; this reads its result
+     * @see Word_Dictionary::is_word()
      */
     bool is_win(Player<char>* player) override;
 
@@ -227,6 +310,13 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /**
+     * @brief Lists every empty cell paired with every letter A-Z.
+     * @param symbol Symbol of the player to move (unused: both players place letters)
+     * @param moves Buffer that receives the moves; each carries its letter as the symbol
+     */
+    void generate_moves(char symbol, MoveList<char>& moves) override;
+
     /**
      * @brief Checks if a word exists in the dictionary.
      *
@@ -238,10 +328,9 @@ public:
      *
      * @details
      * Validation Process:
-     * 1. Checks if target string exists in words set (O(1) lookup)
-     * 2. If not found, creates reversed version of target
-     * 3. Checks if reversed string exists in words set
-     * 4. Returns true if either direction matches a dictionary word
+     * - Strings that are not exactly three letters are rejected
+     * - Otherwise one bit test in the shared dictionary covers both
+     *   the forward and the reversed spelling
      *
      * This dual-direction check allows words to be formed:
      * - Left-to-right or right-to-left (rows)
@@ -253,59 +342,11 @@ public:
      * - "TAC" is valid if "CAT" is in dictionary (reversed)
      * - "DOG" forward = "GOD" backward (both valid if in dictionary)
      *
-     * @note Assumes words set contains uppercase strings only
-     * @note Target should be uppercase before calling
-     *
-     * @see loadWords() for how dictionary is populated
-     */
-    bool checkinFile(string& target);
-
-    /**
-     * @brief Loads valid words from dictionary file.
-     *
-     * Opens "dic.txt" and reads all words into the internal set for
-     * fast lookup during gameplay. Must be called during initialization.
-     *
-     * @throws runtime_error if "dic.txt" file cannot be opened
+     * @note Matching is case-insensitive
      *
-     * @details
-     * Loading Process:
-     * 1. Opens "dic.txt" from current working directory
-     * 2. Reads file line by line
-     * 3. Converts each word to uppercase for case-insensitive matching
-     * 4. Inserts words into unordered_set for O(1) lookup performance
-     * 5. Closes file after loading complete
-     *
-     * Dictionary File Format:
-     * - One word per line
-     * - Any case (will be converted to uppercase)
-     * - No special formatting required
-     * - Recommended: only 3-letter words for efficiency (optional)
-     *
-     * Performance Considerations:
-     * - Uses unordered_set for constant-time word lookups
-     * - All words loaded at construction time (one-time cost)
-     * - Memory usage proportional to dictionary size
-     *
-     * Error Handling:
-     * - Throws exception if file not found or cannot be opened
-     * - Should be caught during board construction
-     * - Game cannot proceed without valid dictionary
-     *
-     * Example dic.txt content:
-     * @code
-     * CAT
-     * DOG
-     * THE
-     * ARE
-     * BAT
-     * @endcode
-     *
-     * @note File must be named exactly "dic.txt"
-     * @note File must be in the working directory or provide full path
-     * @warning Large dictionaries increase memory usage but improve gameplay
+     * @see Word_Dictionary::is_word()
      */
-    void loadWords();
+    bool checkinFile(const string& target) const;
 };
 
 
@@ -404,7 +445,7 @@ public:
      * All letters are converted to uppercase.
      *
      * @param player Pointer to the player whose move is being requested
-     * @return Pointer to a Move<char> object with position and chosen letter
+     * @return A Move<char> with position and chosen letter
      *
      * @details
      * Human Player Input:
@@ -442,9 +483,15 @@ public:
      *
      * @note Does not validate if cell is empty (handled by Board)
      * @note Does not validate if letter forms valid word (handled by Board)
-     * @warning Caller is responsible for deallocating the returned Move object
      */
-    virtual Move<char>* get_move(Player<char>* player);
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Picks a random empty cell and letter for a computer player.
+     * @param player Pointer to the player whose move is being requested
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if there is none
+     */
+    static Move<char> computer_move(Player<char>* player);
 
     /**
      * @brief Sets up both players for the word game.
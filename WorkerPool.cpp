@@ -0,0 +1,46 @@
+#include "WorkerPool.h"
+
+using namespace std;
+
+WorkerPool::WorkerPool(int threads) {
+    if (threads <= 0) threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    for (int i = 0; i < threads; ++i)
+        workers.emplace_back([this] { work(); });
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers)
+        w.join();
+}
+
+void WorkerPool::submit(function<void()> job) {
+    {
+        lock_guard<mutex> guard(lock);
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+size_t WorkerPool::pending() const {
+    lock_guard<mutex> guard(lock);
+    return jobs.size();
+}
+
+void WorkerPool::work() {
+    while (true) {
+        function<void()> job;
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file WorkerPool.h
+ * @brief Fixed pool of threads that runs queued jobs, e.g. computer moves of GameSessions.
+ */
+
+#ifndef _WORKER_POOL_H
+#define _WORKER_POOL_H
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+/**
+ * @brief Runs jobs on a fixed set of threads, in submission order.
+ *
+ * Each worker thread has its own thread_rng() stream. Destroying the pool
+ * finishes the jobs already queued, then joins the threads.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Start the worker threads.
+     * @param threads Number of threads; 0 uses every hardware thread.
+     */
+    explicit WorkerPool(int threads = 0);
+
+    /** @brief Finish the queued jobs and join the threads. */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /** @brief Queue a job to run on one of the workers. */
+    void submit(function<void()> job);
+
+    /** @brief Number of worker threads. */
+    int size() const { return static_cast<int>(workers.size()); }
+
+    /** @brief Jobs queued and not started yet. */
+    size_t pending() const;
+
+private:
+    mutable mutex lock;           ///< Guards jobs and stopping
+    condition_variable wake;      ///< Signalled when a job is queued or the pool stops
+    deque<function<void()>> jobs; ///< Jobs not started yet
+    vector<thread> workers;       ///< Worker threads
+    bool stopping = false;        ///< Set by the destructor
+
+    /** @brief Worker loop: run jobs until the pool stops and the queue is empty. */
+    void work();
+};
+
+#endif // _WORKER_POOL_H
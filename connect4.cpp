@@ -6,11 +6,59 @@ using namespace std;
 //--------------------------------------- connect4_Board Implementation
 
 CONNECT_Board::CONNECT_Board() : Board(6, 7) {
+    set_symmetry(Symmetry::MIRROR);
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
 }
 
+int CONNECT_Board::side_of(char symbol) {
+    switch (toupper(symbol)) {
+        case 'X': return 0;
+        case 'O': return 1;
+        default: return -1;
+    }
+}
+
+bool CONNECT_Board::has_four(uint64_t stones) {
+    // vertical, horizontal, main diagonal, anti-diagonal
+    for (int shift : {1, 7, 8, 6}) {
+        uint64_t pairs = stones & (stones >> shift);
+        if (pairs & (pairs >> (2 * shift)))
+            return true;
+    }
+    return false;
+}
+
+uint64_t CONNECT_Board::winning_cells(uint64_t stones, uint64_t filled) {
+    // Column bits 0-5 are playable; bit 6 is the sentinel
+    const uint64_t playable = 0x3FULL * 0x40810204081ULL;
+
+    // Three below the cell, stacked vertically
+    uint64_t cells = (stones << 1) & (stones << 2) & (stones << 3);
+    for (int shift : {7, 8, 6}) {
+        // Two stones on one side and one or two on the other, in both directions
+        uint64_t pair = (stones << shift) & (stones << 2 * shift);
+        cells |= pair & (stones << 3 * shift);
+        cells |= pair & (stones >> shift);
+        pair = (stones >> shift) & (stones >> 2 * shift);
+        cells |= pair & (stones << shift);
+        cells |= pair & (stones >> 3 * shift);
+    }
+    return cells & playable & ~filled;
+}
+
+int CONNECT_Board::drop_row(int column) const {
+    if (column < 0 || column >= columns || height[column] >= rows)
+        return -1;
+    return rows - 1 - height[column];
+}
+
+uint64_t CONNECT_Board::get_bitboard(char symbol) const {
+    int side = side_of(symbol);
+    return side < 0 ? 0 : bitboard[side];
+}
+
 bool CONNECT_Board::update_board(Move<char>* move) {
     int x = move->get_x();
     int y = move->get_y();
@@ -20,97 +68,133 @@ bool CONNECT_Board::update_board(Move<char>* move) {
         return false;
     }
 
-    if (board[x][y] == blank_symbol || mark == 0) {
-        if (mark == 0)
-        {
-            n_moves--;
-            board[x][y] = blank_symbol;
-        }
-        else
-        {
-            n_moves++;
-            board[x][y] = toupper(mark);
-        }
+    if (mark == 0) {
+        // Only the top stone of a column can be taken back
+        if (height[y] == 0 || x != rows - height[y])
+            return false;
+        n_moves--;
+        height[y]--;
+        bitboard[0] &= ~cell_bit(x, y);
+        bitboard[1] &= ~cell_bit(x, y);
+        set_cell(x, y, blank_symbol);
+        winner = -1;
         return true;
     }
 
-    return false;
+    int side = side_of(mark);
+    if (side < 0 || x != drop_row(y))
+        return false;
+
+    n_moves++;
+    height[y]++;
+    bitboard[side] |= cell_bit(x, y);
+    set_cell(x, y, toupper(mark));
+    // Only the mover's stones changed, so only the mover can have made four
+    winner = has_four(bitboard[side]) ? side : -1;
+    return true;
 }
 
-bool CONNECT_Board::is_win(Player<char>* player) {
+void CONNECT_Board::save_state() {
+    push_state(bitboard);
+    push_state(height);
+    push_state(winner);
+}
 
-    for (int i = 0; i < 6; i++)
-    {
-        for (int j = 0; j < 4; j++)
-        {
-            if (board[i][j] == player->get_symbol() &&
-                board[i][j + 1] == player->get_symbol() &&
-                board[i][j + 2] == player->get_symbol() &&
-                board[i][j + 3] == player->get_symbol())
+void CONNECT_Board::restore_state() {
+    pop_state(winner);
+    pop_state(height);
+    pop_state(bitboard);
+}
 
-                return true;
-        }
-    }
+bool CONNECT_Board::is_win(Player<char>* player) {
+    int side = side_of(player->get_symbol());
+    return side >= 0 && side == winner;
+}
 
-    for (int j = 0; j < 7; j++)
-    {
-        for (int i = 0; i < 3; i++)
-        {
-            if (board[i][j] == player->get_symbol() &&
-                board[i + 1][j] == player->get_symbol() &&
-                board[i + 2][j] == player->get_symbol() &&
-                board[i + 3][j] == player->get_symbol())
+bool CONNECT_Board::is_lose(Player<char>* player) {
+    return false;
+}
 
-                return true;
-        }
-    }
+bool CONNECT_Board::is_draw(Player<char>* player) {
+    return (n_moves == 42 && winner < 0);
+}
 
-    for (int i = 0; i < 3; i++)
-    {
-        for (int j = 0; j < 4; j++)
-        {
-            if (board[i][j] == player->get_symbol() &&
-                board[i + 1][j + 1] == player->get_symbol() &&
-                board[i + 2][j + 2] == player->get_symbol() &&
-                board[i + 3][j + 3] == player->get_symbol())
+bool CONNECT_Board::game_is_over(Player<char>* player) {
+    return is_win(player) || is_draw(player);
+}
 
-                return true;
-        }
+void CONNECT_Board::generate_moves(char symbol, MoveList<char>& moves) {
+    static const int order[7] = { 3, 2, 4, 1, 5, 0, 6 };
+    moves.clear();
+    for (int column : order) {
+        int row = drop_row(column);
+        if (row >= 0)
+            moves.push(Move<char>(row, column, symbol));
     }
+}
 
-    for (int i = 0; i < 3; i++)
-    {
-        for (int j = 3; j < 7; j++)
-        {
-            if (board[i][j] == player->get_symbol() &&
-                board[i + 1][j - 1] == player->get_symbol() &&
-                board[i + 2][j - 2] == player->get_symbol() &&
-                board[i + 3][j - 3] == player->get_symbol())
-
-                return true;
+int CONNECT_Board::evaluate(char symbol) {
+    int side = side_of(symbol);
+    if (side < 0) return 0;
+    uint64_t own = bitboard[side], opp = bitboard[1 - side];
+    uint64_t filled = own | opp;
+    // Cells a stone can land on right now
+    uint64_t playable_now = (filled + 0x40810204081ULL) & (0x3FULL * 0x40810204081ULL);
+
+    uint64_t own_threats = winning_cells(own, filled);
+    uint64_t opp_threats = winning_cells(opp, filled);
+    const uint64_t centre = 0x3FULL << (3 * 7);
+
+    return 4 * (popcount(own_threats) - popcount(opp_threats))
+         + 4 * (popcount(own_threats & playable_now) - popcount(opp_threats & playable_now))
+         + popcount(own & centre) - popcount(opp & centre);
+}
 
-        }
-    }
-    return false;
+uint64_t CONNECT_Board::position_key() const {
+    return bitboard[0] + (bitboard[0] | bitboard[1]);
 }
 
-bool CONNECT_Board::is_lose(Player<char>* player) {
-    return(n_moves == 42 && !is_win(player));
+uint64_t CONNECT_Board::book_key(bool& mirrored) const {
+    uint64_t key = position_key(), mirror = 0;
+    for (int c = 0; c < 7; ++c)
+        mirror |= ((key >> (7 * c)) & 0x7F) << (7 * (6 - c));
+    mirrored = mirror < key;
+    return mirrored ? mirror : key;
 }
 
-bool CONNECT_Board::is_draw(Player<char>* player) {
-    return (n_moves == 42 && !is_win(player));
+bool CONNECT_Board::book_move(const OpeningBook& book, char symbol, Move<char>& move) const {
+    bool mirrored;
+    BookEntry entry;
+    if (!book.find(book_key(mirrored), entry))
+        return false;
+    int column = entry.cell % 7;
+    if (mirrored) column = 6 - column;
+    int row = drop_row(column);
+    if (row < 0)
+        return false;
+    move = Move<char>(row, column, symbol);
+    return true;
 }
 
-bool CONNECT_Board::game_is_over(Player<char>* player) {
-    return is_win(player) || is_draw(player);
+const OpeningBook* connect4_book() {
+    static unique_ptr<OpeningBook> book([]() -> OpeningBook* {
+        const char* path = getenv("CONNECT4_BOOK");
+        if (!path && !ifstream("connect4.book")) return nullptr;
+        try {
+            return new OpeningBook(path ? path : "connect4.book");
+        } catch (const exception& e) {
+            cerr << e.what() << ": playing without an opening book\n";
+            return nullptr;
+        }
+    }());
+    return book.get();
 }
 
 
 
 Player<char>** CONNECT_UI::setup_players() {
     Player<char>** players = new Player<char>*[2];
-    vector<string> type_options = { "Human", "Computer" };
+    vector<string> type_options = player_type_options();
 
     string nameX = get_player_name("Player 1");
     PlayerType typeX = get_player_type_choice("Player 1", type_options);
@@ -124,52 +208,54 @@ Player<char>** CONNECT_UI::setup_players() {
 
 Player<char>* CONNECT_UI::create_player(string& name, char symbol, PlayerType type)
 {
-    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
+    cout << "Creating " << (type == PlayerType::HUMAN ? "human" : type == PlayerType::AI ? "AI" : "computer")
         << " player: " << name << " (" << symbol << ")\n";
 
+    if (type == PlayerType::AI) {
+        AI_Player<char, CONNECT_Board>* ai = new AI_Player<char, CONNECT_Board>(name, symbol, symbol == 'X' ? 'O' : 'X', 12);
+        ai->set_canonical_keys(true); // mirrored positions share table entries
+        ai->set_book(connect4_book());
+        return ai;
+    }
     return new Player<char>(name, symbol, type);
 }
 
-Move<char>* CONNECT_UI::get_move(Player<char>* player)
+vector<string> CONNECT_UI::player_type_options() const {
+    return { "Human", "Computer", "AI" };
+}
+
+Move<char> CONNECT_UI::next_move(Player<char>* player)
 {
+    if (player->get_type() == PlayerType::COMPUTER)
+        return computer_move(player);
+    if (player->get_type() == PlayerType::AI)
+        return static_cast<Searcher<char>*>(player)->choose_move();
+
     int column;
-    Board<char>* board = player->get_board_ptr();
-
-    if (player->get_type() == PlayerType::HUMAN) {
-        cout << "\n" << player->get_name() << " (" << player->get_symbol() << ")"
-            << ", enter column number (0-6): ";
-        while (true) {
-            cin >> column;
-            if (cin.fail() || column < 0 || column >= 7) {
-                cout << "Invalid input! Please enter a column number between 0 and 6: ";
-                cin.clear();
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            }
-            else if (board->get_board_matrix()[0][column] != '.') {
-                cout << "Column " << column << " is full! Please choose another column: ";
-            }
-            else {
-                break;
-            }
+    CONNECT_Board* board = dynamic_cast<CONNECT_Board*>(player->get_board_ptr());
+
+    cout << "\n" << player->get_name() << " (" << player->get_symbol() << ")"
+        << ", enter column number (0-6): ";
+    while (true) {
+        cin >> column;
+        if (cin.fail() || column < 0 || column >= 7) {
+            cout << "Invalid input! Please enter a column number between 0 and 6: ";
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
         }
-    }
-    else if (player->get_type() == PlayerType::COMPUTER) {
-        // Keep trying until we find a column that's not full
-        do {
-            column = rand() % 7;
-        } while (board->get_board_matrix()[0][column] != '.');
-
-    }
-
-    // Find the lowest empty row in the chosen column
-    int row = -1;
-    for (int r = 5; r >= 0; r--) {  // Start from bottom row
-        if (board->get_cell(r, column) == '.')
-        {
-            row = r;
-            break;  // Found the lowest empty position
+        else if (board->column_full(column)) {
+            cout << "Column " << column << " is full! Please choose another column: ";
+        }
+        else {
+            break;
         }
     }
 
-    return new Move<char>(row, column, player->get_symbol());
+    // The column height tells us where the stone lands
+    return Move<char>(board->drop_row(column), column, player->get_symbol());
+}
+
+Move<char> CONNECT_UI::computer_move(Player<char>* player)
+{
+    return random_move(player->get_board_ptr(), player->get_symbol());
 }
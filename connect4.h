@@ -8,7 +8,10 @@
  */
 
 #pragma once
+#include <cstdint>
 #include "BoardGame_Classes.h"
+#include "AI_Player.h"
+#include "OpeningBook.h"
 using namespace std;
 
 /**
@@ -17,10 +20,58 @@ using namespace std;
  *
  * This class manages the Connect 4 game board state, updates, and win conditions.
  * It inherits from the Board template class with char type for board symbols.
+ *
+ * @details
+ * Besides the character grid required by Board<char>, the board keeps a
+ * bitboard per player and the height of every column. Column c occupies
+ * bits [7c, 7c + 6): bit 7c + h is the stone h cells above the bottom row.
+ * The 7th bit of every column is a sentinel that always stays clear, so
+ * shifting a mask never carries a line from one column into the next.
  */
-class CONNECT_Board : public Board<char> {
+class CONNECT_Board final : public Board<char> {
 private:
     char blank_symbol = '.';  ///< Symbol used to represent empty cells on the board
+    uint64_t bitboard[2] = { 0, 0 }; ///< Stones of 'X' (index 0) and 'O' (index 1)
+    int height[7] = { 0 };           ///< Number of stones in each column
+    int winner = -1;                 ///< Side whose last stone made four, or -1
+
+    /** @brief Save the bitboards, column heights and cached outcome before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore what save_state() saved. */
+    void restore_state() override;
+
+    /**
+     * @brief Map a player symbol to its bitboard index
+     * @param symbol Player symbol (case-insensitive)
+     * @return 0 for 'X', 1 for 'O', -1 for anything else
+     */
+    static int side_of(char symbol);
+
+    /**
+     * @brief Bit of the cell at (row, column) in the bitboard layout
+     */
+    static uint64_t cell_bit(int row, int column) {
+        return uint64_t(1) << (column * 7 + (5 - row));
+    }
+
+    /**
+     * @brief Check a bitboard for four aligned stones
+     * @param stones Bitboard of a single player
+     * @return true if any vertical, horizontal or diagonal four is present
+     *
+     * Uses the shift-and-AND trick: shifting by 1, 7, 6 and 8 moves every
+     * stone one step up, right, down-right and up-right respectively.
+     */
+    static bool has_four(uint64_t stones);
+
+    /**
+     * @brief Empty cells that would complete a four for a player
+     * @param stones Bitboard of the player
+     * @param filled Bitboard of all stones on the board
+     * @return Bitboard of the empty cells (reachable or not) that win for the player
+     */
+    static uint64_t winning_cells(uint64_t stones, uint64_t filled);
 
 public:
     /**
@@ -36,24 +87,47 @@ public:
      * @return true if the move was successfully applied, false otherwise
      *
      * Applies the specified move to the board, handling gravity (pieces fall down).
+     * A stone is only accepted on the lowest empty row of its column, and the
+     * undo path (symbol 0) only lifts the top stone of a column.
      */
     bool update_board(Move<char>* move_ptr) override;
 
+    /**
+     * @brief Row a stone dropped in the given column lands on
+     * @param column Column index (0-6)
+     * @return Row index (0-5), or -1 if the column is full or out of range
+     */
+    int drop_row(int column) const;
+
+    /**
+     * @brief Checks whether a column can take another stone
+     * @param column Column index (0-6)
+     * @return true if the column is full or out of range
+     */
+    bool column_full(int column) const { return drop_row(column) < 0; }
+
+    /**
+     * @brief Bitboard of the stones owned by a symbol
+     * @param symbol Player symbol ('X' or 'O')
+     * @return Bitboard in the column-major layout described above, 0 for unknown symbols
+     */
+    uint64_t get_bitboard(char symbol) const;
+
     /**
      * @brief Checks if the specified player has won the game
      * @param player Pointer to the Player object to check for win condition
      * @return true if the player has connected 4 pieces in a row, false otherwise
      *
-     * Checks horizontal, vertical, and diagonal connections.
+     * Checks horizontal, vertical, and diagonal connections on the player's bitboard.
      */
     bool is_win(Player<char>* player) override;
 
     /**
      * @brief Checks if the specified player has lost the game
      * @param player Pointer to the Player object to check for lose condition
-     * @return true if the player has lost, false otherwise
+     * @return Always false
      *
-     * In Connect 4, this typically returns false as there's no lose condition.
+     * In Connect 4 there's no lose condition; a full board is a draw.
      */
     bool is_lose(Player<char>* player) override;
 
@@ -70,8 +144,63 @@ public:
      * @return true if the game is over (win or draw), false otherwise
      */
     bool game_is_over(Player<char>* player) override;
+
+    /**
+     * @brief Lists the landing cell of every non-full column, centre columns first
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
+     */
+    void generate_moves(char symbol, MoveList<char>& moves) override;
+
+    /**
+     * @brief Heuristic score of the position for a player
+     * @param symbol The player the score is for
+     * @return Weighted difference of threats (empty cells completing a four)
+     *         and centre-column stones
+     *
+     * Threats on the row a stone can be dropped into right away count double.
+     */
+    int evaluate(char symbol) override;
+
+    /**
+     * @brief Unique key of the position
+     * @return Stones of 'X' plus the mask of all stones
+     *
+     * Adding the mask gives every column a distinct value per height and
+     * owner pattern without carries into the next column.
+     */
+    uint64_t position_key() const override;
+
+    /**
+     * @brief Key of the position or of its mirror image, whichever is smaller
+     * @param mirrored Set to true if the key is the mirror image's
+     * @return position_key() of the chosen orientation
+     *
+     * Every column packs into its own 7 bits of position_key(), so the
+     * mirror image's key is the same columns in reverse order. The key is
+     * exact: two positions share it only if they are mirror images.
+     */
+    uint64_t book_key(bool& mirrored) const;
+
+    /**
+     * @brief Move stored in an opening book for this position
+     * @param book Book written with book_key() keys
+     * @param symbol Symbol of the player to move
+     * @param move Set to the book move, mirrored back if the key was the mirror image's
+     * @return true if the book holds the position and its column is playable
+     */
+    bool book_move(const OpeningBook& book, char symbol, Move<char>& move) const override;
 };
 
+/**
+ * @brief The Connect 4 opening book the AI players use
+ * @return The book named by the CONNECT4_BOOK environment variable, or
+ *         connect4.book in the working directory; nullptr if there is none
+ *
+ * The file is mapped on the first call and shared by every caller after.
+ */
+const OpeningBook* connect4_book();
+
 /**
  * @class CONNECT_UI
  * @brief User interface handler for Connect 4 game
@@ -110,12 +239,24 @@ public:
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type) override;
 
+    /**
+     * @brief Offers Human, Computer and AI players
+     */
+    vector<string> player_type_options() const override;
+
     /**
      * @brief Gets a move from the specified player
      * @param player Pointer to the Player making the move
-     * @return Pointer to a Move object containing the player's chosen move
+     * @return A Move containing the player's chosen move
      *
      * Prompts the player for their move and validates the input.
      */
-    Move<char>* get_move(Player<char>* player) override;
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Picks a random non-full column for a computer player
+     * @param player Pointer to the Player making the move (must be attached to a CONNECT_Board)
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if every column is full
+     */
+    static Move<char> computer_move(Player<char>* player);
 };
\ No newline at end of file
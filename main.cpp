@@ -9,8 +9,11 @@
 
 #include <iostream>
 #include <ctime> 
+#include <cstdlib>
+#include <fstream>
 
 #include "BoardGame_Classes.h"
+#include "Searcher.h"
 #include "Inf_TicTacToe.h"
 #include "Word_TicTacToe.h"
 #include "obs_TicTacToe.h"
@@ -29,11 +32,62 @@
 #include "Ultimate_UI.h"
 using namespace std;
 
+/**
+ * @brief Statistics of every game played in this session, or nullptr.
+ *
+ * Instrumentation is on only when the GAME_STATS environment variable names
+ * a file; after each game the running totals are appended to it as one JSON line.
+ */
+GameStats* session_stats() {
+    static unique_ptr<GameStats> stats(getenv("GAME_STATS") ? new GameStats() : nullptr);
+    return stats.get();
+}
+
+/**
+ * @brief Record file every game of this session is appended to, or nullptr.
+ *
+ * Recording is on only when the GAME_RECORD environment variable names a
+ * file (see GameRecord.h for the format). A file that cannot be opened or is
+ * not a record file is reported once, and the session is not recorded.
+ */
+GameRecordWriter* session_record() {
+    static unique_ptr<GameRecordWriter> writer([]() -> GameRecordWriter* {
+        const char* path = getenv("GAME_RECORD");
+        if (!path) return nullptr;
+        try {
+            return new GameRecordWriter(path);
+        } catch (const exception& e) {
+            cerr << e.what() << ": playing without recording\n";
+            return nullptr;
+        }
+    }());
+    return writer.get();
+}
+
+/**
+ * @brief Time budget of every AI move in milliseconds, or 0 to keep each game's own setting.
+ *
+ * Set by the AI_THINK_MS environment variable.
+ */
+int session_think_ms() {
+    static const int ms = getenv("AI_THINK_MS") ? max(atoi(getenv("AI_THINK_MS")), 0) : 0;
+    return ms;
+}
+
 template<typename T>
-void set_up(UI<T>* ui, Board<T>* board) {
+void set_up(UI<T>* ui, Board<T>* board, int variant) {
     Player<T>** players = ui->setup_players();
+    for (int i = 0; i < 2 && session_think_ms() > 0; ++i)
+        if (Searcher<T>* searcher = dynamic_cast<Searcher<T>*>(players[i]))
+            searcher->set_think_ms(session_think_ms());
     GameManager<T> gameManager(board, players, ui);
+    gameManager.set_stats(session_stats());
+    gameManager.set_record(session_record(), variant);
     gameManager.run();
+    if (GameStats* stats = session_stats())
+        ofstream(getenv("GAME_STATS"), ios::app) << stats->to_json() << "\n";
+    if (GameRecordWriter* writer = session_record())
+        writer->flush();
     delete ui;
     delete board;
     for (int i = 0; i < 2; ++i) {
@@ -66,55 +120,55 @@ void menu() {
         switch (choice) {
             case 0: break;
             case 1: {
-                set_up(new SUS_UI(), new SUS_Board());
+                set_up(new SUS_UI(), new SUS_Board(), 1);
                 break;
             }
             case 2: {
-                set_up(new CONNECT_UI(), new CONNECT_Board());
+                set_up(new CONNECT_UI(), new CONNECT_Board(), 2);
                 break;
             }
             case 3: {
-                set_up(new TicTacToe_5x5_UI, new TicTacToe_5x5_board());
+                set_up(new TicTacToe_5x5_UI, new TicTacToe_5x5_board(), 3);
                 break;
             }
             case 4: {
-                set_up(new word_XO_UI(), new word_XO_Board());
+                set_up(new word_XO_UI(), new word_XO_Board(), 4);
                 break;
             }
             case 5: {
-                set_up(new Inverse_XO_UI(), new InverseTicTacToe<char>());
+                set_up(new Inverse_XO_UI(), new InverseTicTacToe<char>(), 5);
                 break;
             }
             case 6: {
-                set_up(new Diamond_UI(), new DiamondTicTacToe<char>());
+                set_up(new Diamond_UI(), new DiamondTicTacToe<char>(), 6);
                 break;
             }
             case 7: {
-                set_up(new XO_4x4_UI(), new XO_4x4_Board());
+                set_up(new XO_4x4_UI(), new XO_4x4_Board(), 7);
                 break;
             }
             case 8: {
-                set_up(new Pyramid_XO_UI, new Pyramid_XO_Board());
+                set_up(new Pyramid_XO_UI, new Pyramid_XO_Board(), 8);
                 break;
             }
             case 9: {
-                set_up(new Numerical_XO_UI(), new Numerical_XO_Board());
+                set_up(new Numerical_XO_UI(), new Numerical_XO_Board(), 9);
                 break;
             }
             case 10: {
-                set_up(new obs_TicTacToe_UI(), new obs_TicTacToe_board());
+                set_up(new obs_TicTacToe_UI(), new obs_TicTacToe_board(), 10);
                 break;
             }
             case 11: {
-                set_up(new Inf_XO_UI(), new Inf_XO_Board());
+                set_up(new Inf_XO_UI(), new Inf_XO_Board(), 11);
                 break;
             }
             case 12: {
-                set_up(new Ultimate_UI(), new UltimateTicTacToe<char>());
+                set_up(new Ultimate_UI(), new UltimateTicTacToe<char>(), 12);
                 break;
             }
             case 13: {
-                set_up(new Memory_UI(), new Memory_Board());
+                set_up(new Memory_UI(), new Memory_Board(), 13);
                 break;
             }
             default:
@@ -139,7 +193,7 @@ void menu() {
 
 
 int main() {
-    srand(static_cast<unsigned int>(time(0)));  // Seed the random number generator
+    seed_random(static_cast<uint64_t>(time(0)));  // Seed the random number generator
     cout<<"Welcome to FCAI Game Hub";
     menu();
     return 0; // Exit successfully
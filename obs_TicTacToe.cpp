@@ -1,12 +1,11 @@
 #include <bits/stdc++.h>
 #include "obs_TicTacToe.h"
 
-
-obs_TicTacToe_board::obs_TicTacToe_board() : Board(6, 6), last_col_play(0), last_row_play(0) {
-    for (int i=0;i<6;i++) {
-        for (int j=0;j<6;j++) {
-            coordinates.emplace_back(i,j);
-        }
+obs_TicTacToe_board::obs_TicTacToe_board() : Board(6, 6), last_col_play(0), last_row_play(0), obstacle_seed(thread_rng().next()), rng(obstacle_seed) {
+    set_symmetry(Symmetry::SQUARE);
+    for (int i = 0; i < CELLS; i++) {
+        free_cells[i] = i;
+        free_pos[i] = i;
     }
     for (auto& row : board)
         for (auto& cell : row) {
@@ -19,26 +18,21 @@ bool obs_TicTacToe_board::update_board(Move<char>* move) {
     int y = move->get_y();
     char mark = move->get_symbol();
 
-    // Validate move and apply if valid
+    // Validate move and apply if valid; a symbol-0 undo could not take back
+    // the obstacles, so moves are taken back with unmake_move() only
     if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
-        (board[x][y] == blank_symbol || mark == 0)) {
-
-        if (mark == 0) { // Undo move
-            n_moves--;
-            board[x][y] = blank_symbol;
-        }
-        else { // Apply move
-            n_moves++;
-            board[x][y] = toupper(mark);
-            // Remove used coordinate from available list
-            auto it = find(coordinates.begin(), coordinates.end(), make_pair(x, y));
-            if (it != coordinates.end()) coordinates.erase(it);
-            // Place random obstacles after move
-            random_obs();
-            // Track last move position for win checking
-            last_row_play =x;
-            last_col_play =y;
-        }
+        board[x][y] == blank_symbol && mark != 0) {
+        n_moves++;
+        set_cell(x, y, toupper(mark));
+        // Remove used cell from the free set
+        take_free(x * columns + y);
+        // Place random obstacles after move
+        random_obs();
+        // Track last move position for win checking
+        last_row_play =x;
+        last_col_play =y;
+        winner = four_through(x, y, toupper(mark)) ? toupper(mark) : 0;
+        drawn = !winner && free_count == 0; // the free set is exactly the blank cells
 
         return true;
     }
@@ -47,13 +41,62 @@ bool obs_TicTacToe_board::update_board(Move<char>* move) {
 
 void obs_TicTacToe_board::random_obs() {
     for(int i=0;i<2;i++) {
-        if (coordinates.empty()) break;
-        int rand_coordinate = (rand() % coordinates.size());
-        board[coordinates[rand_coordinate].first][coordinates[rand_coordinate].second] = obstacle_symbol;
-        coordinates.erase(coordinates.begin() + rand_coordinate);
+        if (free_count == 0) break;
+        int cell = free_cells[rng.below(free_count)];
+        set_cell(cell / columns, cell % columns, obstacle_symbol);
+        take_free(cell);
     }
 }
 
+void obs_TicTacToe_board::seed(uint64_t value) {
+    obstacle_seed = value;
+    rng.seed(value);
+}
+
+bool obs_TicTacToe_board::is_free(int cell) const {
+    return free_pos[cell] < free_count && free_cells[free_pos[cell]] == cell;
+}
+
+void obs_TicTacToe_board::take_free(int cell) {
+    int pos = free_pos[cell];
+    int last = free_cells[--free_count];
+    free_cells[pos] = last;
+    free_pos[last] = pos;
+    free_cells[free_count] = cell;
+    free_pos[cell] = pos; // Kept so restore_free() can swap it back
+}
+
+void obs_TicTacToe_board::restore_free() {
+    int cell = free_cells[free_count];
+    int pos = free_pos[cell];
+    int last = free_cells[pos];
+    free_cells[free_count] = last;
+    free_pos[last] = free_count;
+    free_cells[pos] = cell;
+    ++free_count;
+}
+
+void obs_TicTacToe_board::save_state() {
+    push_state(free_count);
+    push_state(rng);
+    push_state(last_row_play);
+    push_state(last_col_play);
+    push_state(winner);
+    push_state(drawn);
+}
+
+void obs_TicTacToe_board::restore_state() {
+    int count;
+    pop_state(drawn);
+    pop_state(winner);
+    pop_state(last_col_play);
+    pop_state(last_row_play);
+    pop_state(rng);
+    pop_state(count);
+    while (free_count < count)
+        restore_free();
+}
+
 int obs_TicTacToe_board::dir_cnt(int x, int y, int dr, int dc, char sym) {
     int count = 0;
     int r = x + dr;
@@ -68,10 +111,7 @@ int obs_TicTacToe_board::dir_cnt(int x, int y, int dr, int dc, char sym) {
 
 
 
-bool obs_TicTacToe_board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-    int x = last_row_play;
-    int y = last_col_play;
+bool obs_TicTacToe_board::four_through(int x, int y, char sym) {
     // Check horizontal (left + right + center)
     if (dir_cnt(x, y, 0, -1, sym) + dir_cnt(x, y, 0, 1, sym) + 1 >= 4)
         return true;
@@ -87,6 +127,10 @@ bool obs_TicTacToe_board::is_win(Player<char>* player) {
     return false;
 }
 
+bool obs_TicTacToe_board::is_win(Player<char>* player) {
+    return winner != 0 && winner == player->get_symbol();
+}
+
 bool obs_TicTacToe_board::isFull() {
     for (auto& row : board)
         for (auto& cell : row) {
@@ -98,13 +142,17 @@ bool obs_TicTacToe_board::isFull() {
 }
 
 bool obs_TicTacToe_board::is_draw(Player<char>* player) {
-    return (isFull() && !is_win(player));
+    return drawn;
 }
 
 bool obs_TicTacToe_board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+void obs_TicTacToe_board::generate_moves(char symbol, MoveList<char>& moves) {
+    generate_placements(blank_symbol, symbol, moves);
+}
+
 
 
 
@@ -118,7 +166,7 @@ Player<char>* obs_TicTacToe_UI::create_player(string& name, char symbol, PlayerT
     return new Player<char>(name, symbol, type);
 }
 
-Move<char>* obs_TicTacToe_UI::get_move(Player<char>* player) {
+Move<char> obs_TicTacToe_UI::next_move(Player<char>* player) {
     int x, y;
 
     if (player->get_type() == PlayerType::HUMAN) {
@@ -134,8 +182,11 @@ Move<char>* obs_TicTacToe_UI::get_move(Player<char>* player) {
         }
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
+        return computer_move(player);
     }
-    return new Move<char>(x, y, player->get_symbol());
+    return Move<char>(x, y, player->get_symbol());
+}
+
+Move<char> obs_TicTacToe_UI::computer_move(Player<char>* player) {
+    return random_move(player->get_board_ptr(), player->get_symbol());
 }
\ No newline at end of file
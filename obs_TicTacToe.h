@@ -17,28 +17,71 @@
  * Victory is achieved by placing four symbols consecutively in any direction
  * (horizontal, vertical, or diagonal). Obstacles block cell usage.
  *
+ * Obstacles are drawn from the board's own generator, so a game can be
+ * replayed with seed() and boards in different threads never share state.
+ *
  * @see Board
  */
-class obs_TicTacToe_board : public Board<char>{
+class obs_TicTacToe_board final : public Board<char>{
 private:
     char blank_symbol = '.'; ///< Symbol representing an empty cell
     char obstacle_symbol = '#'; ///< Symbol representing an obstacle
-    vector<pair<int,int>> coordinates; ///< List of available coordinates for obstacle placement
+    static const int CELLS = 36; ///< Cells of the 6x6 board
+    int free_cells[CELLS]; ///< Cells (row * 6 + column); the first free_count are the blank ones
+    int free_pos[CELLS]; ///< Position of each cell in free_cells (for a taken cell, the position it was taken from)
+    int free_count = CELLS; ///< Number of free cells
     int last_row_play; ///< Row index of the most recent move
     int last_col_play; ///< Column index of the most recent move
+    char winner = 0; ///< Symbol whose last move made four in a row, or 0
+    bool drawn = false; ///< True if the last move filled the board without a win
+    uint64_t obstacle_seed; ///< Seed rng started from, for game records
+    Rng rng; ///< Generator for obstacle placement; small enough to save with every move
+
+    /** @brief True if a cell is in the free set. */
+    bool is_free(int cell) const;
+
+    /**
+     * @brief Remove a free cell in O(1) by swapping it with the last free one.
+     *
+     * The cell is parked just past the free cells and remembers where it
+     * was, so restore_free() can undo removals in reverse order.
+     */
+    void take_free(int cell);
+
+    /** @brief Undo the most recent take_free() still in effect. */
+    void restore_free();
+
+    /** @brief Save the last move, its outcome, the generator and the number of free cells before make_move() applies a move. */
+    void save_state() override;
+
+    /** @brief Restore the last move, its outcome and the generator, and return the cells taken by the move to the free set. */
+    void restore_state() override;
 
 public:
     /**
      * @brief Default constructor that initializes a 6x6 board.
      *
-     * Sets up blank cells and populates the coordinates list with all positions.
+     * Sets up blank cells, puts every cell in the free set and seeds the
+     * obstacle generator from the calling thread's generator (thread_rng()).
      */
     obs_TicTacToe_board();
 
+    /**
+     * @brief Reseed the obstacle generator.
+     * @param value Seed; the same seed and moves give the same obstacles
+     */
+    void seed(uint64_t value) override;
+
+    /** @brief Seed the obstacle generator started from (the last value given to seed()). */
+    uint64_t get_seed() const override { return obstacle_seed; }
+
     /**
      * @brief Updates the board with a player's move and places obstacles.
      * @param move Pointer to a Move<char> object containing move details
      * @return true if the move is valid and successfully applied, false otherwise
+     *
+     * A move with symbol 0 is rejected rather than clearing its cell, since
+     * the obstacles it placed would stay; unmake_move() takes moves back.
      */
     bool update_board(Move<char>* move) override;
 
@@ -46,6 +89,9 @@ public:
      * @brief Checks if the player has achieved four in a row.
      * @param player Pointer to the player being checked
      * @return true if the player has four consecutive symbols, false otherwise
+     *
+     * update_board() counts the run through each new mark, so this only
+     * reads its result.
      */
     bool is_win(Player<char>* player) override;
 
@@ -70,11 +116,18 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+
+    /**
+     * @brief Lists every cell that is neither taken nor an obstacle.
+     * @param symbol Symbol of the player to move
+     * @param moves Buffer that receives the moves
+     */
+    void generate_moves(char symbol, MoveList<char>& moves) override;
     /**
      * @brief Places two random obstacles on available cells.
      *
-     * Selects random positions from the coordinates list and marks them
-     * with the obstacle symbol, then removes them from available positions.
+     * Draws cells from the free set with the board's generator, marks them
+     * with the obstacle symbol and removes them from the free set.
      */
     void random_obs();
 
@@ -89,6 +142,12 @@ public:
      */
     int dir_cnt(int x, int y, int dr, int dc, char sym);
 
+    /**
+     * @brief Checks for four in a row of sym through (x, y), in any direction.
+     * @return true if a run through the cell is at least four long
+     */
+    bool four_through(int x, int y, char sym);
+
     /**
      * @brief Checks if all cells on the board are filled.
      * @return true if no blank cells remain, false otherwise
@@ -131,7 +190,14 @@ public:
     /**
      * @brief Retrieves the next move from a player.
      * @param player Pointer to the player whose move is being requested
-     * @return Pointer to a Move<char> object representing the player's move
+     * @return A Move<char> representing the player's move
+     */
+    Move<char> next_move(Player<char>* player) override;
+
+    /**
+     * @brief Picks a random legal move for a computer player.
+     * @param player Pointer to the player whose move is being requested
+     * @return A move drawn from the board's generate_moves(), or (-1, -1) if there is none
      */
-    virtual Move<char>* get_move(Player<char>* player);
+    static Move<char> computer_move(Player<char>* player);
 };
\ No newline at end of file
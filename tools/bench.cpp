@@ -0,0 +1,323 @@
+/**
+ * @file bench.cpp
+ * @brief Microbenchmarks of every board in the game hub.
+ *
+ * For each of the 13 variants listed in main.cpp's menu() a corpus of random
+ * games is recorded from the master seed, and the board operations are timed
+ * on it:
+ * - update_board: replaying the corpus onto fresh boards (construction time
+ *   is measured separately and subtracted)
+ * - make_unmake: make_move() + unmake_move() of the next move of each position
+ * - is_win, is_draw, game_is_over: for the player who just moved
+ * - generate_moves: for the player to move
+ * - playout: complete random games from the opening position, as ns/game,
+ *   playouts/sec and heap allocations per game
+ * - selfplay: end-to-end games/sec of SelfPlayRunner on the requested threads
+ * - completing_cells (3x3 boards): the empty cells that complete a line for
+ *   the player to move, one board at a time and for the whole corpus as one
+ *   Batch3x3, in ns per position
+ *
+ * Output is one JSON object per line, e.g.
+ * {"board":"SUS","metric":"is_win","value":4.1,"unit":"ns/op"}
+ * so runs can be stored and compared before and after a change.
+ *
+ * Usage: bench [games] [threads] [seed]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include <ctime>
+#include <atomic>
+#include <new>
+
+#include "BoardGame_Classes.h"
+#include "SelfPlay.h"
+#include "Inf_TicTacToe.h"
+#include "Word_TicTacToe.h"
+#include "obs_TicTacToe.h"
+#include "Inverse_TicTacToe.h"
+#include "Inverse_XO_UI.h"
+#include "Batch3x3.h"
+#include "SUS.h"
+#include "TIC_TAC_TOE_4X4.h"
+#include "NUMERICAL_TIC_TAC_TOE.h"
+#include "TicTacToe_5x5.h"
+#include "Pyramid_Tic_Tac_Toe.h"
+#include "connect4.h"
+#include "Memory.h"
+#include "Diamond_TicTacToe.h"
+#include "Diamond_UI.h"
+#include "Ultimate_TicTacToe.h"
+#include "Ultimate_UI.h"
+using namespace std;
+
+// Every heap allocation of the process is counted, so allocations per game
+// can be reported. Every replaceable form of new and delete is replaced, so
+// each delete frees memory from the matching allocate().
+static atomic<long long> allocations{ 0 };
+
+/** @brief Count and allocate a block; alignment 0 for the default one. nullptr when out of memory. */
+void* allocate(size_t size, size_t alignment = 0) noexcept {
+    allocations.fetch_add(1, memory_order_relaxed);
+    size = size ? size : 1;
+    if (alignment == 0) return malloc(size);
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+/** @brief Free a block of allocate(); aligned if it was given an alignment. */
+void release(void* p, bool aligned = false) noexcept {
+#ifdef _WIN32
+    if (aligned) { _aligned_free(p); return; }
+#endif
+    (void)aligned;
+    free(p);
+}
+
+/** @brief allocate(), throwing bad_alloc when it fails. */
+void* allocate_or_throw(size_t size, size_t alignment = 0) {
+    if (void* p = allocate(size, alignment)) return p;
+    throw bad_alloc();
+}
+
+void* operator new(size_t size) { return allocate_or_throw(size); }
+void* operator new[](size_t size) { return allocate_or_throw(size); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return allocate(size); }
+void* operator new(size_t size, align_val_t a) { return allocate_or_throw(size, static_cast<size_t>(a)); }
+void* operator new[](size_t size, align_val_t a) { return allocate_or_throw(size, static_cast<size_t>(a)); }
+void* operator new(size_t size, align_val_t a, const nothrow_t&) noexcept { return allocate(size, static_cast<size_t>(a)); }
+void* operator new[](size_t size, align_val_t a, const nothrow_t&) noexcept { return allocate(size, static_cast<size_t>(a)); }
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, size_t) noexcept { release(p); }
+void operator delete[](void* p, size_t) noexcept { release(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { release(p); }
+void operator delete(void* p, align_val_t) noexcept { release(p, true); }
+void operator delete[](void* p, align_val_t) noexcept { release(p, true); }
+void operator delete(void* p, size_t, align_val_t) noexcept { release(p, true); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { release(p, true); }
+void operator delete(void* p, align_val_t, const nothrow_t&) noexcept { release(p, true); }
+void operator delete[](void* p, align_val_t, const nothrow_t&) noexcept { release(p, true); }
+
+/** @brief Results are folded into this so the timed work cannot be optimised away. */
+static volatile long long sink = 0;
+
+/** @brief Shortest time, in seconds, a measurement is repeated for. */
+static const double MIN_SECONDS = 0.05;
+
+using MovePolicy = Move<char>(*)(Player<char>*);
+
+/** @brief Print one measurement as a JSON line. */
+void emit(const string& board, const string& metric, double value, const string& unit) {
+    ostringstream out;
+    out << fixed << setprecision(value < 100 ? 2 : 0) << value;
+    cout << "{\"board\":\"" << board << "\",\"metric\":\"" << metric
+         << "\",\"value\":" << out.str() << ",\"unit\":\"" << unit << "\"}\n";
+}
+
+/**
+ * @brief Run a pass repeatedly for at least MIN_SECONDS.
+ * @param pass Work to time; returns the number of operations it performed
+ * @return Nanoseconds per operation
+ */
+template <typename F>
+double ns_per_op(F pass) {
+    long long ops = 0;
+    auto start = chrono::steady_clock::now();
+    double elapsed = 0;
+    do {
+        ops += pass();
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    } while (elapsed < MIN_SECONDS);
+    return ops > 0 ? elapsed * 1e9 / ops : 0;
+}
+
+/** @brief A recorded random game: its moves and the position after each of them. */
+template <typename B>
+struct CorpusGame {
+    uint64_t stream;       ///< Random stream the game was played from
+    vector<Move<char>> moves;
+    vector<B> positions;   ///< positions[i] is the board after moves[i]
+};
+
+/**
+ * @brief Play random games from the opening position.
+ * @param games Number of games
+ * @param record Corpus to append to, or nullptr to only play
+ * @return Number of moves played
+ */
+template <typename B>
+long long play_random(int games, MovePolicy policy, char first, char second,
+                      vector<CorpusGame<B>>* record) {
+    long long moves = 0;
+    for (int g = 0; g < games; ++g) {
+        set_thread_stream(g);
+        B board;
+        Player<char> players[2] = { Player<char>("", first, PlayerType::COMPUTER),
+                                    Player<char>("", second, PlayerType::COMPUTER) };
+        players[0].set_board_ptr(&board);
+        players[1].set_board_ptr(&board);
+        CorpusGame<B> game{ static_cast<uint64_t>(g), {}, {} };
+        for (int ply = 0; ply < 400; ++ply) {
+            Player<char>* mover = &players[ply % 2];
+            Move<char> move = policy(mover);
+            Move<char> applied = move;
+            if (!board.update_board(&applied)) break;
+            ++moves;
+            if (record) {
+                game.moves.push_back(move);
+                game.positions.push_back(board);
+            }
+            if (check_result<char>(&board, mover) != GameResult::ONGOING) break;
+        }
+        if (record) record->push_back(std::move(game));
+    }
+    return moves;
+}
+
+/**
+ * @brief Time the completing-cell test of every corpus position, board by board and batched.
+ */
+template <typename B>
+void bench_3x3(const string& name, vector<CorpusGame<B>>& corpus, long long positions, char first, char second) {
+    // Position i of a game was reached by movers[i % 2]; the other player is to move
+    char movers[2] = { first, second };
+    emit(name, "completing_cells", ns_per_op([&] {
+        for (auto& game : corpus)
+            for (size_t i = 0; i < game.positions.size(); ++i) {
+                const B& board = game.positions[i];
+                sink = sink + completing_cells_3x3(cells_3x3<char>(board, movers[(i + 1) % 2]),
+                                                   cells_3x3<char>(board, movers[i % 2]));
+            }
+        return positions;
+    }), "ns/op");
+
+    Batch3x3 batch;
+    for (auto& game : corpus)
+        for (size_t i = 0; i < game.positions.size(); ++i)
+            batch.add<char>(game.positions[i], movers[(i + 1) % 2], movers[i % 2]);
+    vector<uint16_t> cells(batch.size());
+    emit(name, string("completing_cells_batch_") + batch3x3_kernel(), ns_per_op([&] {
+        batch.completing_cells(cells.data());
+        sink = sink + cells[0];
+        return static_cast<long long>(batch.size());
+    }), "ns/op");
+}
+
+template <typename B>
+void bench(const string& name, MovePolicy policy, char first, char second, int games, int threads) {
+    vector<CorpusGame<B>> corpus;
+    play_random<B>(games, policy, first, second, &corpus);
+    long long positions = 0;
+    for (auto& game : corpus) positions += game.moves.size();
+
+    // update_board: replay the corpus on fresh boards, minus the cost of the boards alone
+    double with_moves = ns_per_op([&] {
+        for (auto& game : corpus) {
+            set_thread_stream(game.stream);
+            B board;
+            for (const Move<char>& m : game.moves) {
+                Move<char> move = m;
+                sink = sink + board.update_board(&move);
+            }
+        }
+        return positions;
+    });
+    double boards_only = ns_per_op([&] {
+        for (auto& game : corpus) {
+            set_thread_stream(game.stream);
+            B board;
+            sink = sink + board.get_n_moves();
+        }
+        return positions;
+    });
+    emit(name, "update_board", max(with_moves - boards_only, 0.0), "ns/op");
+
+    // make_move + unmake_move of the next recorded move of each position
+    emit(name, "make_unmake", ns_per_op([&] {
+        long long ops = 0;
+        for (auto& game : corpus)
+            for (size_t i = 0; i + 1 < game.moves.size(); ++i) {
+                B& board = game.positions[i];
+                if (board.make_move(game.moves[i + 1])) board.unmake_move();
+                ++ops;
+            }
+        return ops;
+    }), "ns/op");
+
+    // Result checks for the player who made the last move
+    Player<char> movers[2] = { Player<char>("", first, PlayerType::COMPUTER),
+                               Player<char>("", second, PlayerType::COMPUTER) };
+    auto time_check = [&](const string& metric, bool (B::*check)(Player<char>*)) {
+        emit(name, metric, ns_per_op([&] {
+            for (auto& game : corpus)
+                for (size_t i = 0; i < game.positions.size(); ++i)
+                    sink = sink + (game.positions[i].*check)(&movers[i % 2]);
+            return positions;
+        }), "ns/op");
+    };
+    time_check("is_win", &B::is_win);
+    time_check("is_draw", &B::is_draw);
+    time_check("game_is_over", &B::game_is_over);
+
+    emit(name, "generate_moves", ns_per_op([&] {
+        MoveList<char> moves;
+        for (auto& game : corpus)
+            for (size_t i = 0; i < game.positions.size(); ++i) {
+                game.positions[i].generate_moves(movers[(i + 1) % 2].get_symbol(), moves);
+                sink = sink + moves.size();
+            }
+        return positions;
+    }), "ns/op");
+
+    // Full random games, with every allocation they make
+    long long allocated = allocations.load();
+    long long played = 0;
+    double per_game = ns_per_op([&] {
+        play_random<B>(games, policy, first, second, nullptr);
+        played += games;
+        return static_cast<long long>(games);
+    });
+    allocated = allocations.load() - allocated;
+    emit(name, "playout", per_game, "ns/game");
+    emit(name, "playouts_per_second", per_game > 0 ? 1e9 / per_game : 0, "games/s");
+    emit(name, "allocations_per_game", played > 0 ? double(allocated) / played : 0, "allocs/game");
+
+    SelfPlayRunner<char, B> runner([] { return new B(); }, policy, policy, first, second);
+    SelfPlayStats stats = runner.run(max(games / max(threads, 1), 1), threads);
+    emit(name, "selfplay", stats.games_per_second(), "games/s");
+
+    if constexpr (is_same_v<B, InverseTicTacToe<char>> || is_same_v<B, Inf_XO_Board> || is_same_v<B, Memory_Board>)
+        bench_3x3(name, corpus, positions, first, second);
+}
+
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? atoi(argv[1]) : 200;
+    int threads = argc > 2 ? atoi(argv[2]) : thread::hardware_concurrency();
+    uint64_t seed = argc > 3 ? strtoull(argv[3], nullptr, 10) : static_cast<uint64_t>(time(0));
+    seed_random(seed);
+    cout << "{\"seed\":" << seed << ",\"games\":" << games << ",\"threads\":" << threads << "}\n";
+
+    bench<SUS_Board>("SUS", SUS_UI::computer_move, 'S', 'U', games, threads);
+    bench<CONNECT_Board>("Connect 4", CONNECT_UI::computer_move, 'X', 'O', games, threads);
+    bench<TicTacToe_5x5_board>("5x5 Tic-Tac-Toe", TicTacToe_5x5_UI::computer_move, 'X', 'O', games, threads);
+    bench<word_XO_Board>("Word Tic-Tac-Toe", word_XO_UI::computer_move, '-', '-', games, threads);
+    bench<InverseTicTacToe<char>>("Inverse Tic-Tac-Toe", Inverse_XO_UI::computer_move, 'X', 'O', games, threads);
+    bench<DiamondTicTacToe<char>>("Diamond Tic-Tac-Toe", Diamond_UI::computer_move, 'X', 'O', games, threads);
+    bench<XO_4x4_Board>("Tic_Tac_Toe_4X4", XO_4x4_UI::computer_move, 'X', 'O', games, threads);
+    bench<Pyramid_XO_Board>("Pyramid Tic_Tac_Toe", Pyramid_XO_UI::computer_move, 'X', 'O', games, threads);
+    bench<Numerical_XO_Board>("NUMERICAL Tic_Tac_Toe", Numerical_XO_UI::computer_move, 'O', 'X', games, threads);
+    bench<obs_TicTacToe_board>("Obstacles Tic-Tac-Toe", obs_TicTacToe_UI::computer_move, 'X', 'O', games, threads);
+    bench<Inf_XO_Board>("Infinity Tic-Tac-Toe", Inf_XO_UI::computer_move, 'X', 'O', games, threads);
+    bench<UltimateTicTacToe<char>>("Ultimate Tic-Tac-Toe", Ultimate_UI::computer_move, 'X', 'O', games, threads);
+    bench<Memory_Board>("Memory Tic-Tac-Toe", Memory_UI::computer_move, 'X', 'O', games, threads);
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file book.cpp
+ * @brief Builds the Connect 4 opening book offline.
+ *
+ * Every position reachable in up to N plies is listed once per mirror pair
+ * (CONNECT_Board::book_key()), skipping finished games. Each one is then
+ * searched by AI_Player to a fixed depth on a pool of threads, and its best
+ * move and score are written as a sorted OpeningBook file. Scores of forced
+ * wins and losses found within the depth are exact; the rest are the
+ * search's evaluation at that depth.
+ *
+ * Usage: book [plies] [depth] [threads] [output]
+ *   The defaults are 4 plies, depth 14, every hardware thread and
+ *   connect4.book, which CONNECT_UI loads when it sits in the working directory.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_set>
+
+#include "BoardGame_Classes.h"
+#include "AI_Player.h"
+#include "OpeningBook.h"
+#include "connect4.h"
+using namespace std;
+
+/** @brief A position to search: the columns played to reach it. */
+typedef vector<int> Line;
+
+/** @brief The board after playing a line from the opening position. */
+void play_line(CONNECT_Board& board, const Line& line) {
+    for (size_t i = 0; i < line.size(); ++i) {
+        Move<char> m(board.drop_row(line[i]), line[i], i % 2 == 0 ? 'X' : 'O');
+        board.update_board(&m);
+    }
+}
+
+/**
+ * @brief Every unfinished position of up to plies moves, one per mirror pair.
+ */
+vector<Line> list_positions(int plies) {
+    vector<Line> all, frontier(1);
+    unordered_set<uint64_t> seen;
+    for (int ply = 0; ; ++ply) {
+        all.insert(all.end(), frontier.begin(), frontier.end());
+        if (ply == plies) break;
+        vector<Line> next;
+        for (const Line& line : frontier) {
+            CONNECT_Board board;
+            play_line(board, line);
+            Player<char> mover("", ply % 2 == 0 ? 'X' : 'O', PlayerType::AI);
+            MoveList<char> moves;
+            board.generate_moves(mover.get_symbol(), moves);
+            for (const Move<char>& m : moves) {
+                if (!board.make_move(m)) continue;
+                bool mirrored;
+                if (check_result(&board, &mover) == GameResult::ONGOING && seen.insert(board.book_key(mirrored)).second) {
+                    next.push_back(line);
+                    next.back().push_back(m.get_y());
+                }
+                board.unmake_move();
+            }
+        }
+        frontier.swap(next);
+    }
+    return all;
+}
+
+/** @brief AI_Player score as a book score: exact plies for wins, clamped evaluations otherwise. */
+int16_t book_score(int score) {
+    const int WIN_SCORE = AI_Player<char, CONNECT_Board>::WIN_SCORE;
+    if (score > WIN_SCORE / 2) return static_cast<int16_t>(OpeningBook::WIN - (WIN_SCORE - score) + 1);
+    if (score < -WIN_SCORE / 2) return static_cast<int16_t>(-(OpeningBook::WIN - (WIN_SCORE + score) + 1));
+    return static_cast<int16_t>(max(-OpeningBook::WIN / 2, min(OpeningBook::WIN / 2, score)));
+}
+
+/** @brief Search one position and return its book entry. */
+BookEntry search(const Line& line, int depth) {
+    CONNECT_Board board;
+    play_line(board, line);
+    char symbol = line.size() % 2 == 0 ? 'X' : 'O';
+    AI_Player<char, CONNECT_Board> ai("", symbol, symbol == 'X' ? 'O' : 'X', depth, 1 << 20);
+    ai.set_canonical_keys(true);
+    ai.set_board_ptr(&board);
+    Move<char> best = ai.choose_move();
+
+    BookEntry entry;
+    bool mirrored;
+    entry.key = board.book_key(mirrored);
+    int column = mirrored ? 6 - best.get_y() : best.get_y();
+    entry.cell = static_cast<uint8_t>(best.get_x() * 7 + column);
+    entry.depth = static_cast<uint8_t>(depth);
+    entry.score = book_score(ai.get_stats().score);
+    return entry;
+}
+
+int main(int argc, char* argv[]) {
+    int plies = argc > 1 ? atoi(argv[1]) : 4;
+    int depth = argc > 2 ? atoi(argv[2]) : 14;
+    int threads = argc > 3 ? atoi(argv[3]) : 0;
+    string output = argc > 4 ? argv[4] : "connect4.book";
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    if (plies < 0 || plies > 41 || depth < 1 || depth > 42) {
+        cout << "Usage: book [plies] [depth] [threads] [output]\n";
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<Line> lines = list_positions(plies);
+    vector<BookEntry> entries(lines.size());
+    atomic<size_t> next(0);
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < lines.size(); i = next++)
+                entries[i] = search(lines[i], depth);
+        });
+    for (thread& worker : workers) worker.join();
+    OpeningBook::write(output, entries);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    OpeningBook book(output);
+    BookEntry opening;
+    bool mirrored;
+    book.find(CONNECT_Board().book_key(mirrored), opening);
+    cout << output << ": " << book.size() << " positions of up to " << plies << " plies, depth " << depth
+         << ", " << fixed << setprecision(1) << seconds << " s on " << threads << " threads\n"
+         << "opening: column " << opening.cell % 7 << ", score " << opening.score << "\n";
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file mcts.cpp
+ * @brief Throughput and strength check of the Ultimate Tic-Tac-Toe MCTS player.
+ *
+ * Searches the opening position with 1, 2, 4, ... threads up to the requested
+ * count and prints playouts/sec and nodes/sec for each, then plays a few
+ * games of MCTS against the random computer player.
+ *
+ * Usage: mcts [playouts_per_move] [max_threads] [games] [seed]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+
+#include "BoardGame_Classes.h"
+#include "Ultimate_TicTacToe.h"
+#include "Ultimate_UI.h"
+#include "MCTS_Player.h"
+using namespace std;
+
+using Ultimate_MCTS = MCTS_Player<char, UltimateTicTacToe<char>>;
+
+/** @brief Play one game, MCTS as X against random O; returns the result for X. */
+GameResult play_game(long long playouts, int threads) {
+    UltimateTicTacToe<char> board;
+    Ultimate_MCTS ai("MCTS", 'X', 'O', playouts, 0, threads);
+    Player<char> random_player("Random", 'O', PlayerType::COMPUTER);
+    ai.set_board_ptr(&board);
+    random_player.set_board_ptr(&board);
+
+    for (int ply = 0; ply < 81; ++ply) {
+        Player<char>* mover = ply % 2 == 0 ? static_cast<Player<char>*>(&ai) : &random_player;
+        Move<char> move = ply % 2 == 0 ? ai.choose_move() : Ultimate_UI::computer_move(mover);
+        if (!board.update_board(&move))
+            return GameResult::DRAW;
+        GameResult result = check_result<char>(&board, mover);
+        if (result != GameResult::ONGOING) {
+            if (mover == &ai) return result;
+            if (result == GameResult::WIN) return GameResult::LOSE;
+            if (result == GameResult::LOSE) return GameResult::WIN;
+            return result;
+        }
+    }
+    return GameResult::DRAW;
+}
+
+int main(int argc, char* argv[]) {
+    long long playouts = argc > 1 ? atoll(argv[1]) : 20000;
+    int max_threads = argc > 2 ? atoi(argv[2]) : thread::hardware_concurrency();
+    int games = argc > 3 ? atoi(argv[3]) : 10;
+    uint64_t seed = argc > 4 ? strtoull(argv[4], nullptr, 10) : static_cast<uint64_t>(time(0));
+    seed_random(seed);
+    cout << "seed " << seed << "\n";
+
+    cout << right << setw(8) << "threads" << setw(12) << "playouts"
+         << setw(14) << "playouts/sec" << setw(14) << "nodes/sec" << setw(10) << "seconds" << "\n";
+    for (int threads = 1; threads <= max(max_threads, 1); threads *= 2) {
+        UltimateTicTacToe<char> board;
+        Ultimate_MCTS ai("MCTS", 'X', 'O', playouts, 0, threads);
+        ai.set_board_ptr(&board);
+        ai.choose_move();
+        const MCTSStats& s = ai.get_stats();
+        cout << setw(8) << threads << setw(12) << s.playouts
+             << setw(14) << fixed << setprecision(0) << s.playouts_per_second()
+             << setw(14) << s.nodes_per_second()
+             << setw(10) << setprecision(3) << s.seconds << "\n";
+    }
+
+    int wins = 0, draws = 0, losses = 0;
+    for (int g = 0; g < games; ++g) {
+        GameResult result = play_game(playouts, max(max_threads, 1));
+        if (result == GameResult::WIN) ++wins;
+        else if (result == GameResult::LOSE) ++losses;
+        else ++draws;
+    }
+    cout << "\nMCTS (X) vs random (O): " << wins << " won, " << draws << " drawn, "
+         << losses << " lost of " << games << "\n";
+    return 0;
+}
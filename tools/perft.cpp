@@ -0,0 +1,336 @@
+/**
+ * @file perft.cpp
+ * @brief Counts the positions and game outcomes reachable within N moves.
+ *
+ * A perft ("performance test") walks every move sequence of up to N moves
+ * with generate_moves() and make_move()/unmake_move(), counting the
+ * positions reached at each ply and the games that end on the way. The
+ * counts are an oracle for move generators and undo: they must not change
+ * with the thread count, and after every subtree the board has to be back
+ * at its starting key. They also make a stress benchmark.
+ *
+ * Subtrees are spread over worker threads that steal work from each other:
+ * each thread pops the deepest task of its own queue and, when it runs dry,
+ * steals the oldest (largest) task of another. A thread that expands a
+ * node while some thread is idle hands the node's children out as tasks
+ * instead of searching them itself.
+ *
+ * With --dedup every position is expanded once per ply (keyed by
+ * position_key()), so the counts become distinct positions. Obstacles
+ * positions that differ only in their generator state are merged too.
+ *
+ * The Obstacles board is reseeded with the given seed before every run, so
+ * its obstacles are the same on every path and every thread count.
+ *
+ * Usage: perft [variant|all] [depth] [max_threads] [seed] [--dedup]
+ *   variant is the game's number in the hub menu; without one Ultimate,
+ *   Connect 4 and Obstacles are run. A depth of 0 uses each variant's default.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <unordered_set>
+
+#include "BoardGame_Classes.h"
+#include "Inf_TicTacToe.h"
+#include "Word_TicTacToe.h"
+#include "obs_TicTacToe.h"
+#include "Inverse_TicTacToe.h"
+#include "SUS.h"
+#include "NUMERICAL_TIC_TAC_TOE.h"
+#include "TicTacToe_5x5.h"
+#include "Pyramid_Tic_Tac_Toe.h"
+#include "connect4.h"
+#include "Memory.h"
+#include "Diamond_TicTacToe.h"
+#include "Ultimate_TicTacToe.h"
+#include "TIC_TAC_TOE_4X4.h"
+using namespace std;
+
+const int MAX_DEPTH = 64;  ///< Deepest perft supported
+const int SPLIT_DEPTH = 3; ///< Nodes with fewer plies left below them are never split
+
+/** @brief What a perft found; equal for every thread count. */
+struct PerftCounts {
+    long long per_ply[MAX_DEPTH + 1] = {}; ///< Positions reached after each number of moves
+    long long first_wins = 0;   ///< Games over with the first player winning
+    long long second_wins = 0;  ///< Games over with the second player winning
+    long long draws = 0;        ///< Games over in a draw
+    long long rejected = 0;     ///< Generated moves make_move() refused
+    long long undo_errors = 0;  ///< Subtrees after which the board key differed from the start
+
+    /** @brief Positions reached at every ply. */
+    long long nodes() const {
+        long long n = 0;
+        for (int d = 1; d <= MAX_DEPTH; ++d) n += per_ply[d];
+        return n;
+    }
+
+    /** @brief Add another thread's counts. */
+    void merge(const PerftCounts& other) {
+        for (int d = 0; d <= MAX_DEPTH; ++d) per_ply[d] += other.per_ply[d];
+        first_wins += other.first_wins;
+        second_wins += other.second_wins;
+        draws += other.draws;
+        rejected += other.rejected;
+        undo_errors += other.undo_errors;
+    }
+
+    bool operator==(const PerftCounts& other) const {
+        return memcmp(per_ply, other.per_ply, sizeof per_ply) == 0 && first_wins == other.first_wins
+            && second_wins == other.second_wins && draws == other.draws
+            && rejected == other.rejected && undo_errors == other.undo_errors;
+    }
+};
+
+/** @brief Position keys already expanded, sharded so threads rarely wait on each other. */
+class SeenPositions {
+public:
+    /** @brief Record a position at a ply; false if it was seen before. */
+    bool insert(uint64_t key, int ply) {
+        key = Rng::mix(key ^ (uint64_t(ply) << 56));
+        Shard& shard = shards[key % SHARDS];
+        lock_guard<mutex> guard(shard.lock);
+        return shard.keys.insert(key).second;
+    }
+
+private:
+    static const int SHARDS = 64;
+    struct Shard {
+        mutex lock;
+        unordered_set<uint64_t> keys;
+    };
+    Shard shards[SHARDS];
+};
+
+/**
+ * @brief A perft of one board type over a work-stealing set of threads.
+ * @tparam B Concrete board; its moves alternate between the two symbols.
+ */
+template <typename B>
+class Perft {
+public:
+    Perft(char first, char second, int depth, uint64_t seed, bool dedup)
+        : symbols{ first, second }, depth(depth), seed(seed), dedup(dedup) {}
+
+    /**
+     * @brief Count everything within depth moves of the opening position.
+     * @param threads Worker threads
+     * @param seconds Receives the wall-clock time of the search
+     */
+    PerftCounts run(int threads, double& seconds) {
+        queues.clear();
+        for (int t = 0; t < threads; ++t)
+            queues.push_back(make_unique<Queue>());
+        seen = dedup ? make_unique<SeenPositions>() : nullptr;
+        idle = 0;
+
+        // The opening moves are the first tasks; stealing spreads them out
+        B root;
+        root.seed(seed);
+        MoveList<char> moves;
+        root.generate_moves(symbols[0], moves);
+        pending = moves.size();
+        for (const Move<char>& m : moves)
+            queues[0]->tasks.push_back({ {}, m });
+
+        vector<PerftCounts> partial(threads);
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back([this, t, &partial] { work(t, partial[t]); });
+        for (auto& w : workers)
+            w.join();
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        PerftCounts total;
+        for (auto& p : partial)
+            total.merge(p);
+        return total;
+    }
+
+private:
+    /** @brief Play move from the position reached by path, and search below it. */
+    struct Task {
+        vector<Move<char>> path;
+        Move<char> move;
+    };
+
+    /** @brief One thread's tasks; the owner works at the back, thieves take the front. */
+    struct Queue {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    char symbols[2];
+    int depth;
+    uint64_t seed;
+    bool dedup;
+    vector<unique_ptr<Queue>> queues;
+    unique_ptr<SeenPositions> seen;
+    atomic<long long> pending{ 0 }; ///< Tasks queued or running
+    atomic<int> idle{ 0 };          ///< Threads looking for work
+
+    /** @brief Take a task: the newest of thread t's own, else the oldest of another's. */
+    bool take(int t, Task& task) {
+        int n = static_cast<int>(queues.size());
+        for (int k = 0; k < n; ++k) {
+            Queue& q = *queues[(t + k) % n];
+            lock_guard<mutex> guard(q.lock);
+            if (q.tasks.empty()) continue;
+            if (k == 0) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            } else {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /** @brief Worker loop: run tasks until none is queued or running. */
+    void work(int t, PerftCounts& counts) {
+        B board;
+        board.seed(seed);
+        const uint64_t start_key = board.position_key();
+        Player<char> first("", symbols[0], PlayerType::COMPUTER), second("", symbols[1], PlayerType::COMPUTER);
+        Player<char>* players[2] = { &first, &second };
+        first.set_board_ptr(&board);
+        second.set_board_ptr(&board);
+
+        bool waiting = false;
+        Task task;
+        while (true) {
+            if (take(t, task)) {
+                if (waiting) --idle;
+                waiting = false;
+                for (const Move<char>& m : task.path)
+                    board.make_move(m);
+                visit(board, players, task.path, task.move, t, counts);
+                for (size_t i = 0; i < task.path.size(); ++i)
+                    board.unmake_move();
+                if (board.position_key() != start_key) ++counts.undo_errors;
+                --pending;
+                continue;
+            }
+            if (pending.load() == 0) break;
+            if (!waiting) ++idle;
+            waiting = true;
+            this_thread::yield();
+        }
+        if (waiting) --idle;
+    }
+
+    /** @brief Play move from the position reached by path, count it and search below it. */
+    void visit(B& board, Player<char>* players[2], vector<Move<char>>& path, const Move<char>& move,
+               int t, PerftCounts& counts) {
+        int ply = static_cast<int>(path.size());
+        int side = ply % 2;
+        if (!board.make_move(move)) {
+            ++counts.rejected;
+            return;
+        }
+        if (!seen || seen->insert(board.position_key(), ply + 1)) {
+            ++counts.per_ply[ply + 1];
+            GameResult result = check_result(&board, players[side]);
+            if (result == GameResult::DRAW) ++counts.draws;
+            else if (result != GameResult::ONGOING)
+                ++((result == GameResult::WIN) == (side == 0) ? counts.first_wins : counts.second_wins);
+            else if (ply + 1 < depth) {
+                path.push_back(move);
+                expand(board, players, path, t, counts);
+                path.pop_back();
+            }
+        }
+        board.unmake_move();
+    }
+
+    /** @brief Search every move of the position reached by path, or hand them out if a thread is idle. */
+    void expand(B& board, Player<char>* players[2], vector<Move<char>>& path, int t, PerftCounts& counts) {
+        int ply = static_cast<int>(path.size());
+        MoveList<char> moves;
+        board.generate_moves(symbols[ply % 2], moves);
+        if (depth - ply >= SPLIT_DEPTH && idle.load(memory_order_relaxed) > 0) {
+            pending += moves.size();
+            lock_guard<mutex> guard(queues[t]->lock);
+            for (const Move<char>& m : moves)
+                queues[t]->tasks.push_back({ path, m });
+            return;
+        }
+        for (const Move<char>& m : moves)
+            visit(board, players, path, m, t, counts);
+    }
+};
+
+/** @brief Run a variant's perft on 1, 2, 4, ... threads and print the counts and rates. */
+template <typename B>
+void run_variant(const string& name, char first, char second, int depth, int max_threads,
+                 uint64_t seed, bool dedup) {
+    cout << "\n" << name << ", depth " << depth << (dedup ? ", distinct positions" : "") << "\n";
+    Perft<B> perft(first, second, depth, seed, dedup);
+    PerftCounts reference;
+    cout << right << setw(8) << "threads" << setw(14) << "nodes" << setw(14) << "nodes/sec"
+         << setw(10) << "seconds" << "\n";
+    for (int threads = 1; threads <= max(max_threads, 1); threads *= 2) {
+        double seconds = 0;
+        PerftCounts counts = perft.run(threads, seconds);
+        if (threads == 1) reference = counts;
+        cout << setw(8) << threads << setw(14) << counts.nodes()
+             << setw(14) << fixed << setprecision(0) << (seconds > 0 ? counts.nodes() / seconds : 0)
+             << setw(10) << setprecision(3) << seconds
+             << (counts == reference || dedup ? "" : "   counts differ from 1 thread!") << "\n";
+    }
+    for (int d = 1; d <= depth; ++d)
+        cout << "  ply " << setw(2) << d << setw(14) << reference.per_ply[d] << "\n";
+    cout << "  games over: first wins " << reference.first_wins << ", second wins "
+         << reference.second_wins << ", draws " << reference.draws << "\n";
+    if (reference.rejected || reference.undo_errors)
+        cout << "  ERROR: " << reference.rejected << " generated moves rejected, "
+             << reference.undo_errors << " subtrees not undone\n";
+}
+
+int main(int argc, char* argv[]) {
+    bool dedup = false;
+    vector<string> args;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--dedup") dedup = true;
+        else args.push_back(argv[i]);
+    }
+    string which = args.size() > 0 ? args[0] : "";
+    int depth = args.size() > 1 ? atoi(args[1].c_str()) : 0;
+    int max_threads = args.size() > 2 ? atoi(args[2].c_str()) : thread::hardware_concurrency();
+    uint64_t seed = args.size() > 3 ? strtoull(args[3].c_str(), nullptr, 10) : static_cast<uint64_t>(time(0));
+    seed_random(seed);
+    cout << "seed " << seed << "\n";
+
+    auto wanted = [&](int variant) {
+        if (which == "all") return true;
+        if (which.empty()) return variant == 12 || variant == 2 || variant == 10;
+        return atoi(which.c_str()) == variant;
+    };
+    auto at = [&](int fallback) { return depth > 0 ? min(depth, MAX_DEPTH) : fallback; };
+
+    if (wanted(1)) run_variant<SUS_Board>("SUS", 'S', 'U', at(9), max_threads, seed, dedup);
+    if (wanted(2)) run_variant<CONNECT_Board>("Connect 4", 'X', 'O', at(8), max_threads, seed, dedup);
+    if (wanted(3)) run_variant<TicTacToe_5x5_board>("5x5 Tic-Tac-Toe", 'X', 'O', at(4), max_threads, seed, dedup);
+    if (wanted(4)) run_variant<word_XO_Board>("Word Tic-Tac-Toe", '-', '-', at(2), max_threads, seed, dedup);
+    if (wanted(5)) run_variant<InverseTicTacToe<char>>("Inverse Tic-Tac-Toe", 'X', 'O', at(9), max_threads, seed, dedup);
+    if (wanted(6)) run_variant<DiamondTicTacToe<char>>("Diamond Tic-Tac-Toe", 'X', 'O', at(4), max_threads, seed, dedup);
+    if (wanted(7)) run_variant<XO_4x4_Board>("Tic_Tac_Toe_4X4", 'X', 'O', at(6), max_threads, seed, dedup);
+    if (wanted(8)) run_variant<Pyramid_XO_Board>("Pyramid Tic_Tac_Toe", 'X', 'O', at(9), max_threads, seed, dedup);
+    if (wanted(9)) run_variant<Numerical_XO_Board>("NUMERICAL Tic_Tac_Toe", 'O', 'X', at(4), max_threads, seed, dedup);
+    if (wanted(10)) run_variant<obs_TicTacToe_board>("Obstacles Tic-Tac-Toe", 'X', 'O', at(4), max_threads, seed, dedup);
+    if (wanted(11)) run_variant<Inf_XO_Board>("Infinity Tic-Tac-Toe", 'X', 'O', at(7), max_threads, seed, dedup);
+    if (wanted(12)) run_variant<UltimateTicTacToe<char>>("Ultimate Tic-Tac-Toe", 'X', 'O', at(3), max_threads, seed, dedup);
+    if (wanted(13)) run_variant<Memory_Board>("Memory Tic-Tac-Toe", 'X', 'O', at(9), max_threads, seed, dedup);
+    return 0;
+}
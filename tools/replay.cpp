@@ -0,0 +1,103 @@
+/**
+ * @file replay.cpp
+ * @brief Reads a game record file back and checks every game against its board.
+ *
+ * The file is memory-mapped; a first pass only walks the records to count
+ * games and moves, a second replays each game into a fresh board of its
+ * variant and compares the board's verdict with the recorded result.
+ *
+ * Usage: replay <record file>
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include "BoardGame_Classes.h"
+#include "Inf_TicTacToe.h"
+#include "Word_TicTacToe.h"
+#include "obs_TicTacToe.h"
+#include "Inverse_TicTacToe.h"
+#include "SUS.h"
+#include "NUMERICAL_TIC_TAC_TOE.h"
+#include "TicTacToe_5x5.h"
+#include "Pyramid_Tic_Tac_Toe.h"
+#include "connect4.h"
+#include "Memory.h"
+#include "Diamond_TicTacToe.h"
+#include "Ultimate_TicTacToe.h"
+#include "TIC_TAC_TOE_4X4.h"
+using namespace std;
+
+/** @brief A new board of a variant, by its menu number, or nullptr. */
+Board<char>* new_board(int variant) {
+    switch (variant) {
+        case 1: return new SUS_Board();
+        case 2: return new CONNECT_Board();
+        case 3: return new TicTacToe_5x5_board();
+        case 4: return new word_XO_Board();
+        case 5: return new InverseTicTacToe<char>();
+        case 6: return new DiamondTicTacToe<char>();
+        case 7: return new XO_4x4_Board();
+        case 8: return new Pyramid_XO_Board();
+        case 9: return new Numerical_XO_Board();
+        case 10: return new obs_TicTacToe_board();
+        case 11: return new Inf_XO_Board();
+        case 12: return new UltimateTicTacToe<char>();
+        case 13: return new Memory_Board();
+        default: return nullptr;
+    }
+}
+
+/** @brief Replay a game and judge its last move the way the game loop did. */
+bool replays_to_result(const RecordedGame& game) {
+    unique_ptr<Board<char>> board(new_board(game.variant));
+    if (!board || !replay(game, board.get())) return false;
+    GameResult result = GameResult::ONGOING;
+    if (game.plies > 0) {
+        int mover = (game.plies - 1) % 2;
+        Player<char> last("", game.symbols[mover], PlayerType::COMPUTER);
+        last.set_board_ptr(board.get());
+        result = check_result(board.get(), &last);
+        // Turn the mover's point of view into the first player's
+        if (mover == 1 && result == GameResult::WIN) result = GameResult::LOSE;
+        else if (mover == 1 && result == GameResult::LOSE) result = GameResult::WIN;
+    }
+    return static_cast<uint8_t>(result) == game.result;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Usage: replay <record file>\n";
+        return 1;
+    }
+    GameRecordFile file(argv[1]);
+
+    auto start = chrono::steady_clock::now();
+    long long games = 0, moves = 0, per_variant[256] = {};
+    for (const RecordedGame& game : file) {
+        ++games;
+        moves += game.plies;
+        ++per_variant[game.variant];
+    }
+    double scan = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    long long mismatched = 0;
+    for (const RecordedGame& game : file)
+        if (!replays_to_result(game)) ++mismatched;
+    double replayed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << file.size() << " bytes, " << games << " games, " << moves << " moves\n";
+    for (int v = 0; v < 256; ++v)
+        if (per_variant[v]) {
+            const RecordVariant* format = record_variant(v);
+            cout << "  " << left << setw(26) << (format ? format->name : "unknown variant")
+                 << right << setw(10) << per_variant[v] << "\n";
+        }
+    cout << fixed << setprecision(0)
+         << "scan   " << (scan > 0 ? moves / scan : 0) << " moves/s\n"
+         << "replay " << (replayed > 0 ? moves / replayed : 0) << " moves/s, "
+         << mismatched << " games not matching their record\n";
+    return mismatched ? 1 : 0;
+}
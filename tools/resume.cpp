@@ -0,0 +1,153 @@
+/**
+ * @file resume.cpp
+ * @brief Checks that a tournament resumes from the records of a killed run.
+ *
+ * A Connect 4 tournament (random, alpha-beta at depths 1 and 2) records
+ * into a scratch directory. On POSIX systems a first run is started in a
+ * child process and killed with SIGKILL once it has recorded a few games.
+ * The files a killed run can leave are then made on purpose: one
+ * pairing's file is emptied, as if the process died before writing
+ * anything, and another gets half a game appended, as if it died while
+ * writing a game. The tournament is
+ * run again on the same directory, and the check fails if:
+ *   - the resumed run throws;
+ *   - a pairing's tally differs from the games in its record files;
+ *   - a pairing that was not decided has other than the game limit;
+ *   - a recorded game does not replay to its result.
+ *
+ * Usage: resume [scratch directory]
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "BoardGame_Classes.h"
+#include "Tournament.h"
+#include "AI_Player.h"
+#include "connect4.h"
+using namespace std;
+
+const int VARIANT = 2;
+const int MAX_GAMES = 60;
+
+/** @brief The tournament of the check, recording into dir. */
+void setup(Tournament<char, CONNECT_Board>& t, const string& dir) {
+    t.add_entrant("ab2", [](char s, char o) { return new AI_Player<char, CONNECT_Board>("ab2", s, o, 2); });
+    t.add_entrant("ab1", [](char s, char o) { return new AI_Player<char, CONNECT_Board>("ab1", s, o, 1); });
+    t.add_entrant("random", [](char s, char) { return new Player<char>("random", s, PlayerType::COMPUTER); });
+    t.set_sprt(Sprt(-30, 30, 1e-12, 1e-12)); // wide bounds, so the kill lands mid-pairing
+    t.set_max_games(MAX_GAMES);
+    t.set_record(dir, VARIANT);
+}
+
+/** @brief Record file of the games where first moves first against second. */
+string path_of(const string& dir, const string& first, const string& second) {
+    return (filesystem::path(dir) / ("v" + to_string(VARIANT) + "-" + first + "-" + second + ".rec")).string();
+}
+
+/** @brief Bytes written to the record files of dir so far. */
+uintmax_t recorded_bytes(const string& dir) {
+    error_code error;
+    uintmax_t bytes = 0;
+    for (const auto& entry : filesystem::directory_iterator(dir, error))
+        bytes += entry.file_size(error);
+    return bytes;
+}
+
+/** @brief Whether a recorded game replays to its recorded result. */
+bool replays_to_result(const RecordedGame& game) {
+    CONNECT_Board board;
+    if (!replay(game, &board)) return false;
+    GameResult result = GameResult::ONGOING;
+    if (game.plies > 0) {
+        int mover = (game.plies - 1) % 2;
+        Player<char> last("", game.symbols[mover], PlayerType::COMPUTER);
+        last.set_board_ptr(&board);
+        result = check_result(&board, &last);
+        if (mover == 1 && result == GameResult::WIN) result = GameResult::LOSE;
+        else if (mover == 1 && result == GameResult::LOSE) result = GameResult::WIN;
+    }
+    return static_cast<uint8_t>(result) == game.result;
+}
+
+/** @brief Games in a record file, counting those that do not replay to their result. */
+long long count_games(const string& path, long long& bad) {
+    if (!filesystem::exists(path)) return 0;
+    GameRecordFile file(path);
+    long long games = 0;
+    for (const RecordedGame& game : file) {
+        ++games;
+        if (!replays_to_result(game)) ++bad;
+    }
+    return games;
+}
+
+int main(int argc, char* argv[]) {
+    string dir = argc > 1 ? argv[1] : (filesystem::temp_directory_path() / "tournament-resume").string();
+    filesystem::remove_all(dir);
+    seed_random(7);
+
+#ifndef _WIN32
+    pid_t child = fork();
+    if (child == 0) {
+        Tournament<char, CONNECT_Board> t([] { return new CONNECT_Board(); }, CONNECT_UI::computer_move, 'X', 'O');
+        setup(t, dir);
+        t.run(1);
+        _exit(0);
+    }
+    // Kill the run once it has recorded a few games
+    for (int wait = 0; wait < 10000 && recorded_bytes(dir) < 400; ++wait)
+        usleep(1000);
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+#endif
+
+    // A run killed before its first game of a pairing, and one killed while writing a game
+    filesystem::create_directories(dir);
+    fclose(fopen(path_of(dir, "ab1", "random").c_str(), "wb"));
+    string partial = path_of(dir, "ab2", "ab1");
+    {
+        GameRecordWriter writer(partial);
+    }
+    FILE* file = fopen(partial.c_str(), "ab");
+    const unsigned char half_game[] = { 7, 0, 0, 0, 0, 0, 0, 0, 30, 0, VARIANT, 1, 'X' };
+    fwrite(half_game, 1, sizeof half_game, file);
+    fclose(file);
+
+    Tournament<char, CONNECT_Board> t([] { return new CONNECT_Board(); }, CONNECT_UI::computer_move, 'X', 'O');
+    setup(t, dir);
+    try {
+        t.run();
+    } catch (const exception& e) {
+        cout << "FAIL: resuming threw: " << e.what() << "\n";
+        return 1;
+    }
+
+    const vector<string>& names = t.get_names();
+    bool ok = true;
+    long long resumed = 0, bad = 0;
+    for (const auto& p : t.get_pairings()) {
+        long long recorded = count_games(path_of(dir, names[p.a], names[p.b]), bad) +
+                             count_games(path_of(dir, names[p.b], names[p.a]), bad);
+        long long games = p.score.games();
+        bool complete = p.decision != SprtDecision::CONTINUE || games == MAX_GAMES;
+        cout << names[p.a] << " vs " << names[p.b] << ": " << games << " games (" << p.resumed
+             << " resumed), " << recorded << " recorded\n";
+        if (recorded != games || !complete) ok = false;
+        resumed += p.resumed;
+    }
+    if (bad > 0) {
+        cout << bad << " recorded games do not replay to their result\n";
+        ok = false;
+    }
+    cout << resumed << " games resumed\n" << (ok ? "ok" : "FAIL") << "\n";
+    filesystem::remove_all(dir);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file selfplay.cpp
+ * @brief Headless computer-vs-computer games for every board in the game hub.
+ *
+ * Plays a batch of random games for each of the 13 variants listed in
+ * main.cpp's menu() and prints games/sec and the win/draw/loss tally of
+ * each batch. No board, UI or console interaction is involved. Inverse
+ * Tic-Tac-Toe is played a second time through SelfPlayRunner::run_batched(),
+ * which picks the moves of all live games with one Batch3x3 pass per step;
+ * its tally matches the first row.
+ *
+ * Every game draws from its own random stream of the master seed, so the
+ * tallies repeat exactly for the same seed and total number of games,
+ * whatever the thread count. Given a record file, every game is appended
+ * to it (see GameRecord.h); tools/replay reads it back.
+ *
+ * Usage: selfplay [games_per_thread] [threads] [seed] [record file]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+
+#include "BoardGame_Classes.h"
+#include "SelfPlay.h"
+#include "Inf_TicTacToe.h"
+#include "Word_TicTacToe.h"
+#include "obs_TicTacToe.h"
+#include "Inverse_TicTacToe.h"
+#include "Inverse_XO_UI.h"
+#include "SUS.h"
+#include "TIC_TAC_TOE_4X4.h"
+#include "NUMERICAL_TIC_TAC_TOE.h"
+#include "TicTacToe_5x5.h"
+#include "Pyramid_Tic_Tac_Toe.h"
+#include "connect4.h"
+#include "Memory.h"
+#include "Diamond_TicTacToe.h"
+#include "Diamond_UI.h"
+#include "Ultimate_TicTacToe.h"
+#include "Ultimate_UI.h"
+using namespace std;
+
+void report(const string& name, const SelfPlayStats& s) {
+    cout << left << setw(26) << name << right
+         << setw(8) << s.games
+         << setw(12) << fixed << setprecision(0) << s.games_per_second()
+         << setw(8) << s.first_wins
+         << setw(8) << s.second_wins
+         << setw(8) << s.draws
+         << setw(8) << s.aborted
+         << setw(10) << s.rejected << "\n";
+}
+
+GameRecordWriter* writer = nullptr; ///< Record file, or nullptr
+
+template <typename B>
+void play(int variant, const string& name, typename SelfPlayRunner<char, B>::MovePolicy policy,
+          char first, char second, int games, int threads) {
+    SelfPlayRunner<char, B> runner([] { return new B(); }, policy, policy, first, second);
+    runner.set_record(writer, variant);
+    report(name, runner.run(games, threads));
+}
+
+/** @brief Like play(), with each worker's live games moved in lockstep by a batch policy. */
+template <typename B>
+void play_batched(int variant, const string& name, typename SelfPlayRunner<char, B>::MovePolicy policy,
+                  typename SelfPlayRunner<char, B>::BatchPolicy batch, char first, char second, int games, int threads) {
+    SelfPlayRunner<char, B> runner([] { return new B(); }, policy, policy, first, second);
+    runner.set_batch_policies(batch, batch);
+    runner.set_record(writer, variant);
+    report(name, runner.run_batched(games, threads));
+}
+
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? atoi(argv[1]) : 200;
+    int threads = argc > 2 ? atoi(argv[2]) : thread::hardware_concurrency();
+    uint64_t seed = argc > 3 ? strtoull(argv[3], nullptr, 10) : static_cast<uint64_t>(time(0));
+    seed_random(seed);
+    unique_ptr<GameRecordWriter> record(argc > 4 ? new GameRecordWriter(argv[4]) : nullptr);
+    writer = record.get();
+    cout << "seed " << seed << "\n";
+
+    cout << left << setw(26) << "board" << right
+         << setw(8) << "games" << setw(12) << "games/sec"
+         << setw(8) << "p1" << setw(8) << "p2" << setw(8) << "draw"
+         << setw(8) << "abort" << setw(10) << "rejected" << "\n";
+
+    play<SUS_Board>(1, "SUS", SUS_UI::computer_move, 'S', 'U', games, threads);
+    play<CONNECT_Board>(2, "Connect 4", CONNECT_UI::computer_move, 'X', 'O', games, threads);
+    play<TicTacToe_5x5_board>(3, "5x5 Tic-Tac-Toe", TicTacToe_5x5_UI::computer_move, 'X', 'O', games, threads);
+    play<word_XO_Board>(4, "Word Tic-Tac-Toe", word_XO_UI::computer_move, '-', '-', games, threads);
+    play<InverseTicTacToe<char>>(5, "Inverse Tic-Tac-Toe", Inverse_XO_UI::computer_move, 'X', 'O', games, threads);
+    play_batched<InverseTicTacToe<char>>(5, "Inverse (batched)", Inverse_XO_UI::computer_move,
+                                         Inverse_XO_UI::computer_moves, 'X', 'O', games, threads);
+    play<DiamondTicTacToe<char>>(6, "Diamond Tic-Tac-Toe", Diamond_UI::computer_move, 'X', 'O', games, threads);
+    play<XO_4x4_Board>(7, "Tic_Tac_Toe_4X4", XO_4x4_UI::computer_move, 'X', 'O', games, threads);
+    play<Pyramid_XO_Board>(8, "Pyramid Tic_Tac_Toe", Pyramid_XO_UI::computer_move, 'X', 'O', games, threads);
+    play<Numerical_XO_Board>(9, "NUMERICAL Tic_Tac_Toe", Numerical_XO_UI::computer_move, 'O', 'X', games, threads);
+    play<obs_TicTacToe_board>(10, "Obstacles Tic-Tac-Toe", obs_TicTacToe_UI::computer_move, 'X', 'O', games, threads);
+    play<Inf_XO_Board>(11, "Infinity Tic-Tac-Toe", Inf_XO_UI::computer_move, 'X', 'O', games, threads);
+    play<UltimateTicTacToe<char>>(12, "Ultimate Tic-Tac-Toe", Ultimate_UI::computer_move, 'X', 'O', games, threads);
+    play<Memory_Board>(13, "Memory Tic-Tac-Toe", Memory_UI::computer_move, 'X', 'O', games, threads);
+    if (writer)
+        cout << writer->games() << " games recorded to " << argv[4] << "\n";
+    return 0;
+}
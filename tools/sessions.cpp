@@ -0,0 +1,138 @@
+/**
+ * @file sessions.cpp
+ * @brief Hosts many concurrent GameSessions on one event-loop thread.
+ *
+ * Every session is a Connect 4 game. The first seat stands in for a remote
+ * human: its moves are submitted by the loop itself, as if read from a
+ * socket. The second seat is a computer whose moves are chosen on a
+ * WorkerPool and handed back to the loop through a mailbox. Whenever a game
+ * finishes a new session takes its place, until the requested number of
+ * games has been played.
+ *
+ * Usage: sessions [live sessions] [games] [threads] [seed]
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+#include "BoardGame_Classes.h"
+#include "WorkerPool.h"
+#include "connect4.h"
+using namespace std;
+
+/** @brief One live game: its board, players and session. */
+struct Hosted {
+    CONNECT_Board board;
+    Player<char> human{ "Remote", 'X', PlayerType::HUMAN };
+    Player<char> computer{ "Computer", 'O', PlayerType::COMPUTER };
+    Player<char>* seats[2] = { &human, &computer };
+    GameSession<char> session{ &board, seats };
+};
+
+/** @brief A computer move finished on a worker, waiting for the loop. */
+struct Completed {
+    int slot;        ///< Session it belongs to
+    Move<char> move; ///< Move chosen
+    long long turn;  ///< Turn it was chosen for
+};
+
+/** @brief Completions posted by the workers, consumed by the loop. */
+class Mailbox {
+public:
+    void post(const Completed& c) {
+        {
+            lock_guard<mutex> guard(lock);
+            items.push_back(c);
+        }
+        ready.notify_one();
+    }
+
+    /** @brief Block until at least one completion is there, then take them all. */
+    void take(deque<Completed>& out) {
+        unique_lock<mutex> guard(lock);
+        ready.wait(guard, [this] { return !items.empty(); });
+        out.swap(items);
+    }
+
+private:
+    mutex lock;
+    condition_variable ready;
+    deque<Completed> items;
+};
+
+int main(int argc, char* argv[]) {
+    int live = argc > 1 ? atoi(argv[1]) : 10000;
+    long long games = argc > 2 ? atoll(argv[2]) : 50000;
+    int threads = argc > 3 ? atoi(argv[3]) : 0;
+    uint64_t seed = argc > 4 ? strtoull(argv[4], nullptr, 10) : static_cast<uint64_t>(time(0));
+    seed_random(seed);
+
+    WorkerPool pool(threads);
+    Mailbox mailbox;
+    vector<unique_ptr<Hosted>> slots(live);
+    long long started = 0, finished = 0, moves = 0, stale = 0;
+    long long tally[3] = { 0, 0, 0 }; // remote wins, computer wins, draws
+
+    // Advance a session until it waits on the pool or finishes
+    auto step = [&](int slot) {
+        GameSession<char>& session = slots[slot]->session;
+        while (session.state() == SessionState::AWAITING_MOVE) {
+            if (session.current_index() == 1) {
+                session.think(pool, CONNECT_UI::computer_move, [&mailbox, slot](Move<char> move, long long turn) {
+                    mailbox.post({ slot, move, turn });
+                });
+                return;
+            }
+            // The remote player's input has arrived
+            if (session.submit_move(0, CONNECT_UI::computer_move(&slots[slot]->human)) == SubmitResult::ACCEPTED)
+                ++moves;
+        }
+    };
+    // Record a finished game and start the next one in its slot, if any are left
+    auto replace = [&](int slot) {
+        GameResult result = slots[slot]->session.outcome();
+        ++tally[result == GameResult::WIN ? 0 : result == GameResult::LOSE ? 1 : 2];
+        ++finished;
+        slots[slot].reset();
+        if (started < games) {
+            slots[slot] = make_unique<Hosted>();
+            ++started;
+            step(slot);
+        }
+    };
+
+    auto start = chrono::steady_clock::now();
+    for (int s = 0; s < live && started < games; ++s) {
+        slots[s] = make_unique<Hosted>();
+        ++started;
+        step(s);
+        if (slots[s]->session.state() == SessionState::FINISHED) replace(s);
+    }
+
+    deque<Completed> batch;
+    while (finished < started) {
+        mailbox.take(batch);
+        for (const Completed& c : batch) {
+            GameSession<char>& session = slots[c.slot]->session;
+            SubmitResult r = session.submit_move(1, c.move, c.turn);
+            if (r == SubmitResult::STALE) ++stale;
+            if (r == SubmitResult::ACCEPTED) ++moves;
+            step(c.slot);
+            if (session.state() == SessionState::FINISHED) replace(c.slot);
+        }
+        batch.clear();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "seed " << seed << "\n"
+         << live << " live sessions, " << pool.size() << " worker threads\n"
+         << finished << " games, " << moves << " moves in " << seconds << " s\n"
+         << "games/s " << finished / seconds << ", moves/s " << moves / seconds << "\n"
+         << "remote wins " << tally[0] << ", computer wins " << tally[1] << ", draws " << tally[2]
+         << ", stale completions " << stale << "\n";
+    return 0;
+}
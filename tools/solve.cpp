@@ -0,0 +1,56 @@
+/**
+ * @file solve.cpp
+ * @brief Solves the small boards completely and reports their tables.
+ *
+ * For each board the Perfect_Table is built from the opening position and
+ * the number of positions, the table size, the solve time and the value of
+ * the opening position are printed. Numerical Tic-Tac-Toe has millions of
+ * reachable positions and is only solved when asked for.
+ *
+ * Usage: solve [--numerical]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+
+#include "BoardGame_Classes.h"
+#include "Perfect_Player.h"
+#include "Memory.h"
+#include "Inverse_TicTacToe.h"
+#include "SUS.h"
+#include "Inf_TicTacToe.h"
+#include "NUMERICAL_TIC_TAC_TOE.h"
+using namespace std;
+
+/** @brief Describe a table value as a result for the first player. */
+string describe(int value) {
+    if (value == 0) return "draw";
+    int plies = Perfect_Table<char, Memory_Board>::WIN - abs(value) + 1;
+    return string(value > 0 ? "first player wins" : "second player wins") + " in " + to_string(plies) + " plies";
+}
+
+template <typename BoardT>
+void report(const string& name, char first, char second) {
+    const auto& table = Perfect_Table<char, BoardT>::instance(first, second);
+    BoardT opening;
+    cout << left << setw(26) << name << right
+         << setw(10) << table.size()
+         << setw(12) << table.bytes()
+         << setw(10) << fixed << setprecision(2) << table.solve_seconds()
+         << "   " << describe(table.value(opening)) << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    cout << left << setw(26) << "board" << right
+         << setw(10) << "positions" << setw(12) << "bytes" << setw(10) << "seconds"
+         << "   opening position\n";
+
+    report<Memory_Board>("Memory Tic-Tac-Toe", 'X', 'O');
+    report<InverseTicTacToe<char>>("Inverse Tic-Tac-Toe", 'X', 'O');
+    report<SUS_Board>("SUS", 'S', 'U');
+    report<Inf_XO_Board>("Infinity Tic-Tac-Toe", 'X', 'O');
+    if (argc > 1 && strcmp(argv[1], "--numerical") == 0)
+        report<Numerical_XO_Board>("NUMERICAL Tic_Tac_Toe", 'O', 'X');
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file tournament.cpp
+ * @brief Ranks the computer players of every board in the game hub.
+ *
+ * For each variant of main.cpp's menu() the entrants are the random
+ * player, alpha-beta at depths 2 and 4, MCTS with 500 playouts on the
+ * boards it can copy and, on the boards with a solved table, the table
+ * player. They play round-robin on every core (or, with --gauntlet, the
+ * strongest entrant against the rest), each pairing until its SPRT
+ * between -30 and +30 Elo decides or the game limit is reached. Each
+ * pairing is printed with its score, Elo difference and 95% interval,
+ * then every entrant with its rating.
+ *
+ * Given a record directory, games are appended to one record file per
+ * pairing and colour; running the same command again resumes from them.
+ *
+ * Usage: tournament [variant|all] [max games per pairing] [threads] [seed] [record dir] [--gauntlet]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "BoardGame_Classes.h"
+#include "Tournament.h"
+#include "AI_Player.h"
+#include "MCTS_Player.h"
+#include "Perfect_Player.h"
+#include "Inf_TicTacToe.h"
+#include "Word_TicTacToe.h"
+#include "obs_TicTacToe.h"
+#include "Inverse_TicTacToe.h"
+#include "Inverse_XO_UI.h"
+#include "SUS.h"
+#include "TIC_TAC_TOE_4X4.h"
+#include "NUMERICAL_TIC_TAC_TOE.h"
+#include "TicTacToe_5x5.h"
+#include "Pyramid_Tic_Tac_Toe.h"
+#include "connect4.h"
+#include "Memory.h"
+#include "Diamond_TicTacToe.h"
+#include "Diamond_UI.h"
+#include "Ultimate_TicTacToe.h"
+#include "Ultimate_UI.h"
+using namespace std;
+
+/** @brief Settings shared by every variant. */
+struct Options {
+    int max_games = 200;
+    int threads = 0;
+    string record_dir;
+    bool gauntlet = false;
+};
+
+const char* decision_name(SprtDecision d) {
+    switch (d) {
+        case SprtDecision::H1: return "stronger";
+        case SprtDecision::H0: return "weaker";
+        default: return "open";
+    }
+}
+
+template <typename B>
+void report(const string& name, const Tournament<char, B>& t, const Sprt& sprt) {
+    const vector<string>& names = t.get_names();
+    long long games = 0, resumed = 0;
+    for (const auto& p : t.get_pairings()) {
+        games += p.score.games();
+        resumed += p.resumed;
+    }
+    cout << "\n" << name << ": " << t.get_pairings().size() << " pairings, " << games << " games ("
+         << resumed << " resumed) in " << fixed << setprecision(1) << t.get_seconds() << " s\n";
+
+    cout << left << setw(22) << "pairing" << right << setw(6) << "W" << setw(6) << "D" << setw(6) << "L"
+         << setw(8) << "elo" << setw(18) << "95% interval" << setw(8) << "llr" << "  result\n";
+    for (const auto& p : t.get_pairings()) {
+        EloEstimate e = elo_estimate(p.score);
+        cout << left << setw(22) << names[p.a] + " vs " + names[p.b] << right
+             << setw(6) << p.score.wins << setw(6) << p.score.draws << setw(6) << p.score.losses
+             << setw(8) << setprecision(0) << e.elo
+             << setw(9) << "[" + to_string(lround(e.low)) << ", " << setw(5) << to_string(lround(e.high)) + "]"
+             << setw(8) << setprecision(2) << sprt.llr(p.score) << "  " << decision_name(p.decision) << "\n";
+    }
+
+    vector<Rating> ratings = t.ratings();
+    vector<int> order(ratings.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<int>(i);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return ratings[a].elo > ratings[b].elo; });
+    cout << left << setw(6) << "rank" << setw(12) << "entrant" << right << setw(8) << "elo" << setw(8) << "+/-"
+         << setw(8) << "games" << setw(8) << "score" << "\n";
+    for (size_t r = 0; r < order.size(); ++r) {
+        const Rating& rating = ratings[order[r]];
+        cout << left << setw(6) << r + 1 << setw(12) << names[order[r]] << right
+             << setw(8) << setprecision(0) << rating.elo << setw(8) << rating.error
+             << setw(8) << rating.games << setw(8) << setprecision(3) << rating.score << "\n";
+    }
+}
+
+/**
+ * @brief Rank the entrants of one variant.
+ * @param solved Add the table player, for boards Perfect_Player can solve quickly
+ */
+template <typename B>
+void play(int variant, const string& name, typename Tournament<char, B>::MovePolicy policy,
+          char first, char second, bool solved, const Options& options) {
+    Tournament<char, B> t([] { return new B(); }, policy, first, second);
+    // In a gauntlet the first entrant, the strongest, meets every other
+    if (solved)
+        t.add_entrant("perfect", [first, second](char s, char) {
+            return new Perfect_Player<char, B>("perfect", s, first, second);
+        });
+    // MCTS plays out on copies of the board
+    if constexpr (is_copy_assignable_v<B>)
+        t.add_entrant("mcts500", [](char s, char o) { return new MCTS_Player<char, B>("mcts500", s, o, 500, 0, 1); });
+    t.add_entrant("ab4", [](char s, char o) { return new AI_Player<char, B>("ab4", s, o, 4); });
+    t.add_entrant("ab2", [](char s, char o) { return new AI_Player<char, B>("ab2", s, o, 2); });
+    t.add_entrant("random", [](char s, char) { return new Player<char>("random", s, PlayerType::COMPUTER); });
+
+    Sprt sprt;
+    t.set_sprt(sprt);
+    t.set_max_games(options.max_games);
+    t.set_format(options.gauntlet ? TournamentFormat::GAUNTLET : TournamentFormat::ROUND_ROBIN);
+    if (!options.record_dir.empty())
+        t.set_record(options.record_dir, variant);
+    t.run(options.threads);
+    report(name, t, sprt);
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    vector<string> args;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--gauntlet") == 0) options.gauntlet = true;
+        else args.push_back(argv[i]);
+    }
+    int variant = args.size() > 0 && args[0] != "all" ? atoi(args[0].c_str()) : 0;
+    if (args.size() > 1) options.max_games = atoi(args[1].c_str());
+    options.threads = args.size() > 2 ? atoi(args[2].c_str()) : 0;
+    if (options.threads <= 0) options.threads = max(1u, thread::hardware_concurrency());
+    uint64_t seed = args.size() > 3 ? strtoull(args[3].c_str(), nullptr, 10) : static_cast<uint64_t>(time(0));
+    if (args.size() > 4) options.record_dir = args[4];
+    if (variant < 0 || variant > 13 || options.max_games < 1) {
+        cout << "Usage: tournament [variant|all] [max games per pairing] [threads] [seed] [record dir] [--gauntlet]\n";
+        return 1;
+    }
+    seed_random(seed);
+    cout << "seed " << seed << ", " << options.threads << " threads, at most " << options.max_games
+         << " games per pairing\n";
+
+    auto wanted = [variant](int v) { return variant == 0 || variant == v; };
+    if (wanted(1)) play<SUS_Board>(1, "SUS", SUS_UI::computer_move, 'S', 'U', true, options);
+    if (wanted(2)) play<CONNECT_Board>(2, "Connect 4", CONNECT_UI::computer_move, 'X', 'O', false, options);
+    if (wanted(3)) play<TicTacToe_5x5_board>(3, "5x5 Tic-Tac-Toe", TicTacToe_5x5_UI::computer_move, 'X', 'O', false, options);
+    if (wanted(4)) play<word_XO_Board>(4, "Word Tic-Tac-Toe", word_XO_UI::computer_move, '-', '-', false, options);
+    if (wanted(5)) play<InverseTicTacToe<char>>(5, "Inverse Tic-Tac-Toe", Inverse_XO_UI::computer_move, 'X', 'O', true, options);
+    if (wanted(6)) play<DiamondTicTacToe<char>>(6, "Diamond Tic-Tac-Toe", Diamond_UI::computer_move, 'X', 'O', false, options);
+    if (wanted(7)) play<XO_4x4_Board>(7, "Tic_Tac_Toe_4X4", XO_4x4_UI::computer_move, 'X', 'O', false, options);
+    if (wanted(8)) play<Pyramid_XO_Board>(8, "Pyramid Tic_Tac_Toe", Pyramid_XO_UI::computer_move, 'X', 'O', false, options);
+    if (wanted(9)) play<Numerical_XO_Board>(9, "NUMERICAL Tic_Tac_Toe", Numerical_XO_UI::computer_move, 'O', 'X', false, options);
+    if (wanted(10)) play<obs_TicTacToe_board>(10, "Obstacles Tic-Tac-Toe", obs_TicTacToe_UI::computer_move, 'X', 'O', false, options);
+    if (wanted(11)) play<Inf_XO_Board>(11, "Infinity Tic-Tac-Toe", Inf_XO_UI::computer_move, 'X', 'O', true, options);
+    if (wanted(12)) play<UltimateTicTacToe<char>>(12, "Ultimate Tic-Tac-Toe", Ultimate_UI::computer_move, 'X', 'O', false, options);
+    if (wanted(13)) play<Memory_Board>(13, "Memory Tic-Tac-Toe", Memory_UI::computer_move, 'X', 'O', true, options);
+    return 0;
+}